@@ -17,6 +17,8 @@
     -   GET
     -   SET
     -   GETSET
+    -   STATIC_PROPERTY(Owner, name, ...)
+    -   CORE_NO_UNIQUE_ADDRESS  Note: `[[no_unique_address]]` attribute
 //  Result
     -   match_error(result)
     -   match_error_code(result)
@@ -34,6 +36,8 @@
     -   GET_FOR_LOOP_MACRO
 //  General for use
     -   CORE_NAMESPACE
+    -   CORE_COROUTINES     Note: Defined for C++20 builds with coroutine
+                                  support (multithreading/task.hpp)
     -   KB & MB & GB
     -   MEMORY_PADDING      Note: Memory padding used by allocators
     -   CONST_STRING        Note: `constexpr static const char* const` type
@@ -29,4 +29,17 @@ template<typename T>
 struct has_iterator<T, std::void_t<typename T::iterator>> //
     : std::true_type {};
 
+/**
+ * @brief Trait indicating if values of type \b T can be compared with `==`.
+ * @tparam T Type to check
+ */
+template<typename T, typename = std::void_t<>>
+struct is_equality_comparable //
+    : std::false_type {};
+template<typename T>
+struct is_equality_comparable<
+    T,
+    std::void_t<decltype(std::declval<const T&>() == std::declval<const T&>())>>
+    : std::true_type {};
+
 } // namespace CORE_NAMESPACE
\ No newline at end of file
@@ -0,0 +1,165 @@
+/**
+ * @file computed_property.hpp
+ * @author Android172 (android172unity@gmail.com)
+ * @brief Defines lazily computed, cached property.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include "observable_property.hpp"
+#include "delegate.hpp"
+
+#include <optional>
+
+namespace CORE_NAMESPACE {
+
+/**
+ * @brief Property whose value is derived from other (source) properties.
+ * Value is computed on first read and cached. It is only recomputed, on the
+ * next read, once one of the declared sources changes. Changes are detected
+ * by comparing version counters of the sources, no callbacks are involved.
+ * Sources can be `ObservableProperty` or other `ComputedProperty` objects.
+ *
+ * If all sources are observable properties of the same `ChangeTracker`,
+ * reading a clean value only compares tracker's version with the cached one.
+ * Otherwise every read compares version of each source. Not thread safe.
+ *
+ *  ```cpp
+ *      class Rect {
+ *        public:
+ *          ChangeTracker             changes {};
+ *          ObservableProperty<float> width { changes };
+ *          ObservableProperty<float> height { changes };
+ *          ComputedProperty<float>   area {
+ *              [this]() { return width() * height(); }, width, height
+ *          };
+ *      };
+ *  ```
+ *
+ * @tparam T Type of computed value
+ */
+template<typename T>
+class ComputedProperty {
+  public:
+    /**
+     * @brief Construct a new Computed Property object
+     *
+     * @param compute Function computing the value, taking no arguments
+     * @param sources Properties from which value is computed
+     */
+    template<typename F, typename... Sources>
+    ComputedProperty(F&& compute, const Sources&... sources)
+        : _compute(std::forward<F>(compute)),
+          _sources(TAllocator<Source>(BaseMemoryTags.Callback)) {
+        _sources.reserve(sizeof...(Sources));
+        (add_source(sources), ...);
+
+        // Single tracker version stands for all sources, if they share it
+        for (const auto& source : _sources) {
+            if (!source.tracker || (_tracker && source.tracker != _tracker)) {
+                _tracker = nullptr;
+                break;
+            }
+            _tracker = source.tracker;
+        }
+        _counter = _tracker ? &_tracker->_version : &_stale_counter;
+    }
+
+    // Cached value and sources belong to the owner
+    ComputedProperty(const ComputedProperty&)            = delete;
+    ComputedProperty& operator=(const ComputedProperty&) = delete;
+
+    /// @brief Current value, recomputed first if any source changed
+    const T& get() const {
+        if (*_counter != _seen_counter) refresh();
+        return *_value;
+    }
+
+    operator const T&() const { return get(); }
+    const T& operator()() const { return get(); }
+    const T* operator->() const { return &get(); }
+
+    /// @brief Drop cached value, forcing recomputation on next read
+    void invalidate() {
+        _value.reset();
+        _seen_counter = *_counter - 1;
+    }
+
+    /**
+     * @brief Number of times computed value changed. Brings value up to date
+     * first, so it can be used as a source version.
+     */
+    uint64 version() const {
+        get();
+        return _version;
+    }
+
+  private:
+    struct Source {
+        const void* property;
+        uint64 (*version)(const void*);
+        // Tracker of observable property, nullptr for other sources
+        const ChangeTracker* tracker;
+        uint64               seen_version;
+    };
+
+    mutable Delegate<T>      _compute;
+    mutable std::optional<T> _value {};
+    mutable Vector<Source>   _sources;
+    const ChangeTracker*     _tracker = nullptr;
+    // Counter compared on every read. Either tracker's version or a counter
+    // which never matches, forcing sources to be checked individually.
+    const uint64*            _counter       = nullptr;
+    mutable uint64           _seen_counter  = ~(uint64) 0;
+    uint64                   _stale_counter = 0;
+    mutable uint64           _version       = 0;
+
+    template<typename U>
+    void add_source(const ObservableProperty<U>& property) {
+        _sources.push_back(
+            { &property,
+              [](const void* property) {
+                  return ((const ObservableProperty<U>*) property)->version();
+              },
+              &property.tracker(),
+              ~(uint64) 0 }
+        );
+    }
+    template<typename U>
+    void add_source(const ComputedProperty<U>& property) {
+        _sources.push_back(
+            { &property,
+              [](const void* property) {
+                  return ((const ComputedProperty<U>*) property)->version();
+              },
+              nullptr,
+              ~(uint64) 0 }
+        );
+    }
+
+    void refresh() const {
+        bool changed = !_value.has_value();
+        for (auto& source : _sources) {
+            const auto version = source.version(source.property);
+            if (version == source.seen_version) continue;
+            source.seen_version = version;
+            changed             = true;
+        }
+        _seen_counter = _tracker ? *_counter : *_counter - 1;
+        if (!changed) return;
+
+        T value = _compute();
+        if constexpr (is_equality_comparable<T>::value) {
+            if (_value.has_value() && *_value == value) return;
+        }
+        _value = std::move(value);
+        _version++;
+    }
+};
+
+} // namespace CORE_NAMESPACE
@@ -0,0 +1,333 @@
+/**
+ * @file concurrent_event.hpp
+ * @author Android172 (android172unity@gmail.com)
+ * @brief Defines event which can be invoked and subscribed to concurrently.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include "event.hpp"
+#include "multithreading/reclamation.hpp"
+
+namespace CORE_NAMESPACE {
+
+namespace __detail__ {
+    /**
+     * @brief Copy-on-write subscriber list shared by concurrent event
+     * specializations. Readers load the currently published list without any
+     * locking, inside of an epoch critical region. Writers serialize on a
+     * lock, publish a modified copy and retire the old list, which is freed
+     * once no reader can still use it.
+     */
+    template<typename R, typename... Args>
+    class ConcurrentCallbackList {
+      public:
+        ConcurrentCallbackList() {}
+        ~ConcurrentCallbackList() {
+            // No one may invoke a destroyed event, so list is freed directly
+            const auto snapshot = _snapshot.load(std::memory_order_acquire);
+            if (snapshot) del(snapshot);
+        }
+
+        ConcurrentCallbackList(const ConcurrentCallbackList&) = delete;
+        ConcurrentCallbackList& operator=(const ConcurrentCallbackList&) =
+            delete;
+
+        /**
+         * @brief Subscribe to an event.
+         * Attaches a class method as a callback.
+         *
+         * @param caller Class from which to call the method.
+         * @param callback Called method
+         * @return Subscription Handle used to unsubscribe
+         */
+        template<typename T>
+        Subscription subscribe(T* caller, R (T::*callback)(Args...)) {
+            return add(Delegate<R, Args...>(caller, callback));
+        }
+        /**
+         * @brief Subscribe to an event.
+         * Attaches a function as callback.
+         *
+         * @param callback Called function
+         * @return Subscription Handle used to unsubscribe
+         */
+        template<typename F>
+        Subscription subscribe(F&& callback) {
+            return add(Delegate<R, Args...>(std::forward<F>(callback)));
+        }
+        /**
+         * @brief Subscribe to an event for the lifetime of returned object.
+         *
+         * @param callback Called function
+         * @return ScopedSubscription Unsubscribes once destroyed
+         */
+        template<typename F>
+        [[nodiscard]] ScopedSubscription subscribe_scoped(F&& callback) {
+            return { *this, subscribe(std::forward<F>(callback)) };
+        }
+
+        /**
+         * @brief Unsubscribe from the event.
+         *
+         * @param subscription Handle returned by subscribe
+         * @return true If a callback was detached
+         * @return false If handle is no longer subscribed
+         */
+        Outcome unsubscribe(const Subscription subscription) {
+            if (subscription.generation == 0) return Outcome::Failed;
+            const auto id = ((uint64) (subscription.generation - 1) << 32) |
+                            subscription.slot;
+            return remove([id](const Snapshot& snapshot, const uint64 i) {
+                return snapshot.ids[i] == id;
+            });
+        }
+        /**
+         * @brief Unsubscribe from the event.
+         * Detaches one instance of attached method from the list.
+         *
+         * @param callback Method to detach.
+         * @return true If a method was detached
+         * @return false If no such method was found
+         */
+        template<typename T>
+        Outcome unsubscribe(T* caller, R (T::*callback)(Args...)) {
+            return remove_delegate(Delegate<R, Args...>(caller, callback));
+        }
+        /**
+         * @brief Unsubscribe from the event.
+         * Detaches one instance of attached function from the list.
+         *
+         * @param callback Function to detach. Only function pointers and
+         * trivially copyable callables can be matched (see `Delegate`).
+         * @return true If a function was detached
+         * @return false If no such function was found
+         */
+        template<
+            typename F,
+            typename = std::enable_if_t<
+                !std::is_same_v<std::decay_t<F>, Subscription>>>
+        Outcome unsubscribe(F&& callback) {
+            return remove_delegate(
+                Delegate<R, Args...>(std::forward<F>(callback))
+            );
+        }
+
+        /// @brief Number of subscribed callbacks
+        uint64 size() const {
+            parallel::EpochGuard guard {};
+            const auto snapshot = _snapshot.load(std::memory_order_acquire);
+            return snapshot ? snapshot->callbacks.size() : 0;
+        }
+
+        /**
+         * @brief Passes @p callback to subscribe.
+         */
+        template<typename F>
+        inline Subscription operator+=(F&& callback) {
+            return subscribe(std::forward<F>(callback));
+        }
+        /**
+         * @brief Passes @p callback to unsubscribe.
+         */
+        template<typename F>
+        inline void operator-=(F&& callback) {
+            unsubscribe(std::forward<F>(callback));
+        }
+
+      protected:
+        // Published subscriber list. Never modified once published.
+        struct Snapshot {
+            Vector<Delegate<R, Args...>> callbacks {
+                TAllocator<Delegate<R, Args...>>(BaseMemoryTags.Callback)
+            };
+            Vector<uint64> ids { TAllocator<uint64>(BaseMemoryTags.Callback) };
+        };
+
+        /**
+         * @brief Get currently published list. Must only be called, and the
+         * list used, inside of an epoch critical region.
+         */
+        Snapshot* snapshot() const {
+            return _snapshot.load(std::memory_order_acquire);
+        }
+
+      private:
+        std::atomic<Snapshot*> _snapshot { nullptr };
+        parallel::SpinLock     _write_lock {};
+        uint64                 _next_id = 0;
+
+        // Publishes @p snapshot in place of @p old one
+        void publish(Snapshot* const old, Snapshot* const snapshot) {
+            _snapshot.store(snapshot, std::memory_order_release);
+            if (old) parallel::EpochReclamation::retire(old);
+        }
+
+        Subscription add(Delegate<R, Args...>&& callback) {
+            std::lock_guard<parallel::SpinLock> lock { _write_lock };
+            const auto old      = _snapshot.load(std::memory_order_relaxed);
+            const auto snapshot = new (BaseMemoryTags.Callback) Snapshot();
+            if (old) {
+                snapshot->callbacks.reserve(old->callbacks.size() + 1);
+                snapshot->ids.reserve(old->ids.size() + 1);
+                snapshot->callbacks.insert(
+                    snapshot->callbacks.end(),
+                    old->callbacks.begin(),
+                    old->callbacks.end()
+                );
+                snapshot->ids.insert(
+                    snapshot->ids.end(), old->ids.begin(), old->ids.end()
+                );
+            }
+            const auto id = _next_id++;
+            snapshot->callbacks.push_back(std::move(callback));
+            snapshot->ids.push_back(id);
+            publish(old, snapshot);
+
+            return { (uint32) id, (uint32) (id >> 32) + 1 };
+        }
+
+        // Removes first callback for which predicate holds
+        template<typename Predicate>
+        Outcome remove(Predicate matches) {
+            std::lock_guard<parallel::SpinLock> lock { _write_lock };
+            const auto old = _snapshot.load(std::memory_order_relaxed);
+            if (!old) return Outcome::Failed;
+
+            uint64     position = 0;
+            const auto count    = old->callbacks.size();
+            while (position < count && !matches(*old, position))
+                position++;
+            if (position == count) return Outcome::Failed;
+
+            Snapshot* snapshot = nullptr;
+            if (count > 1) {
+                snapshot = new (BaseMemoryTags.Callback) Snapshot();
+                snapshot->callbacks.reserve(count - 1);
+                snapshot->ids.reserve(count - 1);
+                for (uint64 i = 0; i < count; i++) {
+                    if (i == position) continue;
+                    snapshot->callbacks.push_back(old->callbacks[i]);
+                    snapshot->ids.push_back(old->ids[i]);
+                }
+            }
+            publish(old, snapshot);
+            return Outcome::Successful;
+        }
+        Outcome remove_delegate(const Delegate<R, Args...>& delegate) {
+            return remove([&delegate](const Snapshot& snapshot, uint64 i) {
+                return snapshot.callbacks[i] == delegate;
+            });
+        }
+    };
+} // namespace __detail__
+
+/**
+ * @brief Thread safe event. Can be invoked, subscribed to and unsubscribed
+ * from by any number of threads at once.
+ */
+template<typename Signature>
+class ConcurrentEvent;
+
+/**
+ * @brief Thread safe event. Invocation takes no lock: it calls callbacks of a
+ * consistent, immutable snapshot of the subscriber list. Subscribing and
+ * unsubscribing copies the list and publishes the copy, so they are more
+ * expensive than with `Event`. Best suited for events which are invoked much
+ * more often than their subscribers change.
+ *
+ * Callbacks run inside of an epoch critical region (see `EpochReclamation`),
+ * so long running callbacks delay freeing of retired memory. Callbacks may
+ * subscribe to and unsubscribe from the event they are invoked by; changes
+ * take effect from the next invocation.
+ *
+ * @tparam R Return type
+ * @tparam Args Argument types
+ */
+template<typename R, typename... Args>
+class ConcurrentEvent<R(Args...)>
+    : public __detail__::ConcurrentCallbackList<R, Args...> {
+  public:
+    /// @brief Function combining results of two callbacks into one
+    typedef std::function<R(const R&, const R&)> Reducer;
+
+    /**
+     * @brief Construct a new Concurrent Event object
+     *
+     * @param reducer Combines results of all callbacks into the one returned
+     * by invoke. If empty, result of the last callback is returned. Must be
+     * set before event is used from multiple threads.
+     */
+    ConcurrentEvent(Reducer reducer = {}) : _reducer(std::move(reducer)) {}
+    ~ConcurrentEvent() {}
+
+    /**
+     * @brief Invoke all subscribed callbacks with the passed arguments.
+     *
+     * @param arguments Arguments to be passed to callbacks.
+     * @return R Results of all callbacks combined by the reducer, or value
+     * returned by the last callback if there is no reducer.
+     */
+    R invoke(Args... arguments) {
+        parallel::EpochGuard guard {};
+        const auto           snapshot = this->snapshot();
+        R                    result {};
+        if (!snapshot) return result;
+
+        auto& callbacks = snapshot->callbacks;
+        for (uint64 i = 0; i < callbacks.size(); i++) {
+            if (i == 0) result = callbacks[i].call(arguments...);
+            else if (_reducer)
+                result = _reducer(result, callbacks[i].call(arguments...));
+            else result = callbacks[i].call(arguments...);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Calls invoke with passed \p arguments.
+     */
+    inline R operator()(Args... arguments) { return invoke(arguments...); }
+
+  private:
+    Reducer _reducer;
+};
+
+/**
+ * @brief Thread safe event. See `ConcurrentEvent<R(Args...)>`.
+ *
+ * @tparam Args Argument types
+ */
+template<typename... Args>
+class ConcurrentEvent<void(Args...)>
+    : public __detail__::ConcurrentCallbackList<void, Args...> {
+  public:
+    ConcurrentEvent() {}
+    ~ConcurrentEvent() {}
+
+    /**
+     * @brief Invoke all subscribed callbacks with the passed arguments.
+     *
+     * @param arguments Arguments to be passed to callbacks.
+     */
+    void invoke(Args... arguments) {
+        parallel::EpochGuard guard {};
+        const auto           snapshot = this->snapshot();
+        if (!snapshot) return;
+
+        for (auto& callback : snapshot->callbacks)
+            callback.call(arguments...);
+    }
+
+    /**
+     * @brief Calls invoke with passed \p arguments.
+     */
+    inline void operator()(Args... arguments) { invoke(arguments...); }
+};
+
+} // namespace CORE_NAMESPACE
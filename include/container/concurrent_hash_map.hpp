@@ -0,0 +1,264 @@
+/**
+ * @file concurrent_hash_map.hpp
+ * @author Android172 (android172unity@gmail.com)
+ * @brief Defines hash map container safe for concurrent use
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include "container/unordered_map.hpp"
+#include "multithreading/synchronization.hpp"
+
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+
+namespace CORE_NAMESPACE {
+
+/**
+ * @brief Hash map which can be read and modified from many threads at once.
+ * Keys are split among independent shards, each guarded by its own
+ * reader-writer lock and padded to a separate cache line. Readers of one shard
+ * never block each other, while operations on different shards never touch
+ * the same memory, so throughput scales with the number of cores.
+ *
+ * Since entries may be erased by other threads at any time, lookups return
+ * copies of stored values (or pass them to a visitor under lock) rather than
+ * references.
+ *
+ * @tparam Key Key type
+ * @tparam Value Mapped value type
+ * @tparam Hash Hashing function object type
+ * @tparam Pred Key equality predicate type
+ */
+template<
+    typename Key,
+    typename Value,
+    typename Hash = std::hash<Key>,
+    typename Pred = std::equal_to<Key>>
+class ConcurrentHashMap {
+  public:
+    /**
+     * @brief Construct a new ConcurrentHashMap object
+     *
+     * @param shard_count Number of independently locked shards. Rounded up to
+     * the nearest power of two. More shards lower contention between writers.
+     * @param tag Memory tag used for all allocations
+     */
+    explicit ConcurrentHashMap(
+        const uint64 shard_count = 64, const MemoryTag tag = BaseMemoryTags.Map
+    ) {
+        _shard_count = 1;
+        while (_shard_count < shard_count)
+            _shard_count <<= 1;
+
+        // Shards are aligned to cache lines manually, since allocators only
+        // guarantee `MEMORY_PADDING` alignment
+        _memory = ::operator new(
+            sizeof(Shard) * _shard_count + parallel::cache_line_size, tag
+        );
+        const auto address = (uint64) _memory;
+        const auto aligned = (address + parallel::cache_line_size - 1) &
+                             ~(parallel::cache_line_size - 1);
+        _shards            = (Shard*) aligned;
+        for (uint64 i = 0; i < _shard_count; i++)
+            new (&_shards[i]) Shard(tag);
+    }
+    ~ConcurrentHashMap() {
+        for (uint64 i = 0; i < _shard_count; i++)
+            _shards[i].~Shard();
+        ::operator delete(_memory);
+    }
+
+    ConcurrentHashMap(const ConcurrentHashMap&)            = delete;
+    ConcurrentHashMap& operator=(const ConcurrentHashMap&) = delete;
+
+    // -------------------------------------------------------------------------
+    // Lookup
+    // -------------------------------------------------------------------------
+
+    /**
+     * @brief Find value mapped to @p key
+     * @return std::optional<Value> Copy of the value, or empty if key is
+     * missing
+     */
+    std::optional<Value> find(const Key& key) const {
+        const auto&                        shard = shard_of(key);
+        std::shared_lock<parallel::RWLock> lock { shard.lock };
+        const auto                         it = shard.map.find(key);
+        if (it == shard.map.end()) return std::nullopt;
+        return it->second;
+    }
+    /**
+     * @brief Check whether the map contains a given key
+     */
+    bool contains(const Key& key) const {
+        const auto&                        shard = shard_of(key);
+        std::shared_lock<parallel::RWLock> lock { shard.lock };
+        return shard.map.contains(key);
+    }
+    /**
+     * @brief Call @p visitor with value mapped to @p key (if any), while
+     * entry is read locked. Avoids copying large values.
+     *
+     * @param key Key to search for
+     * @param visitor Callable taking `const Value&`. Must not access this map.
+     * @return true If key was found
+     */
+    template<typename Visitor>
+    bool visit(const Key& key, Visitor&& visitor) const {
+        const auto&                        shard = shard_of(key);
+        std::shared_lock<parallel::RWLock> lock { shard.lock };
+        const auto                         it = shard.map.find(key);
+        if (it == shard.map.end()) return false;
+        visitor((const Value&) it->second);
+        return true;
+    }
+    /**
+     * @brief Call @p visitor for every entry. Each shard is read locked while
+     * it is visited, so the map as a whole isn't a consistent snapshot.
+     *
+     * @param visitor Callable taking `const Key&, const Value&`. Must not
+     * access this map.
+     */
+    template<typename Visitor>
+    void visit_all(Visitor&& visitor) const {
+        for (uint64 i = 0; i < _shard_count; i++) {
+            const auto&                        shard = _shards[i];
+            std::shared_lock<parallel::RWLock> lock { shard.lock };
+            for (const auto& entry : shard.map)
+                visitor(entry.first, (const Value&) entry.second);
+        }
+    }
+
+    // -------------------------------------------------------------------------
+    // Modification
+    // -------------------------------------------------------------------------
+
+    /**
+     * @brief Insert value under @p key, if key isn't already present
+     * @return true If value was inserted
+     */
+    template<typename V>
+    bool insert(const Key& key, V&& value) {
+        auto&                             shard = shard_of(key);
+        std::lock_guard<parallel::RWLock> lock { shard.lock };
+        return shard.map.emplace(key, std::forward<V>(value)).second;
+    }
+    /**
+     * @brief Insert value under @p key, overwriting any present one
+     * @return true If value was inserted, false if it was assigned
+     */
+    template<typename V>
+    bool insert_or_assign(const Key& key, V&& value) {
+        auto&                             shard = shard_of(key);
+        std::lock_guard<parallel::RWLock> lock { shard.lock };
+        return shard.map.insert_or_assign(key, std::forward<V>(value)).second;
+    }
+    /**
+     * @brief Atomically modify value mapped to @p key (if any) by calling
+     * @p updater on it under write lock.
+     *
+     * @param key Key to search for
+     * @param updater Callable taking `Value&`. Must not access this map.
+     * @return true If key was found
+     */
+    template<typename Updater>
+    bool update(const Key& key, Updater&& updater) {
+        auto&                             shard = shard_of(key);
+        std::lock_guard<parallel::RWLock> lock { shard.lock };
+        const auto                        it = shard.map.find(key);
+        if (it == shard.map.end()) return false;
+        updater(it->second);
+        return true;
+    }
+    /**
+     * @brief Return value mapped to @p key, first computing and inserting it
+     * with @p factory if missing. Factory is called under write lock, at most
+     * once per missing key.
+     *
+     * @param key Key to search for
+     * @param factory Callable returning `Value`. Must not access this map.
+     * @return Value Copy of the (possibly new) value
+     */
+    template<typename Factory>
+    Value get_or_insert(const Key& key, Factory&& factory) {
+        auto& shard = shard_of(key);
+        {
+            std::shared_lock<parallel::RWLock> lock { shard.lock };
+            const auto                         it = shard.map.find(key);
+            if (it != shard.map.end()) return it->second;
+        }
+        std::lock_guard<parallel::RWLock> lock { shard.lock };
+        const auto                        it = shard.map.find(key);
+        if (it != shard.map.end()) return it->second;
+        return shard.map.emplace(key, factory()).first->second;
+    }
+    /**
+     * @brief Remove entry with given key
+     * @return true If entry was removed
+     */
+    bool erase(const Key& key) {
+        auto&                             shard = shard_of(key);
+        std::lock_guard<parallel::RWLock> lock { shard.lock };
+        return shard.map.erase(key) != 0;
+    }
+    /**
+     * @brief Remove all entries
+     */
+    void clear() {
+        for (uint64 i = 0; i < _shard_count; i++) {
+            auto&                             shard = _shards[i];
+            std::lock_guard<parallel::RWLock> lock { shard.lock };
+            shard.map.clear();
+        }
+    }
+
+    // -------------------------------------------------------------------------
+    // Capacity
+    // -------------------------------------------------------------------------
+
+    /// @brief Number of entries. Approximate while map is being modified.
+    uint64 size() const {
+        uint64 total = 0;
+        for (uint64 i = 0; i < _shard_count; i++) {
+            const auto&                        shard = _shards[i];
+            std::shared_lock<parallel::RWLock> lock { shard.lock };
+            total += shard.map.size();
+        }
+        return total;
+    }
+    /// @brief True if map holds no entries (see `size`)
+    bool empty() const { return size() == 0; }
+
+  private:
+    struct alignas(parallel::cache_line_size) Shard {
+        mutable parallel::RWLock             lock {};
+        UnorderedMap<Key, Value, Hash, Pred> map;
+
+        Shard(const MemoryTag tag)
+            : map(
+                  (uint64) 0,
+                  Hash(),
+                  Pred(),
+                  TAllocator<std::pair<const Key, Value>>(tag)
+              ) {}
+    };
+
+    void*  _memory;
+    Shard* _shards;
+    uint64 _shard_count;
+
+    Shard& shard_of(const Key& key) const {
+        // Mix bits, since std::hash is identity for integers
+        const auto hash = (uint64) Hash()(key) * 11400714819323198485ull;
+        return _shards[(hash >> 32) & (_shard_count - 1)];
+    }
+};
+
+} // namespace CORE_NAMESPACE
@@ -44,16 +44,20 @@ template<
     typename _Tp,
     typename _Compare = std::less<_Key>,
     typename _Alloc   = std::allocator<std::pair<const _Key, _Tp>>>
-class Map : public std::map<_Key, _Tp, _Compare, TAllocator<_Tp>> {
+class Map : public std::map<
+                _Key,
+                _Tp,
+                _Compare,
+                TAllocator<std::pair<const _Key, _Tp>>> {
   private:
-    typedef TAllocator<_Tp>                                allocator_type;
-    typedef std::map<_Key, _Tp, _Compare, TAllocator<_Tp>> _base_class;
-    typedef std::map<_Key, _Tp, _Compare>                  default_version;
-    typedef std::pair<const _Key, _Tp>                     value_type;
+    typedef TAllocator<std::pair<const _Key, _Tp>>        allocator_type;
+    typedef std::map<_Key, _Tp, _Compare, allocator_type> _base_class;
+    typedef std::map<_Key, _Tp, _Compare>                 default_version;
+    typedef std::pair<const _Key, _Tp>                    value_type;
 
   public:
-    using std::map<_Key, _Tp, _Compare, TAllocator<_Tp>>::map;
-    using std::map<_Key, _Tp, _Compare, TAllocator<_Tp>>::insert;
+    using _base_class::map;
+    using _base_class::insert;
 
     /**
      *  @brief  Default constructor creates no elements.
@@ -44,10 +44,15 @@ template<
     typename _Hash = std::hash<_Key>,
     typename _Pred = std::equal_to<_Key>>
 class UnorderedMap
-    : public std::unordered_map<_Key, _Tp, _Hash, _Pred, TAllocator<_Tp>> {
+    : public std::unordered_map<
+          _Key,
+          _Tp,
+          _Hash,
+          _Pred,
+          TAllocator<std::pair<const _Key, _Tp>>> {
 
   private:
-    typedef TAllocator<_Tp> allocator_type;
+    typedef TAllocator<std::pair<const _Key, _Tp>> allocator_type;
     typedef std::unordered_map<_Key, _Tp, _Hash, _Pred, allocator_type>
                                                         _base_class;
     typedef std::unordered_map<_Key, _Tp, _Hash, _Pred> default_version;
@@ -11,94 +11,216 @@
 
 #pragma once
 
-#include "common/defines.hpp"
+#include "memory/memory_system.hpp"
 
-#include <functional>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include <utility>
 
 namespace CORE_NAMESPACE {
 
 template<typename R, typename... Args>
-class Delegate {
-  public:
-    std::size_t owner = 0;
-
-    virtual R call([[maybe_unused]] Args... arguments) { return {}; }
-
-    template<typename R1, typename... Args1>
-    friend bool operator==(
-        Delegate<R1, Args1...>& delete1, Delegate<R1, Args1...>& delegate2
-    );
-};
+class Delegate;
+
+namespace __detail__ {
+    template<typename T>
+    struct is_delegate : std::false_type {};
+    template<typename R, typename... Args>
+    struct is_delegate<Delegate<R, Args...>> : std::true_type {};
+
+    // Type erased lifetime management of callables which can't be memcpy-ed
+    struct DelegateOperations {
+        void (*copy)(void* destination, const void* source);
+        void (*move)(void* destination, void* source);
+        void (*destroy)(void* storage);
+    };
+} // namespace __detail__
 
-template<typename... Args>
-class Delegate<void, Args...> {
+/**
+ * @brief Type erased callable with small buffer storage. Class methods,
+ * function pointers and callables of up to `inline_capacity` bytes are stored
+ * inline, without any heap allocation, so delegates can be kept contiguously
+ * in an array. Larger callables are moved to the heap under the Callback
+ * memory tag. Calling a delegate costs a single indirect call.
+ *
+ * @tparam R Return type
+ * @tparam Args Argument types
+ */
+template<typename R, typename... Args>
+class Delegate {
   public:
-    std::size_t owner = 0;
-
-    virtual void call([[maybe_unused]] Args... arguments) {}
+    /// @brief Maximum size of a callable stored inline
+    static const constexpr uint64 inline_capacity = 4 * sizeof(void*);
+
+    /// @brief Construct empty delegate. It must not be called.
+    Delegate() { std::memset(_storage, 0, inline_capacity); }
+    /**
+     * @brief Construct delegate calling a class method.
+     *
+     * @param caller Class instance on which to call the method
+     * @param method Called method
+     */
+    template<typename T>
+    Delegate(T* const caller, R (T::*method)(Args...))
+        : Delegate(MethodTarget<T> { caller, method }) {}
+    /**
+     * @brief Construct delegate calling any callable (function pointer,
+     * lambda, functor, `std::function`...).
+     *
+     * @param function Called function
+     */
+    template<
+        typename F,
+        typename = std::enable_if_t<
+            !__detail__::is_delegate<std::decay_t<F>>::value &&
+            std::is_invocable_r_v<R, std::decay_t<F>&, Args...>>>
+    Delegate(F&& function) {
+        typedef std::decay_t<F> Callable;
+        std::memset(_storage, 0, inline_capacity);
+
+        if constexpr (is_stored_inline<Callable>) {
+            new (_storage) Callable(std::forward<F>(function));
+            _invoke = invoke_inline<Callable>;
+            if constexpr (!std::is_trivially_copyable_v<Callable>)
+                _operations = &inline_operations<Callable>;
+        } else {
+            const auto callable = new (BaseMemoryTags.Callback)
+                Callable(std::forward<F>(function));
+            std::memcpy(_storage, &callable, sizeof(callable));
+            _invoke     = invoke_heap<Callable>;
+            _operations = &heap_operations<Callable>;
+        }
+    }
 
-    template<typename R1, typename... Args1>
-    friend bool operator==(
-        Delegate<void, Args1...>& delete1, Delegate<void, Args1...>& delegate2
-    );
-};
+    Delegate(const Delegate& other)
+        : _invoke(other._invoke), _operations(other._operations) {
+        if (_operations) _operations->copy(_storage, other._storage);
+        else std::memcpy(_storage, other._storage, inline_capacity);
+    }
+    Delegate(Delegate&& other) noexcept
+        : _invoke(other._invoke), _operations(other._operations) {
+        if (_operations) _operations->move(_storage, other._storage);
+        else std::memcpy(_storage, other._storage, inline_capacity);
+    }
+    ~Delegate() {
+        if (_operations) _operations->destroy(_storage);
+    }
 
-template<typename T, typename R, typename... Args>
-class DelegateMethod : public Delegate<R, Args...> {
-  private:
-    T* _caller;
-    R  (T::*_callback)(Args...);
+    Delegate& operator=(const Delegate& other) {
+        if (this == &other) return *this;
+        this->~Delegate();
+        new (this) Delegate(other);
+        return *this;
+    }
+    Delegate& operator=(Delegate&& other) noexcept {
+        if (this == &other) return *this;
+        this->~Delegate();
+        new (this) Delegate(std::move(other));
+        return *this;
+    }
 
-  public:
-    DelegateMethod(T* caller, R (T::*callback)(Args...))
-        : _caller(caller), _callback(callback) {
-        this->owner = (size_t) caller;
+    /**
+     * @brief Call the stored callable
+     *
+     * @param arguments Arguments passed to the callable
+     * @return R Value returned by the callable
+     */
+    R call(Args... arguments) {
+        return _invoke(_storage, std::forward<Args>(arguments)...);
+    }
+    /**
+     * @brief Passes @p arguments to call.
+     */
+    inline R operator()(Args... arguments) {
+        return _invoke(_storage, std::forward<Args>(arguments)...);
     }
-    ~DelegateMethod() {}
 
-    R call(Args... arguments) { return (_caller->*(_callback))(arguments...); }
+    /// @brief True if delegate holds a callable
+    explicit operator bool() const { return _invoke != nullptr; }
 
-    template<typename R1, typename... Args1>
+    /**
+     * @brief Check whether two delegates call the same target. Methods and
+     * function pointers compare equal if they call the same function (on
+     * the same instance). Trivially copyable callables compare equal if they
+     * are of the same type and hold the same state. All other callables are
+     * only equal to themselves.
+     */
     friend bool operator==(
-        Delegate<R1, Args1...>& delete1, Delegate<R1, Args1...>& delegate2
-    );
-};
+        const Delegate& delegate1, const Delegate& delegate2
+    ) {
+        if (&delegate1 == &delegate2) return true;
+        if (delegate1._invoke != delegate2._invoke) return false;
+        if (delegate1._operations || delegate2._operations) return false;
+        return std::memcmp(
+                   delegate1._storage, delegate2._storage, inline_capacity
+               ) == 0;
+    }
+    friend bool operator!=(
+        const Delegate& delegate1, const Delegate& delegate2
+    ) {
+        return !(delegate1 == delegate2);
+    }
 
-template<typename R, typename... Args>
-class DelegateFunction : public Delegate<R, Args...> {
   private:
-    std::function<R(Args...)> _callback;
-
-  public:
-    DelegateFunction(std::function<R(Args...)> callback)
-        : _callback(callback) {}
-    ~DelegateFunction() {}
-
-    R call(Args... arguments) { return _callback(arguments...); }
+    typedef R (*Invoker)(void*, Args&&...);
+
+    template<typename T>
+    struct MethodTarget {
+        T* caller;
+        R  (T::*method)(Args...);
+
+        R operator()(Args... arguments) const {
+            return (caller->*method)(std::forward<Args>(arguments)...);
+        }
+    };
+
+    template<typename Callable>
+    static const constexpr bool is_stored_inline =
+        sizeof(Callable) <= inline_capacity &&
+        alignof(Callable) <= alignof(std::max_align_t) &&
+        std::is_nothrow_move_constructible_v<Callable>;
+
+    Invoker                                 _invoke     = nullptr;
+    const __detail__::DelegateOperations*   _operations = nullptr;
+    alignas(std::max_align_t) unsigned char _storage[inline_capacity];
+
+    template<typename Callable>
+    static R invoke_inline(void* storage, Args&&... arguments) {
+        return (*(Callable*) storage)(std::forward<Args>(arguments)...);
+    }
+    template<typename Callable>
+    static R invoke_heap(void* storage, Args&&... arguments) {
+        return (**(Callable**) storage)(std::forward<Args>(arguments)...);
+    }
 
-    template<typename R1, typename... Args1>
-    friend bool operator==(
-        Delegate<R1, Args1...>& delete1, Delegate<R1, Args1...>& delegate2
-    );
+    template<typename Callable>
+    static const constexpr __detail__::DelegateOperations inline_operations {
+        [](void* destination, const void* source) {
+            new (destination) Callable(*(const Callable*) source);
+        },
+        [](void* destination, void* source) {
+            new (destination) Callable(std::move(*(Callable*) source));
+        },
+        [](void* storage) { ((Callable*) storage)->~Callable(); }
+    };
+    template<typename Callable>
+    static const constexpr __detail__::DelegateOperations heap_operations {
+        [](void* destination, const void* source) {
+            const auto callable = new (BaseMemoryTags.Callback)
+                Callable(**(Callable* const*) source);
+            std::memcpy(destination, &callable, sizeof(callable));
+        },
+        [](void* destination, void* source) {
+            // Source is left empty, it no longer owns the callable
+            std::memcpy(destination, source, sizeof(Callable*));
+            std::memset(source, 0, sizeof(Callable*));
+        },
+        [](void* storage) {
+            const auto callable = *(Callable**) storage;
+            if (callable) del(callable);
+        }
+    };
 };
 
-template<typename R, typename... Args>
-bool operator==(
-    Delegate<R, Args...>& delegate1, Delegate<R, Args...>& delegate2
-) {
-    if (&delegate1 == &delegate2) return true;
-
-    if (delegate1.owner != delegate2.owner) return false;
-
-    // Method comparison
-    if (delegate1.owner) { return false; }
-
-    // Function comparison
-    auto function1 = dynamic_cast<DelegateFunction<R, Args...>*>(&delegate1);
-    auto function2 = dynamic_cast<DelegateFunction<R, Args...>*>(&delegate2);
-
-    if (function1->_callback == function2->_callback) return true;
-    return false;
-}
-
-} // namespace CORE_NAMESPACE
\ No newline at end of file
+} // namespace CORE_NAMESPACE
@@ -14,32 +14,450 @@
 #include "delegate.hpp"
 #include "container/vector.hpp"
 #include "outcome.hpp"
+#include "multithreading/synchronization.hpp"
+#include "multithreading/thread_pool.hpp"
+
+#include <algorithm>
+#include <mutex>
+#include <tuple>
 
 namespace CORE_NAMESPACE {
 
+/**
+ * @brief Policy by which an event distributes invoked callbacks
+ */
+enum class EventDispatch {
+    /// @brief Callbacks are called one after another on the invoking thread,
+    /// in callback list order (subscription order, unless some were removed)
+    Sequential,
+    /// @brief Callbacks are spread over the thread pool in no particular
+    /// order. Invoke of a void event returns right away, passing callbacks a
+    /// copy of the arguments. Non-void event still waits for all results, but
+    /// reduces them in completion order.
+    ParallelUnordered,
+    /// @brief Callbacks are spread over the thread pool, while the invoking
+    /// thread helps out and waits for all of them to finish. Results are
+    /// reduced in callback list order.
+    ParallelJoin
+};
+
+/**
+ * @brief Handle to a single event subscription. Used for O(1) unsubscribe.
+ * Handles of removed subscriptions are invalidated, so unsubscribing twice is
+ * safe.
+ */
+struct Subscription {
+    uint32 slot       = 0;
+    /// @brief 0 marks handle which doesn't refer to any subscription
+    uint32 generation = 0;
+};
+
+namespace __detail__ {
+    /**
+     * @brief Dispatch state shared by all event specializations. Callbacks
+     * are split into contiguous chunks, one per pool worker, so dispatch cost
+     * doesn't grow with the number of subscribers.
+     */
+    class EventDispatcher {
+      public:
+        /// @brief Current dispatch policy
+        EventDispatch dispatch() const { return _dispatch; }
+        /**
+         * @brief Change dispatch policy
+         *
+         * @param dispatch New policy
+         * @param pool Pool running parallel callbacks. If nullptr, global
+         * thread pool is used.
+         */
+        void set_dispatch(
+            const EventDispatch         dispatch,
+            parallel::ThreadPool* const pool = nullptr
+        ) {
+            _dispatch = dispatch;
+            _pool     = pool;
+        }
+
+        /// @brief Wait for all callbacks still running from unordered
+        /// invocations of a void event. Returns right away when called from
+        /// one of them, which would otherwise wait for itself; changes they
+        /// make to subscribers are deferred (see `CallbackList`).
+        void wait_idle() const {
+            if (_running == this) return;
+            auto count = _in_flight.load(std::memory_order_acquire);
+            while (count != 0) {
+                platform::futex_wait(&_in_flight, count);
+                count = _in_flight.load(std::memory_order_acquire);
+            }
+        }
+
+      protected:
+        EventDispatch         _dispatch;
+        parallel::ThreadPool* _pool;
+
+        EventDispatcher(
+            const EventDispatch dispatch, parallel::ThreadPool* const pool
+        )
+            : _dispatch(dispatch), _pool(pool) {}
+        ~EventDispatcher() { wait_idle(); }
+
+        parallel::ThreadPool& pool() const {
+            return _pool ? *_pool : parallel::ThreadPool::global();
+        }
+
+        /**
+         * @brief Call `job(chunk, begin, end)` for chunks covering
+         * [0, @p count) on pool workers and calling thread (see
+         * `ThreadPool::run_joined`). Returns once all chunks are done.
+         */
+        template<typename Job>
+        void run_joined(
+            const uint64 count, const uint64 chunk_count, const Job& job
+        ) const {
+            pool().run_joined(chunk_count, [&](const uint64 chunk) {
+                job(
+                    chunk,
+                    chunk * count / chunk_count,
+                    (chunk + 1) * count / chunk_count
+                );
+            });
+        }
+
+        /**
+         * @brief Call `job(begin, end)` for chunks covering [0, @p count) on
+         * pool workers, without waiting for them.
+         */
+        template<typename Job>
+        void run_detached(
+            const uint64 count, const uint64 chunk_count, Job job
+        ) {
+            auto&      pool = this->pool();
+            const auto shared_job =
+                std::make_shared<Job>(BaseMemoryTags.Callback, std::move(job));
+
+            _in_flight.fetch_add(
+                (uint32) chunk_count, std::memory_order_relaxed
+            );
+            for (uint64 chunk = 0; chunk < chunk_count; chunk++) {
+                const auto begin = chunk * count / chunk_count;
+                const auto end   = (chunk + 1) * count / chunk_count;
+                pool.submit([this, shared_job, begin, end]() {
+                    const auto outer = _running;
+                    _running         = this;
+                    (*shared_job)(begin, end);
+                    _running = outer;
+                    if (_in_flight.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                        platform::futex_wake_all(&_in_flight);
+                });
+            }
+        }
+
+        /// @brief Number of chunks used for joined dispatch of @p count
+        /// callbacks
+        uint64 joined_chunk_count(const uint64 count) const {
+            return std::min<uint64>(count, pool().thread_count() + 1);
+        }
+        /// @brief Number of chunks used for detached dispatch of @p count
+        /// callbacks
+        uint64 detached_chunk_count(const uint64 count) const {
+            return std::min<uint64>(
+                count, std::max<uint64>(pool().thread_count(), 1)
+            );
+        }
+
+      private:
+        mutable std::atomic<uint32> _in_flight { 0 };
+
+        // Event whose detached chunk runs on this thread
+        inline static thread_local const EventDispatcher* _running = nullptr;
+    };
+
+    /**
+     * @brief Callback storage of an event. Callbacks are kept densely packed
+     * for fast invocation, while subscriptions refer to them through stable,
+     * generation checked slots. Removal swaps the last callback into the
+     * freed position, so it is O(1) but doesn't preserve callback order.
+     *
+     * Callbacks may subscribe and unsubscribe while the list is dispatched
+     * (see `begin_dispatch`). Running callbacks live in the list, so it can't
+     * change until the outermost dispatch ends: removed callbacks are only
+     * marked dead, and added ones are queued. Both are applied once it ends.
+     */
+    template<typename D>
+    class CallbackList {
+      public:
+        CallbackList()
+            : _callbacks(TAllocator<D>(BaseMemoryTags.Callback)),
+              _slot_of(TAllocator<SlotOf>(BaseMemoryTags.Callback)),
+              _slots(TAllocator<Slot>(BaseMemoryTags.Callback)),
+              _free_slots(TAllocator<uint32>(BaseMemoryTags.Callback)),
+              _added(TAllocator<D>(BaseMemoryTags.Callback)),
+              _added_slot_of(TAllocator<uint32>(BaseMemoryTags.Callback)) {}
+
+        /// @brief Number of callbacks, including dead ones, but not ones
+        /// queued during dispatch
+        uint64   size() const { return _callbacks.size(); }
+        D&       operator[](const uint64 i) { return _callbacks[i]; }
+        const D& operator[](const uint64 i) const { return _callbacks[i]; }
+        /// @brief False if callback at @p i was removed during dispatch
+        bool     is_alive(const uint64 i) const {
+            return _slot_of[i].get() != dead;
+        }
+
+        // Appends callback, returning handle to it. During dispatch, it is
+        // queued and positioned past the end of the list.
+        Subscription add(D&& callback) {
+            std::lock_guard<parallel::SpinLock> guard { _lock };
+            const auto slot = acquire_slot();
+            if (_dispatches != 0) {
+                _slots[slot].position =
+                    (uint32) (_callbacks.size() + _added.size());
+                _added.push_back(std::move(callback));
+                _added_slot_of.push_back(slot);
+            } else {
+                _slots[slot].position = (uint32) _callbacks.size();
+                _callbacks.push_back(std::move(callback));
+                _slot_of.push_back(slot);
+            }
+            return { slot, _slots[slot].generation };
+        }
+
+        bool contains(const Subscription subscription) const {
+            std::lock_guard<parallel::SpinLock> guard { _lock };
+            return is_current(subscription);
+        }
+
+        // Removes callback referred to by the handle
+        Outcome remove(const Subscription subscription) {
+            std::lock_guard<parallel::SpinLock> guard { _lock };
+            if (!is_current(subscription)) return Outcome::Failed;
+            remove_at(_slots[subscription.slot].position);
+            return Outcome::Successful;
+        }
+        // Removes first callback equal to the given one
+        Outcome remove(const D& callback) {
+            std::lock_guard<parallel::SpinLock> guard { _lock };
+            for (uint64 i = 0; i < _callbacks.size(); i++) {
+                if (!is_alive(i) || _callbacks[i] != callback) continue;
+                remove_at(i);
+                return Outcome::Successful;
+            }
+            for (uint64 i = 0; i < _added.size(); i++) {
+                if (_added_slot_of[i] == dead || _added[i] != callback)
+                    continue;
+                remove_at(_callbacks.size() + i);
+                return Outcome::Successful;
+            }
+            return Outcome::Failed;
+        }
+
+        /**
+         * @brief Begin @p count dispatches of the list, each ended by a single
+         * `end_dispatch`. Until all of them end, callbacks keep their
+         * positions, so list can be iterated up to its current size.
+         */
+        void begin_dispatch(const uint64 count = 1) {
+            std::lock_guard<parallel::SpinLock> guard { _lock };
+            _dispatches += count;
+        }
+        /// @brief End one dispatch. Last one applies changes made during
+        /// dispatch.
+        void end_dispatch() {
+            std::lock_guard<parallel::SpinLock> guard { _lock };
+            if (--_dispatches == 0) apply_changes();
+        }
+
+      private:
+        struct Slot {
+            uint32 position;
+            // Incremented on removal, invalidating old handles. Never 0.
+            uint32 generation;
+        };
+        // Slot of the callback at the same position, or `dead`. Parallel
+        // dispatch checks it while other callbacks may remove, so it is
+        // atomic. Copied only outside of dispatch.
+        struct SlotOf {
+            std::atomic<uint32> slot;
+
+            SlotOf(const uint32 slot) : slot(slot) {}
+            SlotOf(const SlotOf& other) : slot(other.get()) {}
+            SlotOf& operator=(const SlotOf& other) {
+                set(other.get());
+                return *this;
+            }
+
+            uint32 get() const { return slot.load(std::memory_order_relaxed); }
+            void   set(const uint32 value) {
+                slot.store(value, std::memory_order_relaxed);
+            }
+        };
+        static constexpr uint32 dead = (uint32) -1;
+
+        Vector<D>      _callbacks;
+        Vector<SlotOf> _slot_of;
+        Vector<Slot>   _slots;
+        Vector<uint32> _free_slots;
+        // Callbacks added during dispatch, with their slots (or `dead`)
+        Vector<D>      _added;
+        Vector<uint32> _added_slot_of;
+
+        // Guards changes, which callbacks may make from pool workers
+        mutable parallel::SpinLock _lock {};
+        uint64                     _dispatches = 0;
+        bool                       _has_dead   = false;
+
+        bool is_current(const Subscription subscription) const {
+            return subscription.slot < _slots.size() &&
+                   _slots[subscription.slot].generation ==
+                       subscription.generation;
+        }
+
+        uint32 acquire_slot() {
+            if (_free_slots.empty()) {
+                _slots.push_back({ 0, 1 });
+                return (uint32) _slots.size() - 1;
+            }
+            const auto slot = _free_slots.back();
+            _free_slots.pop_back();
+            return slot;
+        }
+
+        void remove_at(const uint64 position) {
+            const auto added = position >= _callbacks.size();
+            const auto index = position - _callbacks.size();
+            const auto slot =
+                added ? _added_slot_of[index] : _slot_of[position].get();
+            if (++_slots[slot].generation == 0) _slots[slot].generation = 1;
+            _free_slots.push_back(slot);
+
+            // Callback may be running, so it is kept until dispatch ends
+            if (_dispatches == 0) erase(position);
+            else if (added) _added_slot_of[index] = dead;
+            else {
+                _slot_of[position].set(dead);
+                _has_dead = true;
+            }
+        }
+
+        void erase(const uint64 position) {
+            const auto last = _callbacks.size() - 1;
+            if (position != last) {
+                const auto moved_slot = _slot_of[last].get();
+                _callbacks[position]  = std::move(_callbacks[last]);
+                _slot_of[position].set(moved_slot);
+                _slots[moved_slot].position = (uint32) position;
+            }
+            _callbacks.pop_back();
+            _slot_of.pop_back();
+        }
+
+        // Erases dead callbacks, then appends ones added during dispatch
+        void apply_changes() {
+            // From the back, so callbacks swapped in were already checked
+            if (_has_dead)
+                for (uint64 i = _callbacks.size(); i-- > 0;)
+                    if (!is_alive(i)) erase(i);
+            _has_dead = false;
+
+            for (uint64 i = 0; i < _added.size(); i++) {
+                const auto slot = _added_slot_of[i];
+                if (slot == dead) continue;
+                _slots[slot].position = (uint32) _callbacks.size();
+                _callbacks.push_back(std::move(_added[i]));
+                _slot_of.push_back(slot);
+            }
+            _added.clear();
+            _added_slot_of.clear();
+        }
+    };
+
+    /// @brief Ends one dispatch of a callback list once left, even by an
+    /// exception thrown from a callback
+    template<typename List>
+    class DispatchScope {
+      public:
+        explicit DispatchScope(List& list) : _list(list) {}
+        ~DispatchScope() { _list.end_dispatch(); }
+
+        DispatchScope(const DispatchScope&)            = delete;
+        DispatchScope& operator=(const DispatchScope&) = delete;
+
+      private:
+        List& _list;
+    };
+} // namespace __detail__
+
 /**
  * @brief Event object. When invoked (triggered) also invokes all subscribing
  * functions with same function arguments.
  */
 template<typename Signature>
-class Event {
-  private:
-    template<typename R, typename... Args>
-    static Outcome remove_delegate(
-        Vector<Delegate<R, Args...>*> callbacks, Delegate<R, Args...>* delegate
-    ) {
-        auto iter = callbacks.begin();
-        while (iter != callbacks.end()) {
-            if (**iter == *delegate) break;
-            iter++;
-        }
-        if (iter == callbacks.end()) return Outcome::Failed;
+class Event;
+
+/**
+ * @brief Owning subscription handle. Unsubscribes from the event when
+ * destroyed. Must not outlive the event it subscribes to.
+ *
+ *  ```cpp
+ *      {
+ *          auto subscription = event.subscribe_scoped([](int x) { ... });
+ *          event(1); // Callback is called
+ *      }
+ *      event(2);     // Callback is no longer subscribed
+ *  ```
+ */
+class ScopedSubscription {
+  public:
+    ScopedSubscription() {}
+    /**
+     * @brief Take ownership of @p subscription to @p event
+     *
+     * @tparam EventType Any event type with `unsubscribe(Subscription)`
+     */
+    template<typename EventType>
+    ScopedSubscription(EventType& event, const Subscription subscription)
+        : _event(&event), _subscription(subscription),
+          _unsubscribe([](void* event, const Subscription subscription) {
+              ((EventType*) event)->unsubscribe(subscription);
+          }) {}
+    ~ScopedSubscription() { reset(); }
 
-        callbacks.erase(iter);
-        del(*iter);
+    ScopedSubscription(const ScopedSubscription&)            = delete;
+    ScopedSubscription& operator=(const ScopedSubscription&) = delete;
 
-        return Outcome::Successful;
+    ScopedSubscription(ScopedSubscription&& other) noexcept
+        : _event(other._event), _subscription(other._subscription),
+          _unsubscribe(other._unsubscribe) {
+        other._event = nullptr;
+    }
+    ScopedSubscription& operator=(ScopedSubscription&& other) noexcept {
+        if (this == &other) return *this;
+        reset();
+        _event        = other._event;
+        _subscription = other._subscription;
+        _unsubscribe  = other._unsubscribe;
+        other._event  = nullptr;
+        return *this;
     }
+
+    /// @brief Unsubscribe now (if still subscribed)
+    void reset() {
+        if (_event) _unsubscribe(_event, _subscription);
+        _event = nullptr;
+    }
+    /// @brief Give up ownership, leaving callback subscribed
+    /// @return Subscription Handle to the subscription
+    Subscription release() {
+        _event = nullptr;
+        return _subscription;
+    }
+
+    /// @brief True if this object owns a subscription
+    explicit operator bool() const { return _event != nullptr; }
+
+  private:
+    void*        _event = nullptr;
+    Subscription _subscription {};
+    void         (*_unsubscribe)(void*, Subscription) = nullptr;
 };
 
 /**
@@ -50,41 +468,102 @@ class Event {
  * @tparam Args Argument types
  */
 template<typename R, typename... Args>
-class Event<R(Args...)> {
+class Event<R(Args...)> : public __detail__::EventDispatcher {
+  public:
+    /// @brief Function combining results of two callbacks into one
+    typedef std::function<R(const R&, const R&)> Reducer;
+
   private:
-    Vector<Delegate<R, Args...>*> _callbacks {};
+    __detail__::CallbackList<Delegate<R, Args...>> _callbacks {};
+    Reducer                       _reducer {};
 
   public:
-    Event() {}
-    ~Event() {}
+    /**
+     * @brief Construct a new Event object
+     *
+     * @param dispatch Policy by which callbacks are invoked
+     * @param reducer Combines results of all callbacks into the one returned
+     * by invoke. Must be associative, and for unordered dispatch also
+     * commutative. If empty, result of the last callback is returned.
+     * @param pool Pool running parallel callbacks. If nullptr, global thread
+     * pool is used.
+     */
+    Event(
+        const EventDispatch         dispatch = EventDispatch::Sequential,
+        Reducer                     reducer  = {},
+        parallel::ThreadPool* const pool     = nullptr
+    )
+        : EventDispatcher(dispatch, pool), _reducer(std::move(reducer)) {}
+    ~Event() { wait_idle(); }
+
+    Event(const Event&)            = delete;
+    Event& operator=(const Event&) = delete;
+
+    /**
+     * @brief Set function combining results of all callbacks. See constructor.
+     */
+    void set_reducer(Reducer reducer) { _reducer = std::move(reducer); }
 
     /**
      * @brief Subscribe to an event.
      * Attaches a class method as a callback.
      * If multiple instances of the same method are attached, on invoke, method
      * will be called multiple times.
+     * May be called from callbacks during invoke, in which case it is first
+     * called by the next invoke.
      *
      * @tparam Caller class type.
      * @param caller Class from which to call the method.
      * @param callback Called method
+     * @return Subscription Handle used to unsubscribe
      */
     template<typename T>
-    void subscribe(T* caller, R (T::*callback)(Args...)) {
-        auto delegate = DelegateMethod<T, R, Args...>(caller, callback);
-        _callbacks.emplace_back(delegate);
+    Subscription subscribe(T* caller, R (T::*callback)(Args...)) {
+        wait_idle();
+        return _callbacks.add(Delegate<R, Args...>(caller, callback));
     }
     /**
      * @brief Subscribe to an event.
      * Attaches a function as callback.
      * If multiple instances of the same function are attached, on invoke,
      * function will be called multiple times.
+     * May be called from callbacks during invoke, in which case it is first
+     * called by the next invoke.
+     *
+     * @param callback Called function. Small callables are stored inline,
+     * without heap allocation (see `Delegate`).
+     * @return Subscription Handle used to unsubscribe
+     */
+    template<typename F>
+    Subscription subscribe(F&& callback) {
+        wait_idle();
+        return _callbacks.add(
+            Delegate<R, Args...>(std::forward<F>(callback))
+        );
+    }
+    /**
+     * @brief Subscribe to an event for the lifetime of returned object.
      *
      * @param callback Called function
+     * @return ScopedSubscription Unsubscribes once destroyed
+     */
+    template<typename F>
+    [[nodiscard]] ScopedSubscription subscribe_scoped(F&& callback) {
+        return { *this, subscribe(std::forward<F>(callback)) };
+    }
+    /**
+     * @brief Subscribe class method to an event for the lifetime of returned
+     * object.
+     *
+     * @param caller Class from which to call the method.
+     * @param callback Called method
+     * @return ScopedSubscription Unsubscribes once destroyed
      */
-    void subscribe(std::function<R(Args...)> callback) {
-        auto delegate = new (BaseMemoryTags.Callback)
-            DelegateFunction<R, Args...>(callback);
-        _callbacks.emplace_back(delegate);
+    template<typename T>
+    [[nodiscard]] ScopedSubscription subscribe_scoped(
+        T* caller, R (T::*callback)(Args...)
+    ) {
+        return { *this, subscribe(caller, callback) };
     }
 
     /**
@@ -97,56 +576,149 @@ class Event<R(Args...)> {
      */
     template<typename T>
     Outcome unsubscribe(T* caller, R (T::*callback)(Args...)) {
-        auto delegate = new (BaseMemoryTags.Callback)
-            DelegateMethod<T, R, Args...>(caller, callback);
-        return remove_delegate(_callbacks, delegate);
+        wait_idle();
+        return _callbacks.remove(Delegate<R, Args...>(caller, callback));
+    }
+    /**
+     * @brief Unsubscribe from the event in O(1).
+     * Callback order isn't preserved, last callback takes place of the
+     * removed one. May be called from callbacks during invoke, in which case
+     * removed callback isn't called again, and is destroyed once invoke
+     * ends.
+     *
+     * @param subscription Handle returned by subscribe
+     * @return true If a callback was detached
+     * @return false If handle is no longer subscribed
+     */
+    Outcome unsubscribe(const Subscription subscription) {
+        wait_idle();
+        return _callbacks.remove(subscription);
     }
 
     /**
      * @brief Unsubscribe from the event.
      * Detaches one instance of attached function from the list.
      *
-     * @param callback Function to detach.
+     * @param callback Function to detach. Only function pointers and
+     * trivially copyable callables can be matched (see `Delegate`).
      * @return true If a function was detached
      * @return false If no such function was found
      */
-    Outcome unsubscribe(std::function<R(Args...)> callback) {
-        auto delegate = new (BaseMemoryTags.Callback)
-            DelegateFunction<R, Args...>(callback);
-        return remove_delegate(_callbacks, delegate);
+    template<
+        typename F,
+        typename = std::enable_if_t<
+            !std::is_same_v<std::decay_t<F>, Subscription>>>
+    Outcome unsubscribe(F&& callback) {
+        wait_idle();
+        return _callbacks.remove(
+            Delegate<R, Args...>(std::forward<F>(callback))
+        );
+    }
+
+    /// @brief True if @p subscription still refers to a subscribed callback
+    bool is_subscribed(const Subscription subscription) const {
+        return _callbacks.contains(subscription);
     }
 
     /**
-     * @brief Invoke all subscribed callbacks with the passed arguments.
+     * @brief Invoke all subscribed callbacks with the passed arguments,
+     * according to the dispatch policy. Waits for all callbacks in every
+     * policy, since their results are needed.
      *
      * @param arguments Arguments to be passed to callbacks.
-     * @return R Value returned by the last invoked callback.
+     * @return R Results of all callbacks combined by the reducer, or value
+     * returned by the last callback if there is no reducer.
      */
     R invoke(Args... arguments) {
-        R result;
-        // TODO: Make parallel
-        for (auto callback : _callbacks) {
-            result = callback->call(arguments...);
+        _callbacks.begin_dispatch();
+        const __detail__::DispatchScope scope { _callbacks };
+
+        // Callbacks removed during dispatch are skipped
+        const auto count        = _callbacks.size();
+        const auto reduce_range = [&](const uint64 begin, const uint64 end) {
+            PartialResult result {};
+            for (uint64 i = begin; i < end; i++)
+                if (_callbacks.is_alive(i))
+                    accumulate(result, _callbacks[i].call(arguments...));
+            return result;
+        };
+        if (_dispatch == EventDispatch::Sequential || count < 2)
+            return reduce_range(0, count).value;
+
+        // Each chunk is reduced locally first, so reducer is never called
+        // concurrently on the same value
+        const auto chunk_count = joined_chunk_count(count);
+        PartialResult result {};
+
+        if (_dispatch == EventDispatch::ParallelJoin) {
+            Vector<PartialResult> results(
+                chunk_count,
+                PartialResult {},
+                TAllocator<PartialResult>(BaseMemoryTags.Callback)
+            );
+            run_joined(
+                count,
+                chunk_count,
+                [&](const uint64 chunk, const uint64 begin, const uint64 end) {
+                    results[chunk] = reduce_range(begin, end);
+                }
+            );
+
+            for (const auto& partial : results)
+                if (partial.has_value) accumulate(result, partial.value);
+            return result.value;
         }
-        return result;
+
+        // Unordered, chunk results are merged as they come
+        parallel::SpinLock lock {};
+        run_joined(
+            count,
+            chunk_count,
+            [&](const uint64, const uint64 begin, const uint64 end) {
+                const auto partial = reduce_range(begin, end);
+                if (!partial.has_value) return;
+                std::lock_guard<parallel::SpinLock> guard { lock };
+                accumulate(result, partial.value);
+            }
+        );
+        return result.value;
     }
 
     /**
      * @brief Passes @p callback to subscribe.
      */
-    inline void operator+=(std::function<R(Args...)> callback) {
-        subscribe(callback);
+    template<typename F>
+    inline Subscription operator+=(F&& callback) {
+        return subscribe(std::forward<F>(callback));
     }
     /**
      * @brief Passes @p callback to unsubscribe.
      */
-    inline void operator-=(std::function<R(Args...)> callback) {
-        unsubscribe(callback);
+    template<typename F>
+    inline void operator-=(F&& callback) {
+        unsubscribe(std::forward<F>(callback));
     }
     /**
      * @brief Calls invoke with passed \p arguments.
      */
     inline R operator()(Args... arguments) { return invoke(arguments...); }
+
+  private:
+    // Results of some callbacks, reduced. Wrapped, since results of
+    // `Vector<bool>` share memory.
+    struct PartialResult {
+        R    value {};
+        bool has_value = false;
+    };
+
+    R reduce(const R& accumulated, const R& value) const {
+        return _reducer ? _reducer(accumulated, value) : value;
+    }
+    void accumulate(PartialResult& result, const R& value) const {
+        result.value =
+            result.has_value ? reduce(result.value, value) : value;
+        result.has_value = true;
+    }
 };
 
 /**
@@ -156,42 +728,88 @@ class Event<R(Args...)> {
  * @tparam Args Argument types
  */
 template<typename... Args>
-class Event<void(Args...)> {
+class Event<void(Args...)> : public __detail__::EventDispatcher {
   private:
-    Vector<Delegate<void, Args...>*> _callbacks {};
+    __detail__::CallbackList<Delegate<void, Args...>> _callbacks {};
 
   public:
-    Event() {}
-    ~Event() {}
+    /**
+     * @brief Construct a new Event object
+     *
+     * @param dispatch Policy by which callbacks are invoked
+     * @param pool Pool running parallel callbacks. If nullptr, global thread
+     * pool is used.
+     */
+    Event(
+        const EventDispatch         dispatch = EventDispatch::Sequential,
+        parallel::ThreadPool* const pool     = nullptr
+    )
+        : EventDispatcher(dispatch, pool) {}
+    ~Event() { wait_idle(); }
+
+    Event(const Event&)            = delete;
+    Event& operator=(const Event&) = delete;
 
     /**
      * @brief Subscribe to an event.
      * Attaches a class method as a callback.
      * If multiple instances of the same method are attached, on invoke, method
      * will be called multiple times.
+     * May be called from callbacks during invoke, in which case it is first
+     * called by the next invoke.
      *
      * @tparam Caller class type.
      * @param caller Class from which to call the method.
      * @param callback Called method
+     * @return Subscription Handle used to unsubscribe
      */
     template<typename T>
-    void subscribe(T* caller, void (T::*callback)(Args...)) {
-        auto delegate = new (BaseMemoryTags.Callback)
-            DelegateMethod<T, void, Args...>(caller, callback);
-        _callbacks.emplace_back(delegate);
+    Subscription subscribe(T* caller, void (T::*callback)(Args...)) {
+        wait_idle();
+        return _callbacks.add(Delegate<void, Args...>(caller, callback));
     }
     /**
      * @brief Subscribe to an event.
      * Attaches a function as callback.
      * If multiple instances of the same function are attached, on invoke,
      * function will be called multiple times.
+     * May be called from callbacks during invoke, in which case it is first
+     * called by the next invoke.
+     *
+     * @param callback Called function. Small callables are stored inline,
+     * without heap allocation (see `Delegate`).
+     * @return Subscription Handle used to unsubscribe
+     */
+    template<typename F>
+    Subscription subscribe(F&& callback) {
+        wait_idle();
+        return _callbacks.add(
+            Delegate<void, Args...>(std::forward<F>(callback))
+        );
+    }
+    /**
+     * @brief Subscribe to an event for the lifetime of returned object.
      *
      * @param callback Called function
+     * @return ScopedSubscription Unsubscribes once destroyed
      */
-    void subscribe(std::function<void(Args...)> callback) {
-        auto delegate = new (BaseMemoryTags.Callback)
-            DelegateFunction<void, Args...>(callback);
-        _callbacks.emplace_back(delegate);
+    template<typename F>
+    [[nodiscard]] ScopedSubscription subscribe_scoped(F&& callback) {
+        return { *this, subscribe(std::forward<F>(callback)) };
+    }
+    /**
+     * @brief Subscribe class method to an event for the lifetime of returned
+     * object.
+     *
+     * @param caller Class from which to call the method.
+     * @param callback Called method
+     * @return ScopedSubscription Unsubscribes once destroyed
+     */
+    template<typename T>
+    [[nodiscard]] ScopedSubscription subscribe_scoped(
+        T* caller, void (T::*callback)(Args...)
+    ) {
+        return { *this, subscribe(caller, callback) };
     }
 
     /**
@@ -204,47 +822,130 @@ class Event<void(Args...)> {
      */
     template<typename T>
     Outcome unsubscribe(T* caller, void (T::*callback)(Args...)) {
-        auto delegate = new (BaseMemoryTags.Callback)
-            DelegateMethod<T, void, Args...>(caller, callback);
-        return remove_delegate(_callbacks, delegate);
+        wait_idle();
+        return _callbacks.remove(Delegate<void, Args...>(caller, callback));
+    }
+    /**
+     * @brief Unsubscribe from the event in O(1).
+     * Callback order isn't preserved, last callback takes place of the
+     * removed one. May be called from callbacks during invoke, in which case
+     * removed callback isn't called again, and is destroyed once invoke
+     * ends.
+     *
+     * @param subscription Handle returned by subscribe
+     * @return true If a callback was detached
+     * @return false If handle is no longer subscribed
+     */
+    Outcome unsubscribe(const Subscription subscription) {
+        wait_idle();
+        return _callbacks.remove(subscription);
     }
 
     /**
      * @brief Unsubscribe from the event.
      * Detaches one instance of attached function from the list.
      *
-     * @param callback Function to detach.
+     * @param callback Function to detach. Only function pointers and
+     * trivially copyable callables can be matched (see `Delegate`).
      * @return true If a function was detached
      * @return false If no such function was found
      */
-    Outcome unsubscribe(std::function<void(Args...)> callback) {
-        auto delegate = new (BaseMemoryTags.Callback)
-            DelegateFunction<void, Args...>(callback);
-        return remove_delegate(_callbacks, delegate);
+    template<
+        typename F,
+        typename = std::enable_if_t<
+            !std::is_same_v<std::decay_t<F>, Subscription>>>
+    Outcome unsubscribe(F&& callback) {
+        wait_idle();
+        return _callbacks.remove(
+            Delegate<void, Args...>(std::forward<F>(callback))
+        );
+    }
+
+    /// @brief True if @p subscription still refers to a subscribed callback
+    bool is_subscribed(const Subscription subscription) const {
+        return _callbacks.contains(subscription);
     }
 
     /**
-     * @brief Invoke all subscribed callbacks with the passed arguments.
+     * @brief Invoke all subscribed callbacks with the passed arguments,
+     * according to the dispatch policy. With unordered dispatch, callbacks
+     * may still be running after return; event waits for them before its
+     * subscribers change or it is destroyed.
      *
      * @param arguments Arguments to be passed to callbacks.
      */
     void invoke(Args... arguments) {
-        for (auto callback : _callbacks) {
-            callback->call(arguments...);
+        _callbacks.begin_dispatch();
+        const auto count = _callbacks.size();
+        if (_dispatch != EventDispatch::ParallelUnordered || count < 2) {
+            const __detail__::DispatchScope scope { _callbacks };
+            if (_dispatch == EventDispatch::Sequential || count < 2) {
+                for (uint64 i = 0; i < count; i++)
+                    if (_callbacks.is_alive(i))
+                        _callbacks[i].call(arguments...);
+                return;
+            }
+
+            run_joined(
+                count,
+                joined_chunk_count(count),
+                [&](const uint64, const uint64 begin, const uint64 end) {
+                    for (uint64 i = begin; i < end; i++)
+                        if (_callbacks.is_alive(i))
+                            _callbacks[i].call(arguments...);
+                }
+            );
+            return;
         }
+
+        // Callbacks outlive this call, so they work on a copy of arguments,
+        // and each chunk ends its own dispatch (first one ends the dispatch
+        // begun above). Chunks run concurrently, so they share the copy only
+        // as const; callbacks taking non-const references get one per chunk.
+        typedef std::tuple<std::decay_t<Args>...> Arguments;
+        constexpr bool modifies_arguments =
+            ((std::is_lvalue_reference_v<Args> &&
+              !std::is_const_v<std::remove_reference_t<Args>>) ||
+             ...);
+        const auto chunk_count = detached_chunk_count(count);
+        _callbacks.begin_dispatch(chunk_count - 1);
+        run_detached(
+            count,
+            chunk_count,
+            [this, arguments = Arguments(arguments...)](
+                const uint64 begin, const uint64 end
+            ) {
+                const __detail__::DispatchScope scope { _callbacks };
+                std::conditional_t<
+                    modifies_arguments,
+                    Arguments,
+                    const Arguments&>
+                    chunk_arguments = arguments;
+                for (uint64 i = begin; i < end; i++)
+                    if (_callbacks.is_alive(i))
+                        std::apply(
+                            [&](auto&... values) {
+                                _callbacks[i].call(values...);
+                            },
+                            chunk_arguments
+                        );
+            }
+        );
     }
 
     /**
      * @brief Passes @p callback to subscribe.
      */
-    inline void operator+=(std::function<void(Args...)> callback) {
-        subscribe(callback);
+    template<typename F>
+    inline Subscription operator+=(F&& callback) {
+        return subscribe(std::forward<F>(callback));
     }
     /**
      * @brief Passes @p callback to unsubscribe.
      */
-    inline void operator-=(std::function<void(Args...)> callback) {
-        unsubscribe(callback);
+    template<typename F>
+    inline void operator-=(F&& callback) {
+        unsubscribe(std::forward<F>(callback));
     }
     /**
      * @brief Calls invoke with passed \p arguments.
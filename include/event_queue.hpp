@@ -0,0 +1,323 @@
+/**
+ * @file event_queue.hpp
+ * @author Android172 (android172unity@gmail.com)
+ * @brief Defines deferred event queue with typed channels.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include "event.hpp"
+#include "container/unordered_map.hpp"
+
+#include <shared_mutex>
+
+namespace CORE_NAMESPACE {
+
+namespace __detail__ {
+    // Id shared by all event queues for each enqueued event type
+    inline uint32 next_event_channel_id() {
+        static std::atomic<uint32> next { 0 };
+        return next.fetch_add(1, std::memory_order_relaxed);
+    }
+    template<typename E>
+    uint32 event_channel_id() {
+        static const uint32 id = next_event_channel_id();
+        return id;
+    }
+
+    class EventChannelBase {
+      public:
+        virtual ~EventChannelBase() {}
+
+        // Destroys and frees the channel, which may be over aligned
+        virtual void   destroy()       = 0;
+        virtual void   dispatch()      = 0;
+        virtual void   clear()         = 0;
+        virtual uint64 pending() const = 0;
+    };
+
+    template<typename E>
+    class EventChannel : public EventChannelBase {
+      public:
+        typedef std::function<uint64(const E&)> KeyFunction;
+
+        Event<void(const E&)> event {};
+
+        EventChannel(const MemoryTag tag)
+            : _tag(tag), _pending(TAllocator<E>(tag)),
+              _processing(TAllocator<E>(tag)),
+              _pending_index(
+                  (uint64) 0,
+                  std::hash<uint64>(),
+                  std::equal_to<uint64>(),
+                  TAllocator<std::pair<const uint64, uint64>>(tag)
+              ) {}
+        ~EventChannel() override {}
+
+        // Channel holds cache line aligned locks, so it is allocated with
+        // `TAllocator`, which aligns it
+        static EventChannel* create(const MemoryTag tag) {
+            TAllocator<EventChannel> allocator { tag };
+            return new (allocator.allocate(1)) EventChannel(tag);
+        }
+        void destroy() override {
+            TAllocator<EventChannel> allocator { _tag };
+            this->~EventChannel();
+            allocator.deallocate(this, 1);
+        }
+
+        void push(E&& event) {
+            std::lock_guard<parallel::SpinLock> lock { _lock };
+            if (!_key) {
+                _pending.push_back(std::move(event));
+                return;
+            }
+
+            // Replace pending event with the same key, keeping its position
+            const auto key = _key(event);
+            const auto it  = _pending_index.find(key);
+            if (it != _pending_index.end()) {
+                _pending[it->second] = std::move(event);
+                return;
+            }
+            _pending_index.emplace(key, _pending.size());
+            _pending.push_back(std::move(event));
+        }
+
+        void set_key(KeyFunction key) {
+            std::lock_guard<parallel::SpinLock> lock { _lock };
+            _key = std::move(key);
+            _pending_index.clear();
+            if (!_key) return;
+
+            // Coalesce already pending events
+            Vector<E> pending { _pending.get_allocator() };
+            std::swap(pending, _pending);
+            for (auto& event : pending) {
+                const auto key = _key(event);
+                const auto it  = _pending_index.find(key);
+                if (it != _pending_index.end()) {
+                    _pending[it->second] = std::move(event);
+                    continue;
+                }
+                _pending_index.emplace(key, _pending.size());
+                _pending.push_back(std::move(event));
+            }
+        }
+
+        void dispatch() override {
+            {
+                std::lock_guard<parallel::SpinLock> lock { _lock };
+                std::swap(_pending, _processing);
+                _pending_index.clear();
+            }
+            for (const auto& event : _processing)
+                this->event.invoke(event);
+            _processing.clear();
+        }
+        void clear() override {
+            std::lock_guard<parallel::SpinLock> lock { _lock };
+            _pending.clear();
+            _pending_index.clear();
+        }
+        uint64 pending() const override {
+            std::lock_guard<parallel::SpinLock> lock { _lock };
+            return _pending.size();
+        }
+
+      private:
+        MemoryTag                    _tag;
+        mutable parallel::SpinLock   _lock {};
+        Vector<E>                    _pending;
+        Vector<E>                    _processing;
+        KeyFunction                  _key {};
+        UnorderedMap<uint64, uint64> _pending_index;
+    };
+} // namespace __detail__
+
+/**
+ * @brief Deferred event bus. Producers enqueue events of any type from any
+ * thread, which only costs a short lock and a copy into a per type buffer.
+ * Events are delivered to subscribers later, when consumer drains the queue
+ * with `dispatch` (ex. once per frame). Events of the same type are stored
+ * and dispatched contiguously, in order of enqueueing.
+ *
+ * Each event type has its own channel, with an `Event<void(const E&)>` used
+ * for subscription. Channel can be set to coalesce events, so only the most
+ * recent of the events sharing a key is delivered per dispatch.
+ *
+ *  ```cpp
+ *      EventQueue queue {};
+ *      queue.subscribe<Resized>([](const Resized& e) { ... });
+ *      queue.coalesce<Resized>([](const Resized&) { return 0; });
+ *
+ *      queue.enqueue(Resized { 800, 600 }); // From any thread
+ *      queue.enqueue(Resized { 1024, 768 });
+ *      queue.dispatch(); // Delivers only { 1024, 768 }
+ *  ```
+ */
+class EventQueue {
+  public:
+    /**
+     * @brief Construct a new Event Queue object
+     *
+     * @param tag Memory tag used for event buffers
+     */
+    explicit EventQueue(const MemoryTag tag = BaseMemoryTags.Array)
+        : _tag(tag),
+          _channels(TAllocator<__detail__::EventChannelBase*>(tag)) {}
+    ~EventQueue() {
+        for (auto channel : _channels)
+            if (channel) channel->destroy();
+    }
+
+    EventQueue(const EventQueue&)            = delete;
+    EventQueue& operator=(const EventQueue&) = delete;
+
+    // -------------------------------------------------------------------------
+    // Producer side
+    // -------------------------------------------------------------------------
+
+    /**
+     * @brief Queue @p event for delivery on next dispatch. Thread safe.
+     */
+    template<typename E>
+    void enqueue(E&& event) {
+        typedef std::decay_t<E> Type;
+        channel<Type>().push(Type(std::forward<E>(event)));
+    }
+    /**
+     * @brief Queue event of type @p E constructed from @p args.
+     * Thread safe.
+     */
+    template<typename E, typename... Args>
+    void emplace(Args&&... args) {
+        channel<E>().push(E { std::forward<Args>(args)... });
+    }
+
+    // -------------------------------------------------------------------------
+    // Consumer side
+    // -------------------------------------------------------------------------
+
+    /**
+     * @brief Get event invoked for every dispatched event of type @p E. Can
+     * be used to set its dispatch policy, or subscribe with any of the
+     * `Event` methods. Subscriptions must not change during dispatch.
+     */
+    template<typename E>
+    Event<void(const E&)>& event() {
+        return channel<E>().event;
+    }
+    /**
+     * @brief Subscribe @p callback to events of type @p E.
+     * @return Subscription Handle used to unsubscribe
+     */
+    template<typename E, typename F>
+    Subscription subscribe(F&& callback) {
+        return channel<E>().event.subscribe(std::forward<F>(callback));
+    }
+    /**
+     * @brief Unsubscribe from events of type @p E.
+     * @return true If a callback was detached
+     * @return false If handle is no longer subscribed
+     */
+    template<typename E>
+    Outcome unsubscribe(const Subscription subscription) {
+        return channel<E>().event.unsubscribe(subscription);
+    }
+
+    /**
+     * @brief Coalesce events of type @p E. Of all events with the same key
+     * enqueued between two dispatches, only the most recent one is
+     * delivered, in place of the first one.
+     *
+     * @param key Function returning key of an event. If empty, coalescing is
+     * turned off.
+     */
+    template<typename E>
+    void coalesce(std::function<uint64(const E&)> key) {
+        channel<E>().set_key(std::move(key));
+    }
+
+    /**
+     * @brief Deliver all pending events to their subscribers, type by type.
+     * Events enqueued while dispatching (ex. by callbacks) are delivered on
+     * the next dispatch. Only one thread may dispatch at a time.
+     */
+    void dispatch() {
+        for (uint64 i = 0; i < channel_count(); i++) {
+            const auto channel = channel_at(i);
+            if (channel) channel->dispatch();
+        }
+    }
+    /**
+     * @brief Deliver all pending events of type @p E. See `dispatch`.
+     */
+    template<typename E>
+    void dispatch() {
+        channel<E>().dispatch();
+    }
+
+    /**
+     * @brief Discard all pending events
+     */
+    void clear() {
+        for (uint64 i = 0; i < channel_count(); i++) {
+            const auto channel = channel_at(i);
+            if (channel) channel->clear();
+        }
+    }
+
+    /// @brief Number of events of type @p E waiting for dispatch
+    template<typename E>
+    uint64 pending() const {
+        const auto channel = channel_at(__detail__::event_channel_id<E>());
+        return channel ? channel->pending() : 0;
+    }
+    /// @brief Number of events of all types waiting for dispatch
+    uint64 pending() const {
+        uint64 total = 0;
+        for (uint64 i = 0; i < channel_count(); i++) {
+            const auto channel = channel_at(i);
+            if (channel) total += channel->pending();
+        }
+        return total;
+    }
+
+  private:
+    MemoryTag                             _tag;
+    mutable parallel::RWLock              _channels_lock {};
+    Vector<__detail__::EventChannelBase*> _channels;
+
+    uint64 channel_count() const {
+        std::shared_lock<parallel::RWLock> lock { _channels_lock };
+        return _channels.size();
+    }
+    __detail__::EventChannelBase* channel_at(const uint64 id) const {
+        std::shared_lock<parallel::RWLock> lock { _channels_lock };
+        return id < _channels.size() ? _channels[id] : nullptr;
+    }
+
+    template<typename E>
+    __detail__::EventChannel<E>& channel() {
+        const auto id = __detail__::event_channel_id<E>();
+        {
+            std::shared_lock<parallel::RWLock> lock { _channels_lock };
+            if (id < _channels.size() && _channels[id])
+                return *(__detail__::EventChannel<E>*) _channels[id];
+        }
+
+        std::lock_guard<parallel::RWLock> lock { _channels_lock };
+        if (id >= _channels.size()) _channels.resize(id + 1, nullptr);
+        if (!_channels[id])
+            _channels[id] = __detail__::EventChannel<E>::create(_tag);
+        return *(__detail__::EventChannel<E>*) _channels[id];
+    }
+};
+
+} // namespace CORE_NAMESPACE
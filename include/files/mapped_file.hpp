@@ -0,0 +1,82 @@
+/**
+ * @file mapped_file.hpp
+ * @author Android172 (android172unity@gmail.com)
+ * @brief Defines read only memory mapped file
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+
+#include "path.hpp"
+#include "result.hpp"
+#include "string.hpp"
+#include "common/error_types.hpp"
+#include "platform/platform.hpp"
+
+namespace CORE_NAMESPACE {
+
+/**
+ * @brief Whole file mapped into memory for reading. Opening doesn't read the
+ * file; its pages are loaded by the system once accessed, so data can be used
+ * in place (ex. through `SerializedView`) without copying it first. File is
+ * unmapped once the object is destroyed. Move only.
+ */
+class MappedFile {
+  public:
+    MappedFile() {}
+    ~MappedFile() { unmap(); }
+
+    MappedFile(const MappedFile&)            = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) : _data(other._data), _size(other._size) {
+        other._data = nullptr;
+        other._size = 0;
+    }
+    MappedFile& operator=(MappedFile&& other) {
+        if (this == &other) return *this;
+        unmap();
+        _data       = other._data;
+        _size       = other._size;
+        other._data = nullptr;
+        other._size = 0;
+        return *this;
+    }
+
+    /**
+     * @brief Map file at @p file_path into memory
+     *
+     * @param file_path File path
+     * @return MappedFile If successful
+     * @throw RuntimeError If file doesn't exist, is empty, or can't be mapped
+     */
+    static Result<MappedFile, RuntimeError> open(const Path& file_path) {
+        MappedFile file {};
+        file._data = platform::map_file(file_path.string().c_str(), file._size);
+        if (file._data == nullptr)
+            return Failure("Failed to map file:" + file_path.string());
+        return file;
+    }
+
+    /// @brief Start of mapped file content
+    const byte* data() const { return (const byte*) _data; }
+    /// @brief Size of mapped file content in bytes
+    uint64      size() const { return _size; }
+    /// @brief View of mapped file content
+    StringView  view() const { return { data(), _size }; }
+    /// @brief True if a file is mapped
+    bool        is_mapped() const { return _data != nullptr; }
+
+  private:
+    const void* _data = nullptr;
+    uint64      _size = 0;
+
+    void unmap() {
+        if (_data != nullptr) platform::unmap_file(_data, _size);
+    }
+};
+
+} // namespace CORE_NAMESPACE
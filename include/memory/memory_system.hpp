@@ -66,6 +66,8 @@ struct BaseMemoryTags : public MemoryTagStruct {
     MemoryTag Set;
     MemoryTag String;
     MemoryTag Callback;
+    // Coroutine frames
+    MemoryTag Coroutine;
 
     BaseMemoryTags() { MemoryTag::id_count = 0; }
 } static BaseMemoryTags = {};
@@ -192,11 +194,26 @@ struct TAllocator {
 
 template<class T>
 T* TAllocator<T>::allocate(const std::size_t n) const {
-    return (T*) operator new(n * sizeof(T), this->tag);
+    if constexpr (alignof(T) <= MEMORY_PADDING)
+        return (T*) operator new(n * sizeof(T), this->tag);
+    else {
+        // Allocators only guarantee `MEMORY_PADDING` alignment, so over
+        // aligned types are aligned manually. Allocated address is kept
+        // right before the aligned one.
+        const auto memory =
+            operator new(n * sizeof(T) + alignof(T) + sizeof(void*), this->tag);
+        const auto address = (uint64) memory + sizeof(void*);
+        const auto aligned = (address + alignof(T) - 1) & ~(alignof(T) - 1);
+        ((void**) aligned)[-1] = memory;
+        return (T*) aligned;
+    }
 }
 template<class T>
-void TAllocator<T>::deallocate(T* const p, std::size_t n) const noexcept {
-    ::operator delete(p);
+void TAllocator<T>::deallocate(
+    T* const p, [[maybe_unused]] std::size_t n
+) const noexcept {
+    if constexpr (alignof(T) <= MEMORY_PADDING) ::operator delete(p);
+    else ::operator delete(((void**) p)[-1]);
 }
 
 } // namespace CORE_NAMESPACE
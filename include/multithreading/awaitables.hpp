@@ -0,0 +1,173 @@
+/**
+ * @file awaitables.hpp
+ * @author Android172 (android172unity@gmail.com)
+ * @brief Provides awaitable operations for use inside of coroutine `Task`s.
+ * Available only if core is built with coroutine support
+ * (`-DCORE_COROUTINES=ON`).
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include "task.hpp"
+#include "files/file_system.hpp"
+#include "files/file_types.hpp"
+
+#include <type_traits>
+
+namespace CORE_NAMESPACE {
+
+namespace parallel {
+
+    namespace __detail__ {
+        struct ScheduleAwaiter {
+            ThreadPool& pool;
+            uint64      delay_ms;
+
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<> handle) const {
+                pool.submit_after(delay_ms, [handle]() { handle.resume(); });
+            }
+            void await_resume() const noexcept {}
+        };
+
+        template<typename Function>
+        struct OffloadAwaiter {
+            using R = std::invoke_result_t<Function&>;
+            using Storage =
+                std::conditional_t<std::is_void_v<R>, bool, std::optional<R>>;
+
+            Function           function;
+            ThreadPool&        pool;
+            Storage            result {};
+            std::exception_ptr exception {};
+
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<> handle) {
+                pool.submit([this, handle]() {
+                    try {
+                        if constexpr (std::is_void_v<R>) function();
+                        else result.emplace(function());
+                    } catch (...) { exception = std::current_exception(); }
+                    handle.resume();
+                });
+            }
+            R await_resume() {
+                if (exception) std::rethrow_exception(exception);
+                if constexpr (!std::is_void_v<R>) return std::move(*result);
+            }
+        };
+    } // namespace __detail__
+
+    /**
+     * @brief Suspend the awaiting coroutine and resume it on one of the
+     * workers of the given pool.
+     *
+     * @param pool Thread pool to continue on
+     */
+    inline auto schedule(ThreadPool& pool = ThreadPool::global()) {
+        return __detail__::ScheduleAwaiter { pool, 0 };
+    }
+
+    /**
+     * @brief Suspend the awaiting coroutine for at least @p ms milliseconds.
+     * Coroutine is afterwards resumed on the given pool. No thread is blocked
+     * while waiting.
+     *
+     * @param ms Time to sleep in milliseconds
+     * @param pool Thread pool to continue on
+     */
+    inline auto sleep_for(
+        const uint64 ms, ThreadPool& pool = ThreadPool::global()
+    ) {
+        return __detail__::ScheduleAwaiter { pool, ms };
+    }
+
+    /**
+     * @brief Run blocking @p function on the given pool and resume awaiting
+     * coroutine with its result (on the same worker). Exceptions thrown by
+     * @p function are rethrown inside of awaiting coroutine.
+     *
+     * @param function Callable to execute
+     * @param pool Thread pool to execute on
+     */
+    template<typename Function>
+    auto offload(Function function, ThreadPool& pool = ThreadPool::global()) {
+        return __detail__::OffloadAwaiter<Function> { std::move(function),
+                                                      pool };
+    }
+
+    /**
+     * @brief Asynchronously open and fully read a file of given file type.
+     *
+     *  ```cpp
+     *      auto result = co_await parallel::read_file<TextIn>("config.txt");
+     *  ```
+     *
+     * @tparam FileT File type used for reading (ex. TextIn, BinaryIn)
+     * @param file_path File path
+     * @param mode Active file open modes
+     * @param pool Thread pool doing the IO
+     * @return Read data if successful
+     * @throw RuntimeError If file couldn't be opened
+     */
+    template<typename FileT>
+    auto read_file(
+        const Path&          file_path,
+        FileSystem::OpenMode mode = {},
+        ThreadPool&          pool = ThreadPool::global()
+    ) {
+        using T = decltype(std::declval<File<FileT>&>().read_all());
+        return offload(
+            [file_path, mode]() -> Result<T, RuntimeError> {
+                auto result = FileSystem::open<FileT>(file_path, mode);
+                if (result.has_error()) return Failure(result.error());
+                const auto file { std::move(result.value()) };
+                auto       data = file->read_all();
+                file->close();
+                return data;
+            },
+            pool
+        );
+    }
+
+    /**
+     * @brief Asynchronously create (or open) a file of given file type and
+     * write @p data into it.
+     *
+     * @tparam FileT File type used for writing (ex. TextOut, BinaryOut)
+     * @tparam T Written data type
+     * @param file_path File path
+     * @param data Data to be written. Copied into the awaitable.
+     * @param mode Active file open modes
+     * @param pool Thread pool doing the IO
+     * @throw RuntimeError If file couldn't be opened or created
+     */
+    template<typename FileT, typename T>
+    auto write_file(
+        const Path&          file_path,
+        T                    data,
+        FileSystem::OpenMode mode = {},
+        ThreadPool&          pool = ThreadPool::global()
+    ) {
+        return offload(
+            [file_path, mode, data = std::move(data)]()
+                -> Result<void, RuntimeError> {
+                auto result = FileSystem::create_or_open<FileT>(file_path, mode);
+                if (result.has_error()) return Failure(result.error());
+                const auto file { std::move(result.value()) };
+                file->write(data);
+                file->close();
+                return {};
+            },
+            pool
+        );
+    }
+
+} // namespace parallel
+
+} // namespace CORE_NAMESPACE
@@ -0,0 +1,154 @@
+/**
+ * @file generator.hpp
+ * @author Android172 (android172unity@gmail.com)
+ * @brief Defines C++20 coroutine generator type. Available only if core is
+ * built with coroutine support (`-DCORE_COROUTINES=ON`).
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include "task.hpp"
+
+#include <iterator>
+#include <memory>
+
+namespace CORE_NAMESPACE {
+
+namespace parallel {
+
+    /**
+     * @brief Synchronous lazy sequence of values of type @b T, produced with
+     * `co_yield`. Values are computed one at a time, as the generator is
+     * iterated. Like with `Task`, coroutine frame is allocated with
+     * `BaseMemoryTags.Coroutine`.
+     *
+     *  ```cpp
+     *      Generator<uint32> range(uint32 from, uint32 to) {
+     *          for (auto i = from; i < to; i++)
+     *              co_yield i;
+     *      }
+     *      for (auto i : range(0, 10)) { ... }
+     *  ```
+     *
+     * @tparam T Type of produced values
+     */
+    template<typename T>
+    class [[nodiscard]] Generator {
+      public:
+        class promise_type : public __detail__::CoroutinePromiseBase {
+          public:
+            Generator get_return_object() noexcept {
+                return Generator {
+                    std::coroutine_handle<promise_type>::from_promise(*this)
+                };
+            }
+            std::suspend_always initial_suspend() const noexcept { return {}; }
+            std::suspend_always final_suspend() const noexcept { return {}; }
+
+            std::suspend_always yield_value(const T& value) noexcept {
+                _value = std::addressof(value);
+                return {};
+            }
+            std::suspend_always yield_value(T&& value) noexcept {
+                _value = std::addressof(value);
+                return {};
+            }
+            void return_void() const noexcept {}
+            void unhandled_exception() noexcept {
+                _exception = std::current_exception();
+            }
+
+            // Can't await inside of generator
+            template<typename U>
+            std::suspend_never await_transform(U&&) = delete;
+
+          private:
+            const T*           _value = nullptr;
+            std::exception_ptr _exception {};
+
+            friend class Generator;
+        };
+
+        using Handle = std::coroutine_handle<promise_type>;
+
+        /**
+         * @brief Input iterator over generated values. Advancing resumes the
+         * generator until its next `co_yield`.
+         */
+        class Iterator {
+          public:
+            using iterator_category = std::input_iterator_tag;
+            using difference_type   = std::ptrdiff_t;
+            using value_type        = T;
+            using reference         = const T&;
+            using pointer           = const T*;
+
+            Iterator() noexcept = default;
+            explicit Iterator(Handle handle) noexcept : _handle(handle) {}
+
+            Iterator& operator++() {
+                _handle.resume();
+                if (_handle.done()) {
+                    const auto exception = _handle.promise()._exception;
+                    _handle              = nullptr;
+                    if (exception) std::rethrow_exception(exception);
+                }
+                return *this;
+            }
+            void operator++(int) { ++*this; }
+
+            reference operator*() const { return *_handle.promise()._value; }
+            pointer   operator->() const { return _handle.promise()._value; }
+
+            bool operator==(const Iterator& other) const noexcept {
+                return _handle == other._handle;
+            }
+            bool operator!=(const Iterator& other) const noexcept {
+                return _handle != other._handle;
+            }
+
+          private:
+            Handle _handle {};
+        };
+
+        Generator() noexcept = default;
+        explicit Generator(Handle handle) noexcept : _handle(handle) {}
+        Generator(Generator&& other) noexcept
+            : _handle(std::exchange(other._handle, nullptr)) {}
+        Generator& operator=(Generator&& other) noexcept {
+            if (this != &other) {
+                if (_handle) _handle.destroy();
+                _handle = std::exchange(other._handle, nullptr);
+            }
+            return *this;
+        }
+        Generator(const Generator&)            = delete;
+        Generator& operator=(const Generator&) = delete;
+        ~Generator() {
+            if (_handle) _handle.destroy();
+        }
+
+        /**
+         * @brief Start generating. Should be called only once per generator.
+         * @return Iterator Iterator to the first generated value
+         */
+        Iterator begin() {
+            if (!_handle) return end();
+            auto iterator = Iterator { _handle };
+            return ++iterator;
+        }
+        /// @brief Iterator denoting exhausted generator
+        Iterator end() noexcept { return Iterator {}; }
+
+      private:
+        Handle _handle {};
+    };
+
+} // namespace parallel
+
+} // namespace CORE_NAMESPACE
@@ -0,0 +1,298 @@
+/**
+ * @file mpmc_queue.hpp
+ * @author Android172 (android172unity@gmail.com)
+ * @brief Defines bounded lock-free multi producer multi consumer queue.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include "memory/memory_system.hpp"
+#include "notifier.hpp"
+#include "parallel.hpp"
+
+#include <atomic>
+#include <utility>
+
+namespace CORE_NAMESPACE {
+
+namespace parallel {
+
+    /**
+     * @brief Bounded multi producer, multi consumer queue (Dmitry Vyukov's
+     * design). Every cell carries a sequence number, telling producers and
+     * consumers whether the cell is ready for them. Producers (consumers) only
+     * contend on a single CAS of the enqueue (dequeue) position, each of which
+     * is placed on its own cache line. `try_*` operations are lock-free, while
+     * blocking variants sleep on a futex while queue is full (empty).
+     *
+     * @tparam T Element type
+     */
+    template<typename T>
+    class MPMCQueue {
+        static_assert(
+            alignof(T) <= MEMORY_PADDING,
+            "MPMCQueue element alignment exceeds memory system alignment."
+        );
+
+      public:
+        /**
+         * @brief Construct a new MPMCQueue object
+         *
+         * @param capacity Minimum number of elements queue can hold. Rounded
+         * up to the nearest power of two.
+         * @param tag Memory tag used for buffer allocation
+         */
+        explicit MPMCQueue(
+            const uint64 capacity, const MemoryTag tag = BaseMemoryTags.Array
+        ) {
+            uint64 size = 2;
+            while (size < capacity)
+                size <<= 1;
+            _mask = size - 1;
+
+            _cells = (Cell*) ::operator new(sizeof(Cell) * size, tag);
+            for (uint64 i = 0; i < size; i++)
+                new (&_cells[i]) Cell(i);
+        }
+        ~MPMCQueue() {
+            const auto tail = _enqueue_position.load(std::memory_order_acquire);
+            auto       head = _dequeue_position.load(std::memory_order_acquire);
+            for (; head != tail; head++)
+                _cells[head & _mask].value().~T();
+            for (uint64 i = 0; i <= _mask; i++)
+                _cells[i].~Cell();
+            ::operator delete(_cells);
+        }
+
+        MPMCQueue(const MPMCQueue&)            = delete;
+        MPMCQueue& operator=(const MPMCQueue&) = delete;
+
+        /// @brief Maximum number of held elements
+        uint64 capacity() const { return _mask + 1; }
+        /// @brief Approximate number of held elements
+        uint64 size() const {
+            const auto head = _dequeue_position.load(std::memory_order_relaxed);
+            const auto tail = _enqueue_position.load(std::memory_order_relaxed);
+            return tail > head ? tail - head : 0;
+        }
+        /// @brief True if queue (approximately) holds no elements
+        bool   empty() const { return size() == 0; }
+
+        // ---------------------------------------------------------------------
+        // Push
+        // ---------------------------------------------------------------------
+
+        /**
+         * @brief Push element if there is space for it.
+         * @return true If element was pushed
+         * @return false If queue was full
+         */
+        template<typename V>
+        bool try_push(V&& item) {
+            if (!push_one(std::forward<V>(item))) return false;
+            _not_empty.notify_one();
+            return true;
+        }
+        /**
+         * @brief Push as many elements from @p items as there is space for,
+         * with a single notification at the end.
+         *
+         * @param items Array of elements to copy from
+         * @param count Size of @p items
+         * @return uint64 Number of pushed elements
+         */
+        uint64 try_push_batch(const T* const items, const uint64 count) {
+            uint64 n = 0;
+            while (n < count && push_one(items[n]))
+                n++;
+            if (n == 1) _not_empty.notify_one();
+            else if (n > 1) _not_empty.notify_all();
+            return n;
+        }
+
+        /**
+         * @brief Push element, sleeping while queue is full.
+         */
+        template<typename V>
+        void push(V&& item) {
+            T value { std::forward<V>(item) };
+            while (!try_push(std::move(value))) {
+                const auto key = _not_full.prepare_wait();
+                if (try_push(std::move(value))) {
+                    _not_full.cancel_wait();
+                    break;
+                }
+                _not_full.wait(key);
+            }
+        }
+        /**
+         * @brief Push all elements from @p items, sleeping whenever queue is
+         * full.
+         *
+         * @param items Array of elements to copy from
+         * @param count Size of @p items
+         */
+        void push_batch(const T* const items, const uint64 count) {
+            uint64 pushed = 0;
+            while (pushed < count) {
+                pushed += try_push_batch(items + pushed, count - pushed);
+                if (pushed == count) break;
+
+                const auto key = _not_full.prepare_wait();
+                const auto n   = try_push_batch(items + pushed, count - pushed);
+                if (n != 0) {
+                    _not_full.cancel_wait();
+                    pushed += n;
+                    continue;
+                }
+                _not_full.wait(key);
+            }
+        }
+
+        // ---------------------------------------------------------------------
+        // Pop
+        // ---------------------------------------------------------------------
+
+        /**
+         * @brief Pop element if queue isn't empty.
+         * @param out Popped element
+         * @return true If element was popped
+         * @return false If queue was empty
+         */
+        bool try_pop(T& out) {
+            if (!pop_one(out)) return false;
+            _not_full.notify_one();
+            return true;
+        }
+        /**
+         * @brief Pop up to @p max_count elements, with a single notification
+         * at the end.
+         *
+         * @param out Array receiving popped elements
+         * @param max_count Size of @p out
+         * @return uint64 Number of popped elements
+         */
+        uint64 try_pop_batch(T* const out, const uint64 max_count) {
+            uint64 n = 0;
+            while (n < max_count && pop_one(out[n]))
+                n++;
+            if (n == 1) _not_full.notify_one();
+            else if (n > 1) _not_full.notify_all();
+            return n;
+        }
+
+        /**
+         * @brief Pop element, sleeping while queue is empty.
+         * @param out Popped element
+         */
+        void pop(T& out) {
+            while (!try_pop(out)) {
+                const auto key = _not_empty.prepare_wait();
+                if (try_pop(out)) {
+                    _not_empty.cancel_wait();
+                    break;
+                }
+                _not_empty.wait(key);
+            }
+        }
+        /**
+         * @brief Pop up to @p max_count elements, sleeping until at least one
+         * is available.
+         *
+         * @param out Array receiving popped elements
+         * @param max_count Size of @p out
+         * @return uint64 Number of popped elements
+         */
+        uint64 pop_batch(T* const out, const uint64 max_count) {
+            while (true) {
+                auto n = try_pop_batch(out, max_count);
+                if (n != 0) return n;
+
+                const auto key = _not_empty.prepare_wait();
+                n              = try_pop_batch(out, max_count);
+                if (n != 0) {
+                    _not_empty.cancel_wait();
+                    return n;
+                }
+                _not_empty.wait(key);
+            }
+        }
+
+      private:
+        struct Cell {
+            std::atomic<uint64> sequence;
+            alignas(T) byte storage[sizeof(T)];
+
+            Cell(const uint64 initial_sequence) : sequence(initial_sequence) {}
+
+            T& value() { return *reinterpret_cast<T*>(storage); }
+        };
+
+        alignas(cache_line_size) std::atomic<uint64> _enqueue_position { 0 };
+        Notifier _not_full {};
+
+        alignas(cache_line_size) std::atomic<uint64> _dequeue_position { 0 };
+        Notifier _not_empty {};
+
+        alignas(cache_line_size) Cell* _cells;
+        uint64 _mask;
+
+        template<typename V>
+        bool push_one(V&& item) {
+            auto  position = _enqueue_position.load(std::memory_order_relaxed);
+            Cell* cell;
+            while (true) {
+                cell = &_cells[position & _mask];
+                const auto sequence =
+                    cell->sequence.load(std::memory_order_acquire);
+                const auto diff = (int64) sequence - (int64) position;
+
+                if (diff == 0) {
+                    if (_enqueue_position.compare_exchange_weak(
+                            position, position + 1, std::memory_order_relaxed
+                        ))
+                        break;
+                } else if (diff < 0) return false; // Full
+                else position = _enqueue_position.load(std::memory_order_relaxed);
+            }
+
+            new (cell->storage) T(std::forward<V>(item));
+            cell->sequence.store(position + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool pop_one(T& out) {
+            auto  position = _dequeue_position.load(std::memory_order_relaxed);
+            Cell* cell;
+            while (true) {
+                cell = &_cells[position & _mask];
+                const auto sequence =
+                    cell->sequence.load(std::memory_order_acquire);
+                const auto diff = (int64) sequence - (int64) (position + 1);
+
+                if (diff == 0) {
+                    if (_dequeue_position.compare_exchange_weak(
+                            position, position + 1, std::memory_order_relaxed
+                        ))
+                        break;
+                } else if (diff < 0) return false; // Empty
+                else position = _dequeue_position.load(std::memory_order_relaxed);
+            }
+
+            out = std::move(cell->value());
+            cell->value().~T();
+            cell->sequence.store(
+                position + _mask + 1, std::memory_order_release
+            );
+            return true;
+        }
+    };
+
+} // namespace parallel
+
+} // namespace CORE_NAMESPACE
@@ -0,0 +1,110 @@
+/**
+ * @file notifier.hpp
+ * @author Android172 (android172unity@gmail.com)
+ * @brief Defines futex based notifier, used for building blocking waits on top
+ * of lock-free data structures.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include "platform/platform.hpp"
+
+#include <atomic>
+
+namespace CORE_NAMESPACE {
+
+namespace parallel {
+
+    /**
+     * @brief Lets threads sleep until some lock-free condition becomes true,
+     * without any lock on the notifying side (aka event count). Notifying
+     * costs only a fence and a load while nobody waits. Waiting is done in two
+     * phases, to avoid missed wake ups:
+     *
+     *  ```cpp
+     *      while (!try_pop(item)) {
+     *          const auto key = notifier.prepare_wait();
+     *          if (try_pop(item)) {
+     *              notifier.cancel_wait();
+     *              break;
+     *          }
+     *          notifier.wait(key);
+     *      }
+     *  ```
+     */
+    class Notifier {
+      public:
+        Notifier() {}
+        ~Notifier() {}
+
+        Notifier(const Notifier&)            = delete;
+        Notifier& operator=(const Notifier&) = delete;
+
+        /**
+         * @brief Announce intent to wait. Condition must be rechecked after
+         * this call, followed by either `cancel_wait` or `wait`.
+         * @return uint32 Key to be passed to `wait`
+         */
+        uint32 prepare_wait() {
+            _waiters.fetch_add(1, std::memory_order_seq_cst);
+            return _epoch.load(std::memory_order_seq_cst);
+        }
+        /**
+         * @brief Abort wait announced with `prepare_wait`.
+         */
+        void cancel_wait() {
+            _waiters.fetch_sub(1, std::memory_order_relaxed);
+        }
+        /**
+         * @brief Sleep until notified. Returns immediately if notification
+         * happened since matching `prepare_wait` call.
+         *
+         * @param key Key returned by `prepare_wait`
+         * @param timeout_ms Maximum time to wait in miliseconds
+         * @return false If timeout expired, true otherwise
+         */
+        bool wait(const uint32 key, const uint64 timeout_ms = uint64_max) {
+            bool woken = true;
+            if (_epoch.load(std::memory_order_acquire) == key)
+                woken = platform::futex_wait(&_epoch, key, timeout_ms);
+            _waiters.fetch_sub(1, std::memory_order_relaxed);
+            return woken;
+        }
+
+        /**
+         * @brief Wake up one waiting thread (if any).
+         */
+        void notify_one() {
+            if (!has_waiters()) return;
+            _epoch.fetch_add(1, std::memory_order_seq_cst);
+            platform::futex_wake_one(&_epoch);
+        }
+        /**
+         * @brief Wake up all waiting threads (if any).
+         */
+        void notify_all() {
+            if (!has_waiters()) return;
+            _epoch.fetch_add(1, std::memory_order_seq_cst);
+            platform::futex_wake_all(&_epoch);
+        }
+
+      private:
+        std::atomic<uint32> _epoch { 0 };
+        std::atomic<uint32> _waiters { 0 };
+
+        bool has_waiters() {
+            // Orders caller's preceding writes before the waiter check.
+            // Pairs with seq_cst increment in prepare_wait.
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            return _waiters.load(std::memory_order_relaxed) != 0;
+        }
+    };
+
+} // namespace parallel
+
+} // namespace CORE_NAMESPACE
@@ -12,6 +12,10 @@
 
 #pragma once
 
+#include "common/types.hpp"
+
+// Must precede `for_each` macro definition bellow
+#include <algorithm>
 #include <functional>
 #include <mutex>
 
@@ -22,6 +26,12 @@ namespace CORE_NAMESPACE {
  * execution of code.
  */
 namespace parallel {
+    /**
+     * @brief Assumed size of a CPU cache line. Data written by different
+     * threads should be at least this far apart to avoid false sharing.
+     */
+    inline const constexpr uint64 cache_line_size = 64;
+
     // -------------------------------------------------------------------------
     // Mutex
     // -------------------------------------------------------------------------
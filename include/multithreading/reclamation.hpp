@@ -0,0 +1,215 @@
+/**
+ * @file reclamation.hpp
+ * @author Android172 (android172unity@gmail.com)
+ * @brief Defines safe memory reclamation schemes (epoch based reclamation and
+ * hazard pointers) for lock-free data structures.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include "memory/memory_system.hpp"
+#include "parallel.hpp"
+
+#include <atomic>
+
+namespace CORE_NAMESPACE {
+
+namespace parallel {
+
+    namespace __detail__ {
+        // Object waiting to be freed
+        struct RetiredObject {
+            void* pointer;
+            void (*deleter)(void*);
+            uint64 epoch;
+        };
+
+        template<typename T>
+        void delete_retired(void* pointer) {
+            // Returns memory to the allocator of its memory tag
+            del((T*) pointer);
+        }
+    } // namespace __detail__
+
+    // -------------------------------------------------------------------------
+    // Epoch based reclamation
+    // -------------------------------------------------------------------------
+
+    /**
+     * @brief Epoch based memory reclamation (EBR). Readers of a lock-free
+     * structure wrap their accesses in a critical region (see `EpochGuard`).
+     * Writers unlink objects and `retire` them instead of deleting. Retired
+     * object is freed only after every thread which was inside a critical
+     * region at the time of retirement has left it, so no reader can still see
+     * it.
+     *
+     * Entering and exiting a region costs a store and a fence on thread local
+     * data. Reclamation is amortized over retirements. Note that a thread
+     * stuck inside a critical region blocks all reclamation; use
+     * `HazardPointer` where that matters.
+     */
+    class EpochReclamation {
+      public:
+        EpochReclamation()  = delete;
+        ~EpochReclamation() = delete;
+
+        /// @brief Enter critical region. Regions can be nested.
+        static void enter();
+        /// @brief Exit critical region
+        static void exit();
+        /// @brief True if calling thread is inside a critical region
+        static bool in_critical_region();
+
+        /**
+         * @brief Schedule object for deletion, once no reader can access it.
+         * Object must already be unreachable for new readers. It is deleted
+         * with `del`, returning memory to the allocator of its memory tag.
+         *
+         * @param pointer Object to delete
+         */
+        template<typename T>
+        static void retire(T* const pointer) {
+            retire(pointer, __detail__::delete_retired<T>);
+        }
+        /**
+         * @brief Schedule deletion with custom deleter, once no reader can
+         * access @p pointer.
+         *
+         * @param pointer Memory to free
+         * @param deleter Function freeing it
+         */
+        static void retire(void* pointer, void (*deleter)(void*));
+
+        /**
+         * @brief Try to advance global epoch and free everything retired by
+         * calling thread (and exited threads) that became safe to free.
+         */
+        static void collect();
+        /**
+         * @brief Wait until all currently retired objects can be freed and
+         * free them. Must not be called from inside of a critical region.
+         */
+        static void synchronize();
+    };
+
+    /**
+     * @brief RAII epoch critical region. Pointers read from a lock-free
+     * structure stay valid for the lifetime of the guard.
+     *
+     *  ```cpp
+     *      {
+     *          EpochGuard guard {};
+     *          auto node = head.load(std::memory_order_acquire);
+     *          // ... node can be safely dereferenced here
+     *      }
+     *  ```
+     */
+    class EpochGuard {
+      public:
+        EpochGuard() { EpochReclamation::enter(); }
+        ~EpochGuard() { EpochReclamation::exit(); }
+
+        EpochGuard(const EpochGuard&)            = delete;
+        EpochGuard& operator=(const EpochGuard&) = delete;
+    };
+
+    // -------------------------------------------------------------------------
+    // Hazard pointers
+    // -------------------------------------------------------------------------
+
+    namespace __detail__ {
+        struct HazardRecord {
+            alignas(cache_line_size) std::atomic<void*> pointer { nullptr };
+            std::atomic<bool> in_use { false };
+            HazardRecord*     next = nullptr;
+        };
+    } // namespace __detail__
+
+    /**
+     * @brief Hazard pointer. Publishes a single pointer as in use by calling
+     * thread, preventing its reclamation. Unlike epochs, a slow reader only
+     * holds back objects it actually protects, so memory use stays bounded.
+     * Protection costs a store and a full fence per protected pointer.
+     *
+     *  ```cpp
+     *      HazardPointer hazard {};
+     *      auto node = hazard.protect(head);
+     *      // ... node can be safely dereferenced until reset
+     *      hazard.reset();
+     *  ```
+     */
+    class HazardPointer {
+      public:
+        HazardPointer();
+        ~HazardPointer();
+
+        HazardPointer(const HazardPointer&)            = delete;
+        HazardPointer& operator=(const HazardPointer&) = delete;
+
+        /**
+         * @brief Load pointer from @p source and protect it. Retries until
+         * protected value is confirmed to still be stored in @p source.
+         *
+         * @param source Atomic holding the pointer
+         * @return T* Protected pointer
+         */
+        template<typename T>
+        T* protect(const std::atomic<T*>& source) {
+            auto pointer = source.load(std::memory_order_relaxed);
+            while (true) {
+                set(pointer);
+                const auto current = source.load(std::memory_order_acquire);
+                if (current == pointer) return pointer;
+                pointer = current;
+            }
+        }
+        /// @brief Protect given pointer. Caller must validate it is still
+        /// reachable afterwards.
+        void set(const void* const pointer) {
+            _record->pointer.store(
+                (void*) pointer, std::memory_order_relaxed
+            );
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+        /// @brief Stop protecting current pointer
+        void reset() {
+            _record->pointer.store(nullptr, std::memory_order_release);
+        }
+
+        /**
+         * @brief Schedule object for deletion, once no hazard pointer
+         * protects it. Object is deleted with `del`, returning memory to the
+         * allocator of its memory tag.
+         *
+         * @param pointer Object to delete
+         */
+        template<typename T>
+        static void retire(T* const pointer) {
+            retire(pointer, __detail__::delete_retired<T>);
+        }
+        /**
+         * @brief Schedule deletion with custom deleter, once no hazard pointer
+         * protects @p pointer.
+         *
+         * @param pointer Memory to free
+         * @param deleter Function freeing it
+         */
+        static void retire(void* pointer, void (*deleter)(void*));
+        /**
+         * @brief Free all objects retired by calling thread (and exited
+         * threads) which aren't protected.
+         */
+        static void collect();
+
+      private:
+        __detail__::HazardRecord* _record;
+    };
+
+} // namespace parallel
+
+} // namespace CORE_NAMESPACE
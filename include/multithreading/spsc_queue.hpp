@@ -0,0 +1,270 @@
+/**
+ * @file spsc_queue.hpp
+ * @author Android172 (android172unity@gmail.com)
+ * @brief Defines bounded wait-free single producer single consumer queue.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include "memory/memory_system.hpp"
+#include "notifier.hpp"
+#include "parallel.hpp"
+
+#include <atomic>
+#include <utility>
+
+namespace CORE_NAMESPACE {
+
+namespace parallel {
+
+    /**
+     * @brief Bounded single producer, single consumer ring buffer. All `try_*`
+     * operations are wait-free. Blocking variants sleep on a futex while queue
+     * is full (empty). Exactly one thread may push and exactly one (other)
+     * thread may pop at any given time.
+     *
+     * Producer and consumer indices live on separate cache lines. Each side
+     * additionally caches the other side's index, so shared lines are only
+     * touched when the cached value runs out.
+     *
+     * @tparam T Element type
+     */
+    template<typename T>
+    class SPSCQueue {
+        static_assert(
+            alignof(T) <= MEMORY_PADDING,
+            "SPSCQueue element alignment exceeds memory system alignment."
+        );
+
+      public:
+        /**
+         * @brief Construct a new SPSCQueue object
+         *
+         * @param capacity Minimum number of elements queue can hold. Rounded
+         * up to the nearest power of two.
+         * @param tag Memory tag used for buffer allocation
+         */
+        explicit SPSCQueue(
+            const uint64 capacity, const MemoryTag tag = BaseMemoryTags.Array
+        ) {
+            uint64 size = 2;
+            while (size < capacity)
+                size <<= 1;
+            _mask   = size - 1;
+            _buffer = (T*) ::operator new(sizeof(T) * size, tag);
+        }
+        ~SPSCQueue() {
+            const auto tail = _tail.load(std::memory_order_acquire);
+            for (auto i = _head.load(std::memory_order_acquire); i != tail; i++)
+                _buffer[i & _mask].~T();
+            ::operator delete(_buffer);
+        }
+
+        SPSCQueue(const SPSCQueue&)            = delete;
+        SPSCQueue& operator=(const SPSCQueue&) = delete;
+
+        /// @brief Maximum number of held elements
+        uint64 capacity() const { return _mask + 1; }
+        /// @brief Number of held elements. Exact only if called from producer
+        /// or consumer thread while the other side is idle.
+        uint64 size() const {
+            return _tail.load(std::memory_order_acquire) -
+                   _head.load(std::memory_order_acquire);
+        }
+        /// @brief True if queue holds no elements (see `size`)
+        bool   empty() const { return size() == 0; }
+
+        // ---------------------------------------------------------------------
+        // Producer side
+        // ---------------------------------------------------------------------
+
+        /**
+         * @brief Push element if there is space for it.
+         * @return true If element was pushed
+         * @return false If queue was full
+         */
+        template<typename V>
+        bool try_push(V&& item) {
+            const auto tail = _tail.load(std::memory_order_relaxed);
+            if (tail - _cached_head > _mask) {
+                _cached_head = _head.load(std::memory_order_acquire);
+                if (tail - _cached_head > _mask) return false;
+            }
+            new (&_buffer[tail & _mask]) T(std::forward<V>(item));
+            _tail.store(tail + 1, std::memory_order_release);
+            _not_empty.notify_one();
+            return true;
+        }
+        /**
+         * @brief Push as many elements from @p items as there is space for.
+         * Elements are published together, with a single notification.
+         *
+         * @param items Array of elements to copy from
+         * @param count Size of @p items
+         * @return uint64 Number of pushed elements
+         */
+        uint64 try_push_batch(const T* const items, const uint64 count) {
+            const auto tail = _tail.load(std::memory_order_relaxed);
+            if (tail - _cached_head + count > capacity())
+                _cached_head = _head.load(std::memory_order_acquire);
+
+            const auto free = capacity() - (tail - _cached_head);
+            const auto n    = count < free ? count : free;
+            if (n == 0) return 0;
+
+            for (uint64 i = 0; i < n; i++)
+                new (&_buffer[(tail + i) & _mask]) T(items[i]);
+            _tail.store(tail + n, std::memory_order_release);
+            _not_empty.notify_one();
+            return n;
+        }
+
+        /**
+         * @brief Push element, sleeping while queue is full.
+         */
+        template<typename V>
+        void push(V&& item) {
+            T value { std::forward<V>(item) };
+            while (!try_push(std::move(value))) {
+                const auto key = _not_full.prepare_wait();
+                if (try_push(std::move(value))) {
+                    _not_full.cancel_wait();
+                    break;
+                }
+                _not_full.wait(key);
+            }
+        }
+        /**
+         * @brief Push all elements from @p items, sleeping whenever queue is
+         * full.
+         *
+         * @param items Array of elements to copy from
+         * @param count Size of @p items
+         */
+        void push_batch(const T* const items, const uint64 count) {
+            uint64 pushed = 0;
+            while (pushed < count) {
+                pushed += try_push_batch(items + pushed, count - pushed);
+                if (pushed == count) break;
+
+                const auto key = _not_full.prepare_wait();
+                const auto n   = try_push_batch(items + pushed, count - pushed);
+                if (n != 0) {
+                    _not_full.cancel_wait();
+                    pushed += n;
+                    continue;
+                }
+                _not_full.wait(key);
+            }
+        }
+
+        // ---------------------------------------------------------------------
+        // Consumer side
+        // ---------------------------------------------------------------------
+
+        /**
+         * @brief Pop element if queue isn't empty.
+         * @param out Popped element
+         * @return true If element was popped
+         * @return false If queue was empty
+         */
+        bool try_pop(T& out) {
+            const auto head = _head.load(std::memory_order_relaxed);
+            if (head == _cached_tail) {
+                _cached_tail = _tail.load(std::memory_order_acquire);
+                if (head == _cached_tail) return false;
+            }
+            auto& slot = _buffer[head & _mask];
+            out        = std::move(slot);
+            slot.~T();
+            _head.store(head + 1, std::memory_order_release);
+            _not_full.notify_one();
+            return true;
+        }
+        /**
+         * @brief Pop up to @p max_count elements at once.
+         *
+         * @param out Array receiving popped elements
+         * @param max_count Size of @p out
+         * @return uint64 Number of popped elements
+         */
+        uint64 try_pop_batch(T* const out, const uint64 max_count) {
+            const auto head = _head.load(std::memory_order_relaxed);
+            if (_cached_tail - head < max_count)
+                _cached_tail = _tail.load(std::memory_order_acquire);
+
+            const auto available = _cached_tail - head;
+            const auto n = max_count < available ? max_count : available;
+            if (n == 0) return 0;
+
+            for (uint64 i = 0; i < n; i++) {
+                auto& slot = _buffer[(head + i) & _mask];
+                out[i]     = std::move(slot);
+                slot.~T();
+            }
+            _head.store(head + n, std::memory_order_release);
+            _not_full.notify_one();
+            return n;
+        }
+
+        /**
+         * @brief Pop element, sleeping while queue is empty.
+         * @param out Popped element
+         */
+        void pop(T& out) {
+            while (!try_pop(out)) {
+                const auto key = _not_empty.prepare_wait();
+                if (try_pop(out)) {
+                    _not_empty.cancel_wait();
+                    break;
+                }
+                _not_empty.wait(key);
+            }
+        }
+        /**
+         * @brief Pop up to @p max_count elements, sleeping until at least one
+         * is available.
+         *
+         * @param out Array receiving popped elements
+         * @param max_count Size of @p out
+         * @return uint64 Number of popped elements
+         */
+        uint64 pop_batch(T* const out, const uint64 max_count) {
+            while (true) {
+                auto n = try_pop_batch(out, max_count);
+                if (n != 0) return n;
+
+                const auto key = _not_empty.prepare_wait();
+                n              = try_pop_batch(out, max_count);
+                if (n != 0) {
+                    _not_empty.cancel_wait();
+                    return n;
+                }
+                _not_empty.wait(key);
+            }
+        }
+
+      private:
+        // Consumer owned
+        alignas(cache_line_size) std::atomic<uint64> _head { 0 };
+        uint64   _cached_tail = 0;
+        Notifier _not_full {};
+
+        // Producer owned
+        alignas(cache_line_size) std::atomic<uint64> _tail { 0 };
+        uint64   _cached_head = 0;
+        Notifier _not_empty {};
+
+        // Shared, read only
+        alignas(cache_line_size) T* _buffer;
+        uint64 _mask;
+    };
+
+} // namespace parallel
+
+} // namespace CORE_NAMESPACE
@@ -0,0 +1,561 @@
+/**
+ * @file synchronization.hpp
+ * @author Android172 (android172unity@gmail.com)
+ * @brief Defines low level synchronization primitives (locks, semaphores,
+ * latches, barriers and conditions) built directly on futexes.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include "parallel.hpp"
+#include "platform/platform.hpp"
+
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) ||            \
+    defined(_M_IX86)
+#    include <immintrin.h>
+#endif
+
+namespace CORE_NAMESPACE {
+
+namespace parallel {
+
+    /**
+     * @brief Hint to the CPU that calling thread is busy waiting. Lowers power
+     * usage and frees resources for the sibling hyper-thread.
+     */
+    inline void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) ||            \
+    defined(_M_IX86)
+        _mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+        asm volatile("yield");
+#else
+        std::this_thread::yield();
+#endif
+    }
+
+    // -------------------------------------------------------------------------
+    // Spin lock
+    // -------------------------------------------------------------------------
+
+    /**
+     * @brief Adaptive spin lock. Spins (with exponential backoff) for a short
+     * while when lock is taken, after which thread is put to sleep on a futex.
+     * Best suited for short critical sections under low contention (ex.
+     * allocator bookkeeping). Satisfies `Lockable`, so it can be used with
+     * `std::lock_guard` and `std::unique_lock`.
+     */
+    class alignas(cache_line_size) SpinLock {
+      public:
+        constexpr SpinLock() {}
+        ~SpinLock() {}
+
+        SpinLock(const SpinLock&)            = delete;
+        SpinLock& operator=(const SpinLock&) = delete;
+
+        void lock() {
+            uint32 expected = Unlocked;
+            if (_state.compare_exchange_weak(
+                    expected, Locked, std::memory_order_acquire
+                ))
+                return;
+            lock_slow();
+        }
+        bool try_lock() {
+            uint32 expected = Unlocked;
+            return _state.compare_exchange_strong(
+                expected, Locked, std::memory_order_acquire
+            );
+        }
+        void unlock() {
+            if (_state.exchange(Unlocked, std::memory_order_release) ==
+                Contended)
+                platform::futex_wake_one(&_state);
+        }
+
+      private:
+        enum : uint32 { Unlocked = 0, Locked = 1, Contended = 2 };
+
+        std::atomic<uint32> _state { Unlocked };
+
+        void lock_slow();
+    };
+
+    // -------------------------------------------------------------------------
+    // Reader-writer lock
+    // -------------------------------------------------------------------------
+
+    /**
+     * @brief Reader-writer lock optimized for read heavy use. Uncontended
+     * `lock_shared` / `unlock_shared` cost a single atomic operation. Waiting
+     * writers block new readers, so writers aren't starved. Satisfies
+     * `SharedLockable`, so it can be used with `std::shared_lock`.
+     */
+    class alignas(cache_line_size) RWLock {
+      public:
+        constexpr RWLock() {}
+        ~RWLock() {}
+
+        RWLock(const RWLock&)            = delete;
+        RWLock& operator=(const RWLock&) = delete;
+
+        /// @brief Acquire exclusive (write) access
+        void lock() {
+            uint32 expected = 0;
+            if (_state.compare_exchange_weak(
+                    expected, Writer, std::memory_order_acquire
+                ))
+                return;
+            lock_slow();
+        }
+        /// @brief Try to acquire exclusive (write) access without waiting
+        bool try_lock() {
+            uint32 expected = 0;
+            return _state.compare_exchange_strong(
+                expected, Writer, std::memory_order_acquire
+            );
+        }
+        /// @brief Release exclusive (write) access
+        void unlock() {
+            const auto previous =
+                _state.fetch_and(~(Writer | Parked), std::memory_order_release);
+            if (previous & Parked) platform::futex_wake_all(&_state);
+        }
+
+        /// @brief Acquire shared (read) access
+        void lock_shared() {
+            auto state = _state.load(std::memory_order_relaxed);
+            if ((state & (Writer | WriterWaiting)) == 0 &&
+                _state.compare_exchange_weak(
+                    state, state + 1, std::memory_order_acquire
+                ))
+                return;
+            lock_shared_slow();
+        }
+        /// @brief Try to acquire shared (read) access without waiting
+        bool try_lock_shared() {
+            auto state = _state.load(std::memory_order_relaxed);
+            while ((state & (Writer | WriterWaiting)) == 0)
+                if (_state.compare_exchange_weak(
+                        state, state + 1, std::memory_order_acquire
+                    ))
+                    return true;
+            return false;
+        }
+        /// @brief Release shared (read) access
+        void unlock_shared() {
+            const auto previous =
+                _state.fetch_sub(1, std::memory_order_release);
+            // Last reader out wakes waiting writer
+            if ((previous & ReaderMask) == 1 && (previous & Parked)) {
+                _state.fetch_and(~Parked, std::memory_order_relaxed);
+                platform::futex_wake_all(&_state);
+            }
+        }
+
+      private:
+        enum : uint32 {
+            Writer        = 1u << 31,
+            WriterWaiting = 1u << 30,
+            Parked        = 1u << 29,
+            ReaderMask    = Parked - 1
+        };
+
+        std::atomic<uint32> _state { 0 };
+
+        void lock_slow();
+        void lock_shared_slow();
+    };
+
+    // -------------------------------------------------------------------------
+    // Sequence lock
+    // -------------------------------------------------------------------------
+
+    /**
+     * @brief Sequence lock, for small snapshot data that is read often and
+     * written rarely. Readers never block writers nor write to shared memory;
+     * they simply retry if a write happened while reading.
+     *
+     * @tparam T Trivially copyable value type
+     */
+    template<typename T>
+    class alignas(cache_line_size) SeqLock {
+        static_assert(
+            std::is_trivially_copyable_v<T>,
+            "SeqLock requires trivially copyable value type."
+        );
+
+      public:
+        SeqLock() : SeqLock(T {}) {}
+        explicit SeqLock(const T& value) { store_words(value); }
+
+        SeqLock(const SeqLock&)            = delete;
+        SeqLock& operator=(const SeqLock&) = delete;
+
+        /// @brief Read consistent snapshot of the value
+        T load() const {
+            while (true) {
+                const auto sequence = _sequence.load(std::memory_order_acquire);
+                if (sequence & 1) {
+                    cpu_relax();
+                    continue;
+                }
+
+                uint64 words[word_count];
+                for (uint64 i = 0; i < word_count; i++)
+                    words[i] = _words[i].load(std::memory_order_relaxed);
+
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (_sequence.load(std::memory_order_relaxed) == sequence) {
+                    T value;
+                    std::memcpy(&value, words, sizeof(T));
+                    return value;
+                }
+            }
+        }
+        /// @brief Overwrite the value. Concurrent writers are serialized.
+        void store(const T& value) {
+            auto sequence = _sequence.load(std::memory_order_relaxed);
+            while (true) {
+                if ((sequence & 1) == 0 &&
+                    _sequence.compare_exchange_weak(
+                        sequence, sequence + 1, std::memory_order_relaxed
+                    ))
+                    break;
+                cpu_relax();
+                sequence = _sequence.load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_release);
+            store_words(value);
+            _sequence.store(sequence + 2, std::memory_order_release);
+        }
+
+      private:
+        static constexpr uint64 word_count = (sizeof(T) + 7) / 8;
+
+        std::atomic<uint32> _sequence { 0 };
+        std::atomic<uint64> _words[word_count] {};
+
+        void store_words(const T& value) {
+            uint64 words[word_count] {};
+            std::memcpy(words, &value, sizeof(T));
+            for (uint64 i = 0; i < word_count; i++)
+                _words[i].store(words[i], std::memory_order_relaxed);
+        }
+    };
+
+    // -------------------------------------------------------------------------
+    // Semaphore
+    // -------------------------------------------------------------------------
+
+    /**
+     * @brief Counting semaphore. Acquiring decrements the counter, sleeping
+     * while it is zero. Releasing increments it, waking sleepers if any.
+     */
+    class alignas(cache_line_size) Semaphore {
+      public:
+        explicit Semaphore(const uint32 initial_count = 0)
+            : _count(initial_count) {}
+        ~Semaphore() {}
+
+        Semaphore(const Semaphore&)            = delete;
+        Semaphore& operator=(const Semaphore&) = delete;
+
+        /// @brief Decrement counter, sleeping while it is zero
+        void acquire() { try_acquire_for(uint64_max); }
+        /// @brief Decrement counter if it is above zero
+        /// @return true If counter was decremented
+        bool try_acquire() {
+            auto count = _count.load(std::memory_order_relaxed);
+            while (count != 0)
+                if (_count.compare_exchange_weak(
+                        count, count - 1, std::memory_order_acquire
+                    ))
+                    return true;
+            return false;
+        }
+        /**
+         * @brief Decrement counter, sleeping at most @p timeout_ms while it is
+         * zero.
+         * @return true If counter was decremented
+         * @return false If timeout expired
+         */
+        bool try_acquire_for(const uint64 timeout_ms) {
+            while (!try_acquire()) {
+                _waiters.fetch_add(1, std::memory_order_seq_cst);
+                const auto woken =
+                    platform::futex_wait(&_count, 0, timeout_ms);
+                _waiters.fetch_sub(1, std::memory_order_relaxed);
+                if (!woken) return try_acquire();
+            }
+            return true;
+        }
+
+        /// @brief Increment counter by @p count, waking sleepers if any
+        void release(const uint32 count = 1) {
+            _count.fetch_add(count, std::memory_order_seq_cst);
+            if (_waiters.load(std::memory_order_seq_cst) == 0) return;
+            if (count == 1) platform::futex_wake_one(&_count);
+            else platform::futex_wake_all(&_count);
+        }
+
+      private:
+        std::atomic<uint32> _count;
+        std::atomic<uint32> _waiters { 0 };
+    };
+
+    // -------------------------------------------------------------------------
+    // Latch
+    // -------------------------------------------------------------------------
+
+    /**
+     * @brief Single use countdown. Threads waiting on the latch are released
+     * once its counter reaches zero.
+     */
+    class alignas(cache_line_size) Latch {
+      public:
+        explicit Latch(const uint64 count)
+            : _count(count), _released(count == 0) {}
+        ~Latch() {}
+
+        Latch(const Latch&)            = delete;
+        Latch& operator=(const Latch&) = delete;
+
+        /// @brief Decrement counter by @p n without waiting
+        void count_down(const uint64 n = 1) {
+            if (_count.fetch_sub(n, std::memory_order_acq_rel) != n) return;
+            _released.store(1, std::memory_order_release);
+            platform::futex_wake_all(&_released);
+        }
+        /// @brief True if counter reached zero
+        bool try_wait() const {
+            return _released.load(std::memory_order_acquire) != 0;
+        }
+        /// @brief Sleep until counter reaches zero
+        void wait() {
+            while (_released.load(std::memory_order_acquire) == 0)
+                platform::futex_wait(&_released, 0);
+        }
+        /// @brief Decrement counter by @p n and wait for it to reach zero
+        void arrive_and_wait(const uint64 n = 1) {
+            count_down(n);
+            wait();
+        }
+
+      private:
+        // Counter is 64 bit, while futex waits on a 32 bit word, so sleepers
+        // wait on a separate release flag
+        std::atomic<uint64> _count;
+        std::atomic<uint32> _released;
+    };
+
+    // -------------------------------------------------------------------------
+    // Barrier
+    // -------------------------------------------------------------------------
+
+    /**
+     * @brief Reusable thread barrier. Each phase completes once all
+     * participating threads arrive, after which the barrier resets itself.
+     */
+    class alignas(cache_line_size) Barrier {
+      public:
+        explicit Barrier(const uint32 thread_count)
+            : _thread_count(thread_count), _remaining(thread_count) {}
+        ~Barrier() {}
+
+        Barrier(const Barrier&)            = delete;
+        Barrier& operator=(const Barrier&) = delete;
+
+        /// @brief Arrive at the barrier and wait for the current phase to
+        /// complete
+        void arrive_and_wait() {
+            const auto phase = _phase.load(std::memory_order_acquire);
+            if (_remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                _remaining.store(_thread_count, std::memory_order_relaxed);
+                _phase.fetch_add(1, std::memory_order_release);
+                platform::futex_wake_all(&_phase);
+                return;
+            }
+            while (_phase.load(std::memory_order_acquire) == phase)
+                platform::futex_wait(&_phase, phase);
+        }
+
+      private:
+        const uint32        _thread_count;
+        std::atomic<uint32> _remaining;
+        std::atomic<uint32> _phase { 0 };
+    };
+
+    // -------------------------------------------------------------------------
+    // Parking lot
+    // -------------------------------------------------------------------------
+
+    /**
+     * @brief Global table of wait queues, keyed by address. Lets any object
+     * put threads to sleep without owning a wait queue itself, so primitives
+     * built on it (ex. `Condition`) can be as small as a single byte.
+     */
+    class ParkingLot {
+      public:
+        ParkingLot()  = delete;
+        ~ParkingLot() = delete;
+
+        /**
+         * @brief Put calling thread to sleep in queue of @p key.
+         *
+         * @param key Address identifying the wait queue
+         * @param validate Called under queue lock before parking. Thread
+         * doesn't park if it returns false.
+         * @param before_sleep Called after thread was queued, but before it
+         * sleeps (ex. to release user lock)
+         * @param timeout_ms Maximum time to sleep in miliseconds
+         * @return true If thread was unparked
+         * @return false If validation failed or timeout expired
+         */
+        template<typename Validate, typename BeforeSleep>
+        static bool park(
+            const void*   key,
+            Validate&&    validate,
+            BeforeSleep&& before_sleep,
+            const uint64  timeout_ms = uint64_max
+        ) {
+            return park(
+                key,
+                [](void* context) { return (*(Validate*) context)(); },
+                &validate,
+                [](void* context) { (*(BeforeSleep*) context)(); },
+                &before_sleep,
+                timeout_ms
+            );
+        }
+
+        /**
+         * @brief Wake one thread sleeping in queue of @p key.
+         *
+         * @param key Address identifying the wait queue
+         * @param callback Called under queue lock with information whether
+         * more threads remain parked
+         * @return true If a thread was woken
+         */
+        template<typename Callback>
+        static bool unpark_one(const void* key, Callback&& callback) {
+            return unpark_one(
+                key,
+                [](void* context, bool has_more) {
+                    (*(Callback*) context)(has_more);
+                },
+                &callback
+            );
+        }
+        /**
+         * @brief Wake all threads sleeping in queue of @p key.
+         * @param key Address identifying the wait queue
+         * @return uint64 Number of woken threads
+         */
+        static uint64 unpark_all(const void* key);
+
+      private:
+        static bool park(
+            const void* key,
+            bool (*validate)(void*),
+            void* validate_context,
+            void (*before_sleep)(void*),
+            void*  before_sleep_context,
+            uint64 timeout_ms
+        );
+        static bool unpark_one(
+            const void* key, void (*callback)(void*, bool), void* context
+        );
+    };
+
+    // -------------------------------------------------------------------------
+    // Condition
+    // -------------------------------------------------------------------------
+
+    /**
+     * @brief Condition variable working with any lock type (`Mutex`,
+     * `SpinLock`, `RWLock`, ...). Waiters are queued in the `ParkingLot`, so
+     * condition itself takes only a single byte.
+     */
+    class Condition {
+      public:
+        Condition() {}
+        ~Condition() {}
+
+        Condition(const Condition&)            = delete;
+        Condition& operator=(const Condition&) = delete;
+
+        /**
+         * @brief Atomically release @p lock and sleep until notified. Lock is
+         * reacquired before returning. May wake spuriously.
+         *
+         * @param lock Held lock
+         */
+        template<typename Lock>
+        void wait(Lock& lock) {
+            wait_for(lock, uint64_max);
+        }
+        /**
+         * @brief Same as `wait`, but sleeps at most @p timeout_ms.
+         *
+         * @param lock Held lock
+         * @param timeout_ms Maximum time to sleep in miliseconds
+         * @return false If timeout expired, true otherwise
+         */
+        template<typename Lock>
+        bool wait_for(Lock& lock, const uint64 timeout_ms) {
+            const auto woken = ParkingLot::park(
+                this,
+                [this]() {
+                    _has_waiters.store(true, std::memory_order_relaxed);
+                    return true;
+                },
+                [&lock]() { lock.unlock(); },
+                timeout_ms
+            );
+            lock.lock();
+            return woken;
+        }
+        /**
+         * @brief Sleep (releasing @p lock) until @p predicate becomes true.
+         *
+         * @param lock Held lock
+         * @param predicate Condition checked under lock
+         */
+        template<typename Lock, typename Predicate>
+        void wait(Lock& lock, Predicate predicate) {
+            while (!predicate())
+                wait(lock);
+        }
+
+        /// @brief Wake one waiting thread (if any)
+        void notify_one() {
+            if (!_has_waiters.load(std::memory_order_relaxed)) return;
+            ParkingLot::unpark_one(this, [this](bool has_more) {
+                _has_waiters.store(has_more, std::memory_order_relaxed);
+            });
+        }
+        /// @brief Wake all waiting threads (if any)
+        void notify_all() {
+            if (!_has_waiters.load(std::memory_order_relaxed)) return;
+            _has_waiters.store(false, std::memory_order_relaxed);
+            ParkingLot::unpark_all(this);
+        }
+
+      private:
+        std::atomic<bool> _has_waiters { false };
+    };
+
+} // namespace parallel
+
+} // namespace CORE_NAMESPACE
@@ -0,0 +1,331 @@
+/**
+ * @file task.hpp
+ * @author Android172 (android172unity@gmail.com)
+ * @brief Defines C++20 coroutine task type. Available only if core is built
+ * with coroutine support (`-DCORE_COROUTINES=ON`).
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include "common/defines.hpp"
+
+#ifndef CORE_COROUTINES
+#    error "Coroutine support requires a C++20 build (-DCORE_COROUTINES=ON)."
+#endif
+
+#include "memory/memory_system.hpp"
+#include "thread_pool.hpp"
+
+#include <condition_variable>
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+
+namespace CORE_NAMESPACE {
+
+namespace parallel {
+
+    namespace __detail__ {
+        /**
+         * @brief Base of all core promise types. Places coroutine frames into
+         * memory owned by `BaseMemoryTags.Coroutine`.
+         */
+        struct CoroutinePromiseBase {
+            static void* operator new(std::size_t size) {
+                return ::operator new(size, BaseMemoryTags.Coroutine);
+            }
+            static void operator delete(void* ptr) { ::operator delete(ptr); }
+        };
+
+        template<typename T>
+        class TaskPromise;
+
+        // Resumes awaiting coroutine (if any) once task finishes
+        struct TaskFinalAwaiter {
+            bool await_ready() const noexcept { return false; }
+            template<typename Promise>
+            std::coroutine_handle<> await_suspend(
+                std::coroutine_handle<Promise> handle
+            ) const noexcept {
+                const auto continuation = handle.promise().continuation();
+                if (continuation) return continuation;
+                return std::noop_coroutine();
+            }
+            void await_resume() const noexcept {}
+        };
+
+        template<typename T>
+        class TaskPromiseBase : public CoroutinePromiseBase {
+          public:
+            std::suspend_always initial_suspend() const noexcept { return {}; }
+            TaskFinalAwaiter    final_suspend() const noexcept { return {}; }
+
+            void unhandled_exception() noexcept {
+                _exception = std::current_exception();
+            }
+
+            /// @brief Coroutine resumed once this one finishes
+            std::coroutine_handle<> continuation() const noexcept {
+                return _continuation;
+            }
+            void set_continuation(std::coroutine_handle<> handle) noexcept {
+                _continuation = handle;
+            }
+
+          protected:
+            std::coroutine_handle<> _continuation {};
+            std::exception_ptr      _exception {};
+
+            void rethrow_if_failed() const {
+                if (_exception) std::rethrow_exception(_exception);
+            }
+        };
+    } // namespace __detail__
+
+    /**
+     * @brief Lazily started asynchronous computation producing value of type
+     * @b T. Task starts running only once awaited (or passed to `sync_wait` /
+     * `spawn`). Once finished, awaiting coroutine is resumed on the same thread
+     * the task finished on. Combined with `schedule` and other core awaitables
+     * this lets request handling be written linearly, while every suspended
+     * request only holds its coroutine frame (allocated with
+     * `BaseMemoryTags.Coroutine`) and no thread.
+     *
+     *  ```cpp
+     *      Task<int32> compute() {
+     *          co_await parallel::schedule(); // Continue on the thread pool
+     *          co_return 42;
+     *      }
+     *  ```
+     *
+     * @tparam T Result type
+     */
+    template<typename T = void>
+    class [[nodiscard]] Task {
+      public:
+        using promise_type = __detail__::TaskPromise<T>;
+        using Handle       = std::coroutine_handle<promise_type>;
+
+        Task() noexcept = default;
+        explicit Task(Handle handle) noexcept : _handle(handle) {}
+        Task(Task&& other) noexcept
+            : _handle(std::exchange(other._handle, nullptr)) {}
+        Task& operator=(Task&& other) noexcept {
+            if (this != &other) {
+                if (_handle) _handle.destroy();
+                _handle = std::exchange(other._handle, nullptr);
+            }
+            return *this;
+        }
+        Task(const Task&)            = delete;
+        Task& operator=(const Task&) = delete;
+        ~Task() {
+            if (_handle) _handle.destroy();
+        }
+
+        /// @brief True if this task holds a coroutine
+        bool valid() const noexcept { return (bool) _handle; }
+        /// @brief True if held coroutine ran to completion
+        bool done() const noexcept { return !_handle || _handle.done(); }
+
+        auto operator co_await() & noexcept {
+            return Awaiter<false> { _handle };
+        }
+        auto operator co_await() && noexcept {
+            return Awaiter<true> { _handle };
+        }
+
+      private:
+        Handle _handle {};
+
+        template<bool MoveResult>
+        struct Awaiter {
+            Handle handle;
+
+            bool await_ready() const noexcept {
+                return !handle || handle.done();
+            }
+            std::coroutine_handle<> await_suspend(
+                std::coroutine_handle<> awaiting
+            ) const noexcept {
+                handle.promise().set_continuation(awaiting);
+                return handle;
+            }
+            decltype(auto) await_resume() const {
+                if constexpr (MoveResult)
+                    return std::move(handle.promise()).result();
+                else return handle.promise().result();
+            }
+        };
+
+        template<typename U>
+        friend U sync_wait(Task<U> task);
+    };
+
+    namespace __detail__ {
+        template<typename T>
+        class TaskPromise : public TaskPromiseBase<T> {
+          public:
+            Task<T> get_return_object() noexcept {
+                return Task<T> {
+                    std::coroutine_handle<TaskPromise>::from_promise(*this)
+                };
+            }
+
+            template<typename V>
+            void return_value(V&& value) {
+                _value.emplace(std::forward<V>(value));
+            }
+
+            T& result() & {
+                this->rethrow_if_failed();
+                return *_value;
+            }
+            T result() && {
+                this->rethrow_if_failed();
+                return std::move(*_value);
+            }
+
+          private:
+            std::optional<T> _value {};
+        };
+
+        template<>
+        class TaskPromise<void> : public TaskPromiseBase<void> {
+          public:
+            Task<void> get_return_object() noexcept {
+                return Task<void> {
+                    std::coroutine_handle<TaskPromise>::from_promise(*this)
+                };
+            }
+
+            void return_void() const noexcept {}
+            void result() const { rethrow_if_failed(); }
+        };
+
+        // Self destroying coroutine used for fire and forget execution
+        struct DetachedTask {
+            struct promise_type : public CoroutinePromiseBase {
+                DetachedTask get_return_object() const noexcept { return {}; }
+                std::suspend_never initial_suspend() const noexcept {
+                    return {};
+                }
+                std::suspend_never final_suspend() const noexcept { return {}; }
+                void return_void() const noexcept {}
+                void unhandled_exception() const noexcept { std::terminate(); }
+            };
+        };
+
+        // Completion flag shared between `sync_wait` and its waiting task
+        struct SyncWaitState {
+            Mutex                   mutex;
+            std::condition_variable condition;
+            bool                    finished = false;
+        };
+
+        // Coroutine signaling completion once awaited task completes
+        struct BlockingTask {
+            struct promise_type : public CoroutinePromiseBase {
+                SyncWaitState* state = nullptr;
+
+                BlockingTask get_return_object() noexcept {
+                    return { std::coroutine_handle<promise_type>::from_promise(
+                        *this
+                    ) };
+                }
+                std::suspend_always initial_suspend() const noexcept {
+                    return {};
+                }
+                auto final_suspend() const noexcept {
+                    struct Signal {
+                        bool await_ready() const noexcept { return false; }
+                        void await_suspend(
+                            std::coroutine_handle<promise_type> handle
+                        ) const noexcept {
+                            // Notify under lock; waiter can't leave (and
+                            // destroy state) before we are done with it
+                            const auto state = handle.promise().state;
+                            std::lock_guard<std::mutex> lock { state->mutex };
+                            state->finished = true;
+                            state->condition.notify_all();
+                        }
+                        void await_resume() const noexcept {}
+                    };
+                    return Signal {};
+                }
+                void return_void() const noexcept {}
+                void unhandled_exception() const noexcept { std::terminate(); }
+            };
+
+            std::coroutine_handle<promise_type> handle;
+        };
+
+        template<typename T>
+        BlockingTask make_blocking_task(Task<T>& task) {
+            // Failure is rethrown by `sync_wait`, once result is requested
+            try {
+                co_await task;
+            } catch (...) {}
+        }
+    } // namespace __detail__
+
+    // -------------------------------------------------------------------------
+    // Task execution
+    // -------------------------------------------------------------------------
+
+    /**
+     * @brief Start task on the calling thread and block until it finishes.
+     * Intended as an entry point from non-coroutine code (main, tests, ...).
+     *
+     * @param task Task to run
+     * @return T Result produced by the task
+     * @throw Rethrows any exception escaping the task
+     */
+    template<typename T>
+    T sync_wait(Task<T> task) {
+        __detail__::SyncWaitState state {};
+
+        auto blocking = __detail__::make_blocking_task(task);
+        blocking.handle.promise().state = &state;
+        blocking.handle.resume();
+        {
+            std::unique_lock<std::mutex> lock { state.mutex };
+            state.condition.wait(lock, [&state]() { return state.finished; });
+        }
+        blocking.handle.destroy();
+
+        return std::move(task._handle.promise()).result();
+    }
+
+    /**
+     * @brief Start task on the given thread pool without waiting for its
+     * result. Task is destroyed once it finishes. Exceptions escaping the task
+     * terminate the application, same as with `std::thread`.
+     *
+     * @param task Task to run
+     * @param pool Pool on which task starts
+     */
+    inline void spawn(Task<void> task, ThreadPool& pool = ThreadPool::global()) {
+        [](Task<void> task, ThreadPool& pool) -> __detail__::DetachedTask {
+            struct {
+                ThreadPool& pool;
+                bool        await_ready() const noexcept { return false; }
+                void        await_suspend(std::coroutine_handle<> handle) {
+                    pool.submit([handle]() { handle.resume(); });
+                }
+                void await_resume() const noexcept {}
+            } schedule_on { pool };
+            co_await schedule_on;
+            co_await task;
+        }(std::move(task), pool);
+    }
+
+} // namespace parallel
+
+} // namespace CORE_NAMESPACE
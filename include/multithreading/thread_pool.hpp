@@ -0,0 +1,164 @@
+/**
+ * @file thread_pool.hpp
+ * @author Android172 (android172unity@gmail.com)
+ * @brief Defines the worker thread pool used for asynchronous execution.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include "common/types.hpp"
+#include "parallel.hpp"
+#include "synchronization.hpp"
+#include "memory/memory_system.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace CORE_NAMESPACE {
+
+namespace parallel {
+
+    /**
+     * @brief Fixed size pool of worker threads. Jobs submitted to the pool are
+     * executed in FIFO order by the first available worker. Delayed jobs are
+     * kept in a separate deadline ordered queue and are moved to the main
+     * queue once their deadline passes, so no thread is blocked while waiting
+     * on them.
+     */
+    class ThreadPool {
+      public:
+        /// @brief Unit of work executed by the pool
+        typedef std::function<void()> Job;
+
+        /**
+         * @brief Construct a new Thread Pool object and start its workers.
+         *
+         * @param thread_count Number of worker threads. If 0, number of
+         * hardware threads is used instead.
+         */
+        explicit ThreadPool(const uint32 thread_count = 0);
+        /**
+         * @brief Destroy the Thread Pool object. All already queued (not
+         * delayed) jobs are finished before workers are joined.
+         */
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&)            = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        /**
+         * @brief Queue a job for execution on one of the workers.
+         * @param job Job to execute
+         */
+        void submit(Job job);
+        /**
+         * @brief Queue a job for execution after at least @p delay_ms
+         * milliseconds have passed.
+         *
+         * @param delay_ms Delay in milliseconds
+         * @param job Job to execute
+         */
+        void submit_after(const uint64 delay_ms, Job job);
+
+        /**
+         * @brief Call `job(index)` for every index in [0, @p count), on
+         * workers and calling thread, and return once all calls are done.
+         * Indices are claimed dynamically, so calling thread finishes the
+         * work alone if workers are busy (ex. when called from a worker),
+         * instead of waiting on them. If some calls throw, the rest still
+         * run, and the first exception is rethrown once all are done.
+         * @param count Number of indices
+         * @param job Job to execute for each index
+         */
+        template<typename Function>
+        void run_joined(const uint64 count, const Function& job) {
+            if (count == 0) return;
+            struct State {
+                std::atomic<uint64> next { 0 };
+                Latch               done;
+                uint64              count;
+                const Function*     job;
+                std::atomic<bool>   failed { false };
+                std::exception_ptr  exception {};
+
+                State(const uint64 count, const Function* job)
+                    : done(count), count(count), job(job) {}
+
+                void run() {
+                    uint64 index;
+                    while ((index = next.fetch_add(1)) < count) {
+                        // Always counted down, or caller would wait forever
+                        try {
+                            (*job)(index);
+                        } catch (...) {
+                            if (!failed.exchange(true))
+                                exception = std::current_exception();
+                        }
+                        done.count_down();
+                    }
+                }
+            };
+
+            // Workers may pick up their job after all indices were claimed,
+            // so state is shared. Job itself is only touched by claimed ones.
+            // State is cache line aligned (see `TAllocator`).
+            const auto state =
+                std::make_shared<State>(BaseMemoryTags.Callback, count, &job);
+            const auto helpers = std::min<uint64>(count - 1, thread_count());
+            for (uint64 i = 0; i < helpers; i++)
+                submit([state]() { state->run(); });
+            state->run();
+            state->done.wait();
+            if (state->exception) std::rethrow_exception(state->exception);
+        }
+
+        /// @brief Number of worker threads owned by this pool
+        uint32 thread_count() const { return (uint32) _workers.size(); }
+        /// @brief True if calling thread is one of this pool's workers
+        bool   is_worker_thread() const;
+
+        /**
+         * @brief Get core wide thread pool. Created on first use with one
+         * worker per hardware thread.
+         */
+        static ThreadPool& global();
+
+      private:
+        struct TimedJob {
+            float64 deadline;
+            uint64  sequence;
+            Job     job;
+
+            // Heap ordering; earliest deadline (FIFO on ties) on top
+            bool operator<(const TimedJob& other) const {
+                if (deadline != other.deadline)
+                    return deadline > other.deadline;
+                return sequence > other.sequence;
+            }
+        };
+
+        std::vector<std::thread> _workers;
+        std::deque<Job>          _jobs;
+        std::vector<TimedJob>    _timed_jobs;
+        uint64                   _timed_sequence = 0;
+        bool                     _stopping       = false;
+
+        Mutex                   _mutex;
+        std::condition_variable _condition;
+
+        void worker_loop();
+        void release_due_jobs(const float64 now);
+    };
+
+} // namespace parallel
+
+} // namespace CORE_NAMESPACE
@@ -0,0 +1,200 @@
+/**
+ * @file observable_property.hpp
+ * @author Android172 (android172unity@gmail.com)
+ * @brief Defines properties with change tracking and batched notification.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include "event.hpp"
+#include "common/error_types.hpp"
+#include "common/type_traits.hpp"
+
+#include <type_traits>
+#include <utility>
+
+namespace CORE_NAMESPACE {
+
+template<typename T>
+class ComputedProperty;
+
+/**
+ * @brief Records which of its object's observable properties changed, as a
+ * dirty bitmask with one bit per property. Writes only set a bit; observers
+ * are notified once per `flush`, with mask of everything that changed since
+ * the previous one. Tracks up to 64 properties. Not thread safe.
+ *
+ *  ```cpp
+ *      class Object {
+ *        public:
+ *          ChangeTracker             changes {};
+ *          ObservableProperty<float> x { changes };
+ *          ObservableProperty<float> y { changes };
+ *      };
+ *
+ *      object.changes.on_change += [](const uint64 mask) { ... };
+ *      object.x = 1; object.y = 2; object.x = 3;
+ *      object.changes.flush(); // Single notification, with mask 0b11
+ *  ```
+ */
+class ChangeTracker {
+  public:
+    /// @brief Maximum number of properties per tracker
+    static const constexpr uint32 max_properties = 64;
+
+    /// @brief Invoked by flush with mask of changed properties
+    Event<void(uint64)> on_change {};
+
+    ChangeTracker() {}
+    ~ChangeTracker() {}
+
+    ChangeTracker(const ChangeTracker&)            = delete;
+    ChangeTracker& operator=(const ChangeTracker&) = delete;
+
+    /**
+     * @brief Reserve bit for a new property. Called by properties on
+     * construction.
+     * @return uint64 Mask with reserved bit set
+     * @throws InvalidArgument If all bits are already taken
+     */
+    uint64 register_property() {
+        if (_property_count >= max_properties)
+            throw InvalidArgument(
+                "Change tracker can't observe more than 64 properties."
+            );
+        return (uint64) 1 << _property_count++;
+    }
+
+    /// @brief Mark properties in @p mask as changed
+    void mark(const uint64 mask) {
+        _dirty |= mask;
+        _version++;
+    }
+    /// @brief Mask of properties changed since the last flush
+    uint64 dirty() const { return _dirty; }
+    /// @brief True if any property in @p mask changed since the last flush
+    bool is_dirty(const uint64 mask = ~(uint64) 0) const {
+        return (_dirty & mask) != 0;
+    }
+    /// @brief Forget all changes, without notifying
+    void clear() { _dirty = 0; }
+    /// @brief Number of changes made to all tracked properties. Unlike dirty
+    /// mask it isn't reset by flush.
+    uint64 version() const { return _version; }
+
+    /**
+     * @brief Notify observers of all changes since the last flush (if any),
+     * in a single `on_change` invocation. Changes made by observers are
+     * reported on the next flush.
+     * @return uint64 Mask of reported properties
+     */
+    uint64 flush() {
+        const auto mask = _dirty;
+        if (mask == 0) return 0;
+        _dirty = 0;
+        on_change(mask);
+        return mask;
+    }
+
+  private:
+    uint64 _dirty          = 0;
+    uint64 _version        = 0;
+    uint32 _property_count = 0;
+
+    template<typename T>
+    friend class ComputedProperty;
+};
+
+/**
+ * @brief Property which marks itself dirty in its object's `ChangeTracker`
+ * whenever its value changes. Write costs one comparison and one bit
+ * operation, no callback is called. Each successful change also increments
+ * property's version counter.
+ *
+ * @tparam T Type of held value
+ */
+template<typename T>
+class ObservableProperty {
+  public:
+    /**
+     * @brief Construct a new Observable Property object
+     *
+     * @param tracker Tracker of the owning object
+     * @param value Initial value
+     */
+    ObservableProperty(ChangeTracker& tracker, T value = T())
+        : _value(std::move(value)), _tracker(&tracker),
+          _mask(tracker.register_property()) {}
+
+    // Property is bound to its owner's tracker, so it can't be copy
+    // constructed. Assignment copies only the value, marking it changed.
+    ObservableProperty(const ObservableProperty&) = delete;
+    ObservableProperty& operator=(const ObservableProperty& other) {
+        set(other._value);
+        return *this;
+    }
+
+    /// @brief Current value
+    const T& get() const { return _value; }
+    /**
+     * @brief Set new value. Property is marked dirty only if the value
+     * differs from current one (for equality comparable types).
+     */
+    template<typename V>
+    void set(V&& value) {
+        if constexpr (is_equality_comparable<T>::value) {
+            if (_value == value) return;
+        }
+        _value = std::forward<V>(value);
+        mark();
+    }
+    /**
+     * @brief Modify value in place through @p modifier, taking `T&`.
+     * Property is always marked dirty.
+     */
+    template<typename Modifier>
+    void modify(Modifier&& modifier) {
+        modifier(_value);
+        mark();
+    }
+
+    template<
+        typename V,
+        typename = std::enable_if_t<
+            !std::is_same_v<std::decay_t<V>, ObservableProperty>>>
+    ObservableProperty& operator=(V&& value) {
+        set(std::forward<V>(value));
+        return *this;
+    }
+
+    operator const T&() const { return _value; }
+    const T& operator()() const { return _value; }
+    const T* operator->() const { return &_value; }
+
+    /// @brief Bit of this property in tracker's dirty mask
+    uint64 mask() const { return _mask; }
+    /// @brief True if property changed since the last flush of its tracker
+    bool   is_dirty() const { return _tracker->is_dirty(_mask); }
+    /// @brief Number of changes made to this property
+    uint64 version() const { return _version; }
+    /// @brief Tracker of the owning object
+    const ChangeTracker& tracker() const { return *_tracker; }
+
+  private:
+    T              _value;
+    ChangeTracker* _tracker;
+    uint64         _mask;
+    uint64         _version = 0;
+
+    void mark() {
+        _tracker->mark(_mask);
+        _version++;
+    }
+};
+
+} // namespace CORE_NAMESPACE
@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <string>
 
 #include "common/types.hpp"
@@ -43,6 +44,62 @@ namespace platform {
     /// @param ms Time to sleep in miliseconds
     void sleep(uint64 ms);
 
+    /**
+     * @brief Blocks calling thread while value at @p address equals
+     * @p expected, or until woken by `futex_wake_*`. May also return
+     * spuriously, so callers should recheck their condition.
+     *
+     * @param address Address of 32 bit wait word
+     * @param expected Value for which thread should sleep
+     * @param timeout_ms Maximum time to wait in miliseconds (by default
+     * infinite)
+     * @return true If woken up (or value differed)
+     * @return false If timeout expired
+     */
+    bool futex_wait(
+        std::atomic<uint32>* address,
+        uint32               expected,
+        uint64               timeout_ms = uint64_max
+    );
+    /**
+     * @brief Wakes at most one thread waiting on @p address.
+     * @param address Address of 32 bit wait word
+     */
+    void futex_wake_one(std::atomic<uint32>* address);
+    /**
+     * @brief Wakes all threads waiting on @p address.
+     * @param address Address of 32 bit wait word
+     */
+    void futex_wake_all(std::atomic<uint32>* address);
+
+    /**
+     * @brief Maps whole file at @p path into memory, for reading only. Pages
+     * are loaded by the system on first access.
+     *
+     * @param path Path of the file
+     * @param size Set to the size of the file in bytes
+     * @return const void* Start of the mapped memory, or nullptr if file
+     * couldn't be opened or mapped. Empty files are never mapped.
+     */
+    const void* map_file(const char* path, uint64& size);
+    /**
+     * @brief Unmaps memory mapped by `map_file`.
+     *
+     * @param data Start of the mapped memory
+     * @param size Size of the mapped file
+     */
+    void unmap_file(const void* data, uint64 size);
+    /**
+     * @brief Flushes written data of file at @p path from system caches to
+     * the storage device, so that it survives a crash or power loss. Data
+     * buffered by the process (ex. in a stream) must be flushed first.
+     *
+     * @param path Path of the file
+     * @return true If data was synced
+     * @return false If file couldn't be opened or synced
+     */
+    bool sync_file(const char* path);
+
     /**
      * @brief A platform agnostic Console I/O class. Can only be used if the
      * platform supports a console.
@@ -14,7 +14,9 @@
 #include "common/error_types.hpp"
 #include "string.hpp"
 
+#include <cstddef>
 #include <functional>
+#include <type_traits>
 #include <utility>
 
 namespace CORE_NAMESPACE {
@@ -23,6 +25,42 @@ namespace CORE_NAMESPACE {
 #define SET , [this](auto value)
 #define GETSET BaseProperty::__GETSET__(),
 
+// Lets empty members take no space (MSVC uses its own spelling)
+#if defined(_MSC_VER)
+#    define CORE_NO_UNIQUE_ADDRESS [[msvc::no_unique_address]]
+#else
+#    define CORE_NO_UNIQUE_ADDRESS [[no_unique_address]]
+#endif
+
+// Owner is only required to have no virtual bases, not to be standard layout
+#if defined(__GNUC__)
+#    define __PROPERTY_OFFSETOF__(Owner, name)                                 \
+        _Pragma("GCC diagnostic push")                                         \
+        _Pragma("GCC diagnostic ignored \"-Winvalid-offsetof\"")               \
+        return offsetof(Owner, name);                                          \
+        _Pragma("GCC diagnostic pop")
+#else
+#    define __PROPERTY_OFFSETOF__(Owner, name) return offsetof(Owner, name);
+#endif
+
+/**
+ * @brief Declares `StaticProperty` attribute @p name of class @p Owner. Rest of
+ * the arguments are getter and (optional) setter, see `StaticProperty`.
+ *
+ *  ```cpp
+ *      STATIC_PROPERTY(Owner, name, &Owner::_name, &Owner::set_name);
+ *  ```
+ */
+#define STATIC_PROPERTY(Owner, name, ...)                                      \
+    static CORE_NAMESPACE::uint64 __##name##_offset__() {                      \
+        __PROPERTY_OFFSETOF__(Owner, name)                                     \
+    }                                                                          \
+    CORE_NO_UNIQUE_ADDRESS CORE_NAMESPACE::StaticProperty<                     \
+        Owner,                                                                 \
+        &Owner::__##name##_offset__,                                           \
+        __VA_ARGS__>                                                           \
+        name
+
 /**
  * @brief Base class for generic property class. Holds some common definitions.
  * Not usable by itself.
@@ -322,4 +360,112 @@ class Property<T&&> : protected BaseProperty {
     const std::function<void(T)> _setter;
 };
 
-} // namespace CORE_NAMESPACE
\ No newline at end of file
+// -----------------------------------------------------------------------------
+// Static property
+// -----------------------------------------------------------------------------
+
+namespace __detail__ {
+    // Accessors can be pointers to data members, pointers to member functions
+    // or free functions taking owner as first argument
+
+    template<auto Getter, typename Owner>
+    decltype(auto) property_get(const Owner& owner) {
+        typedef decltype(Getter) Accessor;
+        if constexpr (std::is_member_object_pointer_v<Accessor>)
+            return (owner.*Getter);
+        else if constexpr (std::is_member_function_pointer_v<Accessor>)
+            return (owner.*Getter)();
+        else return Getter(owner);
+    }
+
+    template<auto Setter, typename Owner, typename V>
+    void property_set(Owner& owner, V&& value) {
+        typedef decltype(Setter) Accessor;
+        if constexpr (std::is_member_object_pointer_v<Accessor>)
+            owner.*Setter = std::forward<V>(value);
+        else if constexpr (std::is_member_function_pointer_v<Accessor>)
+            (owner.*Setter)(std::forward<V>(value));
+        else Setter(owner, std::forward<V>(value));
+    }
+} // namespace __detail__
+
+/**
+ * @brief Property with getter and setter bound at compile time. Unlike
+ * `Property` it holds no state, so (declared with `STATIC_PROPERTY`) it takes
+ * no space in its owner, and all accesses compile down to direct calls (or
+ * direct field accesses). Owner is found from property's own address, so
+ * owner must be a class for which `offsetof` is valid (no virtual bases).
+ * Should be declared as class attribute like so:
+ *
+ *  ```cpp
+ *      class Owner {
+ *          T _attribute;
+ *          void set_attribute(const T& value);
+ *        public:
+ *          // Direct field access for both get and set
+ *          STATIC_PROPERTY(Owner, attribute, &Owner::_attribute,
+ *                          &Owner::_attribute);
+ *          // Getter only, immutable
+ *          STATIC_PROPERTY(Owner, read_only, &Owner::_attribute);
+ *          // Setter through a method
+ *          STATIC_PROPERTY(Owner, checked, &Owner::_attribute,
+ *                          &Owner::set_attribute);
+ *      };
+ *  ```
+ *
+ * Getter can be a pointer to data member, pointer to const method taking no
+ * arguments or a function taking `const Owner&`. Setter can be a pointer to
+ * data member, pointer to method taking the value or a function taking
+ * `Owner&` and the value. Assigning to property without setter fails to
+ * compile.
+ *
+ * @tparam Owner Class owning the property
+ * @tparam Offset Function returning offset of the property inside of owner
+ * @tparam Getter Accessor used for reads
+ * @tparam Setter Accessor used for writes, nullptr if immutable
+ */
+template<typename Owner, uint64 (*Offset)(), auto Getter, auto Setter = nullptr>
+class StaticProperty {
+  public:
+    StaticProperty() {}
+
+    // On copy do nothing, value belongs to the owner
+    StaticProperty(const StaticProperty&) {}
+    StaticProperty& operator=(const StaticProperty&) { return *this; }
+
+    /// @brief Get value through the getter
+    decltype(auto) get() const {
+        return __detail__::property_get<Getter>(owner());
+    }
+    /// @brief Set value through the setter
+    template<typename V>
+    void set(V&& value) {
+        static_assert(
+            !std::is_null_pointer_v<decltype(Setter)> || sizeof(V) == 0,
+            "Immutable property manipulation failed. Value of this property "
+            "cannot be changed."
+        );
+        __detail__::property_set<Setter>(owner(), std::forward<V>(value));
+    }
+
+    template<
+        typename V,
+        typename = std::enable_if_t<
+            !std::is_same_v<std::decay_t<V>, StaticProperty>>>
+    StaticProperty& operator=(V&& value) {
+        set(std::forward<V>(value));
+        return *this;
+    }
+
+    operator decltype(auto)() const { return get(); }
+    decltype(auto) operator()() const { return get(); }
+    auto           operator->() const { return &get(); }
+
+  private:
+    const Owner& owner() const {
+        return *(const Owner*) ((const char*) this - Offset());
+    }
+    Owner& owner() { return *(Owner*) ((char*) this - Offset()); }
+};
+
+} // namespace CORE_NAMESPACE
@@ -4,120 +4,176 @@
 
 namespace CORE_NAMESPACE {
 
+/**
+ * @brief Byte order of multibyte values
+ */
+enum class Endianness : uint8 { Little = 0, Big = 1 };
+
 /**
  * @brief A class that inherits from the Serializer class and provides
  * functionality for binary serialization and deserialization of various data
  * types.
  *
+ * Multibyte values are stored in selected wire byte order, little endian by
+ * default. When it matches byte order of the host values are stored and
+ * loaded as they are, otherwise bytes are swapped. Wire byte order is
+ * recorded in the document header (see `write_header`).
  */
 class BinarySerializer : public Serializer {
+  public:
+    /// @brief Size of the header written by `write_header`
+    static const constexpr uint32 header_size = 4;
+
+    /**
+     * @brief Construct a new Binary Serializer object
+     *
+     * @param wire_endianness Byte order of serialized multibyte values
+     */
+    BinarySerializer(const Endianness wire_endianness = Endianness::Little);
+
+    /// @brief Byte order of serialized multibyte values
+    Endianness wire_endianness() const { return _wire_endianness; }
+
+    /**
+     * @brief Write document header, recording wire byte order
+     */
+    virtual void write_header(SerializationSink& out) const override;
+    /**
+     * @brief Read document header. Fails if it records byte order different
+     * from the wire byte order of this serializer.
+     */
+    virtual Result<void, RuntimeError> read_header(
+        const String& data, uint64& position
+    ) const override;
+
+    /**
+     * @brief Get byte order recorded in the header at @p position of
+     * @p data, without reading it. Can be used to create serializer which
+     * can read the document.
+     * @throw RuntimeError If there is no valid header at @p position
+     */
+    static Result<Endianness, RuntimeError> header_endianness(
+        const String& data, const uint64 position = 0
+    );
+
   protected:
     virtual void serialize_primitive(
-        String& out_str, void* const data, const uint8& size
+        SerializationSink& out, const void* const data, const uint8 size
     ) const;
 
     virtual Outcome deserialize_primitive(
         const String& data,
-        uint32&       total_read,
+        uint64&       position,
         byte* const   out_data,
-        const uint8&  size
+        const uint8   size
     ) const;
 
     // clang-format off
     // === Serialize for types ===
     // Bool
-    virtual void serialize_type(String& out_str, const bool data)       const override;
+    virtual void serialize_type(SerializationSink& out, const bool data)       const override;
     // Char
-    virtual void serialize_type(String& out_str, const char data)       const override;
+    virtual void serialize_type(SerializationSink& out, const char data)       const override;
     // Int
-    virtual void serialize_type(String& out_str, const int8 data)       const override;
-    virtual void serialize_type(String& out_str, const int16 data)      const override;
-    virtual void serialize_type(String& out_str, const int32 data)      const override;
-    virtual void serialize_type(String& out_str, const int64 data)      const override;
-    virtual void serialize_type(String& out_str, const int128 data)     const override;
-    virtual void serialize_type(String& out_str, const uint8 data)      const override;
-    virtual void serialize_type(String& out_str, const uint16 data)     const override;
-    virtual void serialize_type(String& out_str, const uint32 data)     const override;
-    virtual void serialize_type(String& out_str, const uint64 data)     const override;
-    virtual void serialize_type(String& out_str, const uint128 data)    const override;
+    virtual void serialize_type(SerializationSink& out, const int8 data)       const override;
+    virtual void serialize_type(SerializationSink& out, const int16 data)      const override;
+    virtual void serialize_type(SerializationSink& out, const int32 data)      const override;
+    virtual void serialize_type(SerializationSink& out, const int64 data)      const override;
+    virtual void serialize_type(SerializationSink& out, const int128 data)     const override;
+    virtual void serialize_type(SerializationSink& out, const uint8 data)      const override;
+    virtual void serialize_type(SerializationSink& out, const uint16 data)     const override;
+    virtual void serialize_type(SerializationSink& out, const uint32 data)     const override;
+    virtual void serialize_type(SerializationSink& out, const uint64 data)     const override;
+    virtual void serialize_type(SerializationSink& out, const uint128 data)    const override;
     // Float
-    virtual void serialize_type(String& out_str, const float32 data)    const override;
-    virtual void serialize_type(String& out_str, const float64 data)    const override;
+    virtual void serialize_type(SerializationSink& out, const float32 data)    const override;
+    virtual void serialize_type(SerializationSink& out, const float64 data)    const override;
     // String
-    virtual void serialize_type(String& out_str, const String& data)    const override;
+    virtual void serialize_type(SerializationSink& out, const String& data)    const override;
+    virtual void serialize_type(SerializationSink& out, const StringView data) const override;
     // Math
-    // virtual void serialize_type(String& out_str, const glm::vec1& data) const override;
-    // virtual void serialize_type(String& out_str, const glm::vec2& data) const override;
-    // virtual void serialize_type(String& out_str, const glm::vec3& data) const override;
-    // virtual void serialize_type(String& out_str, const glm::vec4& data) const override;
-    // virtual void serialize_type(String& out_str, const glm::mat2& data) const override;
-    // virtual void serialize_type(String& out_str, const glm::mat3& data) const override;
-    // virtual void serialize_type(String& out_str, const glm::mat4& data) const override;
+    // virtual void serialize_type(SerializationSink& out, const glm::vec1& data) const override;
+    // virtual void serialize_type(SerializationSink& out, const glm::vec2& data) const override;
+    // virtual void serialize_type(SerializationSink& out, const glm::vec3& data) const override;
+    // virtual void serialize_type(SerializationSink& out, const glm::vec4& data) const override;
+    // virtual void serialize_type(SerializationSink& out, const glm::mat2& data) const override;
+    // virtual void serialize_type(SerializationSink& out, const glm::mat3& data) const override;
+    // virtual void serialize_type(SerializationSink& out, const glm::mat4& data) const override;
 
     // === Deserialize for types ===
     // Bool
-    virtual Outcome deserialize_type(const String& in_str, bool& data, uint32& position)      const override;
+    virtual Outcome deserialize_type(const String& in_str, bool& data, uint64& position)      const override;
     // Char
-    virtual Outcome deserialize_type(const String& in_str, char& data, uint32& position)      const override;
+    virtual Outcome deserialize_type(const String& in_str, char& data, uint64& position)      const override;
     // Int
-    virtual Outcome deserialize_type(const String& in_str, int8& data, uint32& position)      const override;
-    virtual Outcome deserialize_type(const String& in_str, int16& data, uint32& position)     const override;
-    virtual Outcome deserialize_type(const String& in_str, int32& data, uint32& position)     const override;
-    virtual Outcome deserialize_type(const String& in_str, int64& data, uint32& position)     const override;
-    virtual Outcome deserialize_type(const String& in_str, int128& data, uint32& position)    const override;
-    virtual Outcome deserialize_type(const String& in_str, uint8& data, uint32& position)     const override;
-    virtual Outcome deserialize_type(const String& in_str, uint16& data, uint32& position)    const override;
-    virtual Outcome deserialize_type(const String& in_str, uint32& data, uint32& position)    const override;
-    virtual Outcome deserialize_type(const String& in_str, uint64& data, uint32& position)    const override;
-    virtual Outcome deserialize_type(const String& in_str, uint128& data, uint32& position)   const override;
+    virtual Outcome deserialize_type(const String& in_str, int8& data, uint64& position)      const override;
+    virtual Outcome deserialize_type(const String& in_str, int16& data, uint64& position)     const override;
+    virtual Outcome deserialize_type(const String& in_str, int32& data, uint64& position)     const override;
+    virtual Outcome deserialize_type(const String& in_str, int64& data, uint64& position)     const override;
+    virtual Outcome deserialize_type(const String& in_str, int128& data, uint64& position)    const override;
+    virtual Outcome deserialize_type(const String& in_str, uint8& data, uint64& position)     const override;
+    virtual Outcome deserialize_type(const String& in_str, uint16& data, uint64& position)    const override;
+    virtual Outcome deserialize_type(const String& in_str, uint32& data, uint64& position)    const override;
+    virtual Outcome deserialize_type(const String& in_str, uint64& data, uint64& position)    const override;
+    virtual Outcome deserialize_type(const String& in_str, uint128& data, uint64& position)   const override;
     // Float
-    virtual Outcome deserialize_type(const String& in_str, float32& data, uint32& position)   const override;
-    virtual Outcome deserialize_type(const String& in_str, float64& data, uint32& position)   const override;
+    virtual Outcome deserialize_type(const String& in_str, float32& data, uint64& position)   const override;
+    virtual Outcome deserialize_type(const String& in_str, float64& data, uint64& position)   const override;
     // String
-    virtual Outcome deserialize_type(const String& in_str, String& data, uint32& position)    const override;
+    virtual Outcome deserialize_type(const String& in_str, String& data, uint64& position)    const override;
+    virtual Outcome deserialize_type(const String& in_str, StringView& data, uint64& position) const override;
     // Math
-    // virtual Outcome deserialize_type(const String& in_str, glm::vec1& data, uint32& position) const override;
-    // virtual Outcome deserialize_type(const String& in_str, glm::vec2& data, uint32& position) const override;
-    // virtual Outcome deserialize_type(const String& in_str, glm::vec3& data, uint32& position) const override;
-    // virtual Outcome deserialize_type(const String& in_str, glm::vec4& data, uint32& position) const override;
-    // virtual Outcome deserialize_type(const String& in_str, glm::mat2& data, uint32& position) const override;
-    // virtual Outcome deserialize_type(const String& in_str, glm::mat3& data, uint32& position) const override;
-    // virtual Outcome deserialize_type(const String& in_str, glm::mat4& data, uint32& position) const override;
+    // virtual Outcome deserialize_type(const String& in_str, glm::vec1& data, uint64& position) const override;
+    // virtual Outcome deserialize_type(const String& in_str, glm::vec2& data, uint64& position) const override;
+    // virtual Outcome deserialize_type(const String& in_str, glm::vec3& data, uint64& position) const override;
+    // virtual Outcome deserialize_type(const String& in_str, glm::vec4& data, uint64& position) const override;
+    // virtual Outcome deserialize_type(const String& in_str, glm::mat2& data, uint64& position) const override;
+    // virtual Outcome deserialize_type(const String& in_str, glm::mat3& data, uint64& position) const override;
+    // virtual Outcome deserialize_type(const String& in_str, glm::mat4& data, uint64& position) const override;
     // clang-format on
 
     virtual void vector_add_beg(
-        String& out_str, const uint64 count, const uint64 type_size
+        SerializationSink& out, const uint64 count, const uint64 type_size
     ) const override;
     virtual Outcome vector_remove_beg(
         const String& in_str,
         uint64&       count,
         const uint64  type_size,
-        uint32&       position
+        uint64&       position
+    ) const override;
+
+    virtual bool has_block_encoding() const override { return true; }
+    virtual void serialize_block(
+        SerializationSink& out,
+        const void* const  data,
+        const uint64       count,
+        const BlockElement element
+    ) const override;
+    virtual Outcome deserialize_block(
+        const String&      in_str,
+        void* const        data,
+        const uint64       count,
+        const BlockElement element,
+        uint64&            position
     ) const override;
 
+    /// @brief Write size prefix (ex. element count of a vector)
+    virtual void serialize_size(
+        SerializationSink& out, const uint64 size
+    ) const;
+    /// @brief Read size prefix written by `serialize_size`
+    virtual Outcome deserialize_size(
+        const String& in_str, uint64& size, uint64& position
+    ) const;
+
+    /// @brief Identifies encoding in the header. Must differ between
+    /// serializers producing incompatible data.
+    virtual uint8 format_id() const { return 1; }
+
   private:
-    template<typename T>
-    void serialize_type(String& out_str, const Vector<T>& data) const {
-        serialize_type(out_str, (uint32) data.size());
-        for (const auto& data_point : data)
-            serialize_one(out_str, data_point);
-    }
-    template<typename T>
-    Outcome deserialize_type(
-        const String& in_str, Vector<T>& data, uint32& position
-    ) const {
-        // Data size
-        uint32 data_count;
-        if (deserialize_type(in_str, data_count, position).failed())
-            return Outcome::Failed;
-
-        // Data
-        data.resize(data_count);
-        for (auto& data_point : data)
-            if (!deserialize_one(in_str, data_point, position))
-                return Outcome::Failed;
-        return Outcome::Successful;
-    }
+    Endianness _wire_endianness;
+    // True if wire byte order differs from the one used by the host
+    bool       _swap_bytes;
 };
 
 } // namespace CORE_NAMESPACE
\ No newline at end of file
@@ -0,0 +1,33 @@
+/**
+ * @file chunked_vector.hpp
+ * @author Android172 (android172unity@gmail.com)
+ * @brief Defines vector serialized in parallel, as independent chunks
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+
+#include "serializer.hpp"
+#include "container/vector.hpp"
+
+namespace CORE_NAMESPACE {
+
+/**
+ * @brief Vector which, as a serializable attribute, is encoded as
+ * independent chunks of elements, with a chunk index (see
+ * `Serializer::serialize_chunked`). Chunks are encoded and decoded in
+ * parallel on the global thread pool, so large collections of objects don't
+ * serialize on a single core. Otherwise same as `Vector`.
+ *
+ * @tparam T Element type
+ */
+template<typename T>
+class ChunkedVector : public Vector<T> {
+  public:
+    using Vector<T>::Vector;
+};
+
+} // namespace CORE_NAMESPACE
@@ -0,0 +1,96 @@
+/**
+ * @file compact_binary_serializer.hpp
+ * @author Android172 (android172unity@gmail.com)
+ * @brief Defines binary serializer with variable length integer encoding
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+
+#include "binary_serializer.hpp"
+
+namespace CORE_NAMESPACE {
+
+/**
+ * @brief Binary serializer storing integers in as few bytes as their value
+ * needs. Integers wider than a byte, as well as sizes (ex. vector lengths),
+ * are written as LEB128 varints: 7 bits per byte, with the high bit set on
+ * all but the last byte. Signed integers are zigzag encoded first, so values
+ * of small magnitude stay short regardless of sign. Single byte values and
+ * floating point values are stored as with `BinarySerializer`.
+ *
+ * Vectors of integers are encoded and decoded as one block. Decoder reads
+ * varints of up to 8 bytes with a single load and a few mask operations,
+ * instead of a branch per byte.
+ */
+class CompactBinarySerializer : public BinarySerializer {
+  public:
+    /**
+     * @brief Construct a new Compact Binary Serializer object
+     *
+     * @param wire_endianness Byte order of serialized floating point values
+     */
+    CompactBinarySerializer(
+        const Endianness wire_endianness = Endianness::Little
+    )
+        : BinarySerializer(wire_endianness) {}
+
+  protected:
+    using BinarySerializer::deserialize_type;
+    using BinarySerializer::serialize_type;
+
+    // clang-format off
+    // === Serialize for types ===
+    // Int
+    virtual void serialize_type(SerializationSink& out, const int16 data)      const override;
+    virtual void serialize_type(SerializationSink& out, const int32 data)      const override;
+    virtual void serialize_type(SerializationSink& out, const int64 data)      const override;
+    virtual void serialize_type(SerializationSink& out, const int128 data)     const override;
+    virtual void serialize_type(SerializationSink& out, const uint16 data)     const override;
+    virtual void serialize_type(SerializationSink& out, const uint32 data)     const override;
+    virtual void serialize_type(SerializationSink& out, const uint64 data)     const override;
+    virtual void serialize_type(SerializationSink& out, const uint128 data)    const override;
+
+    // === Deserialize for types ===
+    // Int
+    virtual Outcome deserialize_type(const String& in_str, int16& data, uint64& position)     const override;
+    virtual Outcome deserialize_type(const String& in_str, int32& data, uint64& position)     const override;
+    virtual Outcome deserialize_type(const String& in_str, int64& data, uint64& position)     const override;
+    virtual Outcome deserialize_type(const String& in_str, int128& data, uint64& position)    const override;
+    virtual Outcome deserialize_type(const String& in_str, uint16& data, uint64& position)    const override;
+    virtual Outcome deserialize_type(const String& in_str, uint32& data, uint64& position)    const override;
+    virtual Outcome deserialize_type(const String& in_str, uint64& data, uint64& position)    const override;
+    virtual Outcome deserialize_type(const String& in_str, uint128& data, uint64& position)   const override;
+    // clang-format on
+
+    virtual void serialize_block(
+        SerializationSink& out,
+        const void* const  data,
+        const uint64       count,
+        const BlockElement element
+    ) const override;
+    virtual Outcome deserialize_block(
+        const String&      in_str,
+        void* const        data,
+        const uint64       count,
+        const BlockElement element,
+        uint64&            position
+    ) const override;
+    virtual uint64 min_block_element_size(
+        const BlockElement element
+    ) const override;
+
+    virtual void serialize_size(
+        SerializationSink& out, const uint64 size
+    ) const override;
+    virtual Outcome deserialize_size(
+        const String& in_str, uint64& size, uint64& position
+    ) const override;
+
+    virtual uint8 format_id() const override { return 2; }
+};
+
+} // namespace CORE_NAMESPACE
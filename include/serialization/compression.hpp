@@ -0,0 +1,247 @@
+/**
+ * @file compression.hpp
+ * @author Android172 (android172unity@gmail.com)
+ * @brief Defines block compression of serialized data
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+
+#include "serialization_sink.hpp"
+#include "outcome.hpp"
+#include "result.hpp"
+#include "common/error_types.hpp"
+#include "multithreading/thread_pool.hpp"
+
+namespace CORE_NAMESPACE {
+
+/**
+ * @brief Settings of block compression
+ */
+struct CompressionSettings {
+    /// @brief Maximum supported block size
+    static const constexpr uint32 max_block_size = 64 * MB;
+
+    /// @brief Size of independently compressed blocks. Larger blocks
+    /// compress better, smaller ones give finer random access and more
+    /// parallelism on decompression.
+    uint32 block_size = 256 * KB;
+    /// @brief Additionally Huffman code the LZ output of each block, when it
+    /// makes the block smaller. Gives better ratio for slower decompression.
+    bool   entropy    = false;
+};
+
+/**
+ * @brief Compression of data (ex. serialized objects) into a block framed
+ * container. Data is split into blocks of fixed size, each compressed
+ * independently with an LZ77 codec (LZ4 like byte oriented format, with
+ * 64 KB window), optionally followed by Huffman coding. Blocks which don't
+ * compress are stored as they are.
+ *
+ * Container ends with an index of block offsets, so blocks can be located
+ * without reading the whole container: decompression runs on all blocks in
+ * parallel, and any range of original data can be read by decompressing only
+ * the blocks covering it (see `CompressedReader`).
+ *
+ * Container layout (all integers little endian):
+ *  - header: magic "CZ", version, flags, 4 byte block size
+ *  - blocks: method byte followed by block payload
+ *  - index: 8 byte offset of each block
+ *  - footer: 8 byte index offset, 8 byte original size, 4 byte block count,
+ *    magic "CZIX"
+ */
+class Compression {
+  public:
+    /// @brief Size of container header
+    static const constexpr uint64 header_size = 8;
+    /// @brief Size of container footer
+    static const constexpr uint64 footer_size = 24;
+
+    /**
+     * @brief Compress @p data into a block framed container. Blocks are
+     * compressed in parallel.
+     *
+     * @param data Data to compress
+     * @param settings Compression settings
+     * @param pool Pool used for parallel compression
+     * @return String Compressed container
+     */
+    static String compress(
+        const StringView           data,
+        const CompressionSettings& settings = {},
+        parallel::ThreadPool&      pool     = parallel::ThreadPool::global()
+    );
+    /**
+     * @brief Decompress whole container created by `compress` (or
+     * `CompressionSink`). Blocks are decompressed in parallel.
+     *
+     * @param data Compressed container
+     * @param pool Pool used for parallel decompression
+     * @return String Original data
+     * @throw RuntimeError If data isn't a valid container
+     */
+    static Result<String, RuntimeError> decompress(
+        const StringView      data,
+        parallel::ThreadPool& pool = parallel::ThreadPool::global()
+    );
+    /**
+     * @brief True if @p data starts with compressed container header
+     */
+    static bool is_compressed(const StringView data);
+
+    /**
+     * @brief Compress single block of data, appending it to @p out as it is
+     * stored in a container (method byte and payload)
+     *
+     * @param data Block data
+     * @param size Size of block data in bytes
+     * @param entropy Whether to try Huffman coding of LZ output
+     * @param out Output to which block is appended
+     */
+    static void compress_block(
+        const byte* const data,
+        const uint64      size,
+        const bool        entropy,
+        String&           out
+    );
+    /**
+     * @brief Decompress single block written by `compress_block`
+     *
+     * @param block Block data (method byte and payload)
+     * @param block_size Size of block data in bytes
+     * @param out Output memory for the original data
+     * @param size Exact size of the original data
+     * @return Outcome Failed if block is malformed or of different size
+     */
+    static Outcome decompress_block(
+        const byte* const block,
+        const uint64      block_size,
+        byte* const       out,
+        const uint64      size
+    );
+};
+
+/**
+ * @brief Random access reader of compressed container. Validates container
+ * index on open, after which any range of original data can be read, by
+ * decompressing only the blocks covering it. Doesn't own container data
+ * (ex. `MappedFile`), which must outlive it.
+ */
+class CompressedReader {
+  public:
+    CompressedReader() {}
+
+    /**
+     * @brief Open compressed container
+     *
+     * @param data Compressed container
+     * @return CompressedReader Reader of the container
+     * @throw RuntimeError If data isn't a valid container
+     */
+    static Result<CompressedReader, RuntimeError> open(const StringView data);
+
+    /// @brief Size of the original data
+    uint64 size() const { return _size; }
+    /// @brief Number of blocks in the container
+    uint64 block_count() const { return _block_count; }
+    /// @brief Size of original data of each block (except the last one)
+    uint64 block_size() const { return _block_size; }
+
+    /**
+     * @brief Decompress block at @p index into @p out
+     *
+     * @param index Index of the block
+     * @param out Output memory, of at least `block_size` bytes
+     * @return uint64 Size of decompressed data
+     * @throw RuntimeError If block is malformed
+     */
+    Result<uint64, RuntimeError> read_block(
+        const uint64 index, byte* const out
+    ) const;
+    /**
+     * @brief Read @p size bytes of original data, starting at @p offset
+     *
+     * @param offset Offset in the original data
+     * @param size Number of bytes to read
+     * @return String Read data
+     * @throw RuntimeError If range is out of bounds or a block is malformed
+     */
+    Result<String, RuntimeError> read(
+        const uint64 offset, const uint64 size
+    ) const;
+    /**
+     * @brief Read whole original data, decompressing blocks in parallel
+     *
+     * @param pool Pool used for parallel decompression
+     * @return String Original data
+     * @throw RuntimeError If a block is malformed
+     */
+    Result<String, RuntimeError> read_all(
+        parallel::ThreadPool& pool = parallel::ThreadPool::global()
+    ) const;
+
+  private:
+    const byte* _data        = nullptr;
+    uint64      _size        = 0;
+    uint64      _block_size  = 0;
+    uint64      _block_count = 0;
+    // Offset of the index, which also ends the last block
+    uint64      _index       = 0;
+
+    // Range of compressed block at index in container
+    uint64 block_begin(const uint64 index) const;
+    uint64 block_end(const uint64 index) const;
+};
+
+/**
+ * @brief Sink compressing written data into a block framed container (see
+ * `Compression`), written into another sink (ex. `StreamSink` of a file).
+ * Data is collected in a block sized window, and each full block is
+ * compressed and passed on. Remaining data, block index and footer are
+ * written by `finish`, which is also called on destruction.
+ */
+class CompressionSink : public SerializationSink {
+  public:
+    /**
+     * @brief Construct a new Compression Sink object
+     *
+     * @param target Sink receiving compressed container. Must outlive this
+     * sink.
+     * @param settings Compression settings
+     */
+    explicit CompressionSink(
+        SerializationSink& target, const CompressionSettings& settings = {}
+    );
+    ~CompressionSink() override;
+
+    /**
+     * @brief Compress remaining data and complete the container. Nothing may
+     * be written afterwards.
+     */
+    void finish();
+
+    /// @brief Pass on all compressed blocks. Partially filled block is only
+    /// compressed by `finish`.
+    void flush() override { _target.flush(); }
+
+  protected:
+    bool make_room(const uint64 size) override;
+    void write_through(const void* const data, const uint64 size) override;
+
+  private:
+    SerializationSink&  _target;
+    CompressionSettings _settings;
+    String              _block {};
+    String              _compressed {};
+    // Offsets of written blocks, as stored in the index
+    String              _index {};
+    uint64              _written  = 0;
+    bool                _finished = false;
+
+    void write_block();
+};
+
+} // namespace CORE_NAMESPACE
@@ -0,0 +1,60 @@
+/**
+ * @file framed_binary_serializer.hpp
+ * @author Android172 (android172unity@gmail.com)
+ * @brief Defines binary serializer with self describing, skippable fields
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+
+#include "compact_binary_serializer.hpp"
+
+namespace CORE_NAMESPACE {
+
+/**
+ * @brief Compact binary serializer writing each attribute as a self
+ * describing field: varint field ID (1-based position in the attribute
+ * list), varint size in bytes, then the value encoded as with
+ * `CompactBinarySerializer`. Fields of an object are followed by a zero byte
+ * (ID 0), which ends the object.
+ *
+ * Since every field can be skipped without decoding it, readers ignore
+ * fields they don't know and keep attributes missing from data unchanged.
+ * Objects stay readable when attributes are appended to them, by both older
+ * and newer code. Single fields can also be read from a large object without
+ * decoding the rest (see `Serializer::deserialize_field`), and sub-objects
+ * can be decoded lazily (see `Lazy`).
+ *
+ * Values are encoded before their field header, to learn their size, so
+ * nested objects are copied once per nesting level.
+ */
+class FramedBinarySerializer : public CompactBinarySerializer {
+  public:
+    /**
+     * @brief Construct a new Framed Binary Serializer object
+     *
+     * @param wire_endianness Byte order of serialized floating point values
+     */
+    FramedBinarySerializer(
+        const Endianness wire_endianness = Endianness::Little
+    )
+        : CompactBinarySerializer(wire_endianness) {}
+
+  protected:
+    virtual void object_add_end(SerializationSink& out) const override;
+
+    virtual bool has_field_framing() const override { return true; }
+    virtual void field_add_header(
+        SerializationSink& out, const uint64 id, const uint64 size
+    ) const override;
+    virtual Outcome field_remove_header(
+        const String& in_str, uint64& id, uint64& size, uint64& position
+    ) const override;
+
+    virtual uint8 format_id() const override { return 3; }
+};
+
+} // namespace CORE_NAMESPACE
@@ -0,0 +1,138 @@
+/**
+ * @file incremental_decoder.hpp
+ * @author Android172 (android172unity@gmail.com)
+ * @brief Defines decoder of serialized objects arriving in chunks
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+
+#include "serializer.hpp"
+
+#include <istream>
+
+namespace CORE_NAMESPACE {
+
+/**
+ * @brief Decodes a stream of serialized objects (ex. written one after
+ * another into a `StreamSink`) which is available only in pieces, such as
+ * reads from a socket or a large file. Input is fed in chunks of any size;
+ * once an object is complete, `next` decodes it and its bytes are released.
+ * Only the unconsumed part of the stream is kept in memory, and all stream
+ * positions are 64 bit.
+ *
+ * Serialized objects don't record their size, so completeness is found by
+ * trying to decode. Failed attempts are only repeated once buffered input
+ * doubles (or the stream ends), so decoding stays linear in stream size. As
+ * a consequence malformed input is only reported as such once the stream is
+ * finished; until then it's treated as incomplete.
+ */
+class IncrementalDecoder {
+  public:
+    /// @brief Default size of chunks read by `read_from`
+    static const constexpr uint64 default_chunk_size = 1024 * 1024;
+
+    /**
+     * @brief Construct a new Incremental Decoder object
+     *
+     * @param serializer Serializer used for deserialization. Must outlive
+     * the decoder.
+     * @param has_header If true, stream starts with serializer's header
+     * (see `Serializer::write_header`), which is verified before the first
+     * object
+     */
+    IncrementalDecoder(
+        const Serializer* const serializer, const bool has_header = true
+    );
+    ~IncrementalDecoder() {}
+
+    /**
+     * @brief Append next chunk of the stream
+     *
+     * @param data Chunk data
+     * @param size Chunk size in bytes
+     */
+    void feed(const void* const data, const uint64 size);
+    /**
+     * @brief Append next chunk of the stream, read from @p stream
+     *
+     * @param stream Input stream (ex. `BinaryIn` file)
+     * @param chunk_size Maximum number of bytes read
+     * @return uint64 Number of bytes read; 0 at the end of the stream
+     */
+    uint64 read_from(
+        std::istream& stream, const uint64 chunk_size = default_chunk_size
+    );
+    /**
+     * @brief Mark the end of the stream. After this, incomplete input is
+     * reported as an error.
+     */
+    void finish() { _finished = true; }
+
+    /**
+     * @brief Decode next object, if all of its bytes were fed.
+     *
+     * @tparam T Object type. Any serializable type.
+     * @param object Decoded object
+     * @return true If object was decoded
+     * @return false If more input is needed first, or the stream is finished
+     * and fully consumed
+     * @throw RuntimeError If input is malformed
+     */
+    template<typename T>
+    Result<bool, RuntimeError> next(T& object) {
+        if (!_header_read) {
+            const auto header = try_read_header();
+            if (header.has_error()) return Failure(header.error());
+            if (!header.value()) return false;
+        }
+        if (_read == _buffer.size() || !should_attempt()) return false;
+
+        const auto result = decode(object);
+        if (result.has_error()) return attempt_failed(result.error());
+        consume(result.value());
+        return true;
+    }
+
+    /// @brief True if stream was finished and all of it was decoded
+    bool done() const {
+        return _finished && _header_read && _read == _buffer.size();
+    }
+    /// @brief Position in the stream of the next object to decode
+    uint64 position() const { return _offset + _read; }
+    /// @brief Number of fed bytes not yet decoded
+    uint64 buffered() const { return _buffer.size() - _read; }
+
+  private:
+    const Serializer* _serializer;
+    // Unconsumed input starts at _read. _offset is stream position of the
+    // buffer start.
+    String            _buffer {};
+    uint64            _read        = 0;
+    uint64            _offset      = 0;
+    // Next decode attempt is made once buffered input reaches this size
+    uint64            _attempt_at  = 0;
+    bool              _header_read = false;
+    bool              _finished    = false;
+
+    bool should_attempt() const {
+        return _finished || buffered() >= _attempt_at;
+    }
+
+    template<typename T>
+    Result<uint64, RuntimeError> decode(T& object) const {
+        if constexpr (std::is_base_of_v<Serializable, T>)
+            return object.deserialize(_serializer, _buffer, _read);
+        else return _serializer->deserialize(_buffer, _read, object);
+    }
+
+    Result<bool, RuntimeError> try_read_header();
+    Result<bool, RuntimeError> attempt_failed(const RuntimeError& error);
+    void                       compact();
+    void                       consume(const uint64 size);
+};
+
+} // namespace CORE_NAMESPACE
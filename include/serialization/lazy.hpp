@@ -0,0 +1,116 @@
+/**
+ * @file lazy.hpp
+ * @author Android172 (android172unity@gmail.com)
+ * @brief Defines lazily deserialized attribute wrapper
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+
+#include "serializer.hpp"
+#include "logger.hpp"
+
+namespace CORE_NAMESPACE {
+
+/**
+ * @brief Serializable attribute whose value is decoded only once it's first
+ * accessed. Value is serialized as a separate document, stored as a string,
+ * so deserialization only copies its bytes; skipping it costs nothing more.
+ * Used for large sub-objects which are often not needed (ex. with
+ * `FramedBinarySerializer`, where other fields can be read directly).
+ *
+ * Until accessed, value is kept encoded, together with the serializer which
+ * read it; that serializer must outlive this object. If serialized again
+ * with the same serializer, encoded value is written back without decoding.
+ * With other serializer it's converted, which is fatal if encoded value is
+ * malformed (use `get` first to handle such error).
+ *
+ * @tparam T Type of the value. Must be serializable.
+ */
+template<typename T>
+class Lazy : public Serializable {
+  public:
+    Lazy() {}
+    Lazy(const T& value) : _value(value), _decoded(true) {}
+    Lazy(T&& value) : _value(std::move(value)), _decoded(true) {}
+    ~Lazy() {}
+
+    /// @brief True if value is available without decoding
+    bool is_decoded() const { return _decoded; }
+
+    /**
+     * @brief Get the value, decoding it on first access
+     * @return T* Value, valid while this object is alive
+     * @throw RuntimeError If encoded value couldn't be deserialized
+     */
+    Result<T*, RuntimeError> get() {
+        if (!_decoded) {
+            const auto result = _serializer->deserialize(_encoded, 0, _value);
+            if (result.has_error()) return Failure(result.error());
+            _decoded = true;
+            _encoded = String();
+        }
+        return &_value;
+    }
+
+    /**
+     * @brief Replace the value, discarding encoded one
+     */
+    void set(T value) {
+        _value   = std::move(value);
+        _decoded = true;
+        _encoded = String();
+    }
+
+    virtual String serialize(const Serializer* const serializer
+    ) const override {
+        BufferSink sink {};
+        serialize_to(sink, serializer);
+        return sink.take();
+    }
+    virtual void serialize_to(
+        SerializationSink& sink, const Serializer* const serializer
+    ) const override {
+        if (!_decoded && serializer == _serializer)
+            return serializer->serialize_to(sink, _encoded);
+        if (_decoded) {
+            const auto encoded = serializer->serialize(_value);
+            return serializer->serialize_to(sink, encoded);
+        }
+
+        // Encoded by other serializer, so it's converted. Value which can't be
+        // decoded has nothing to convert, and default one mustn't be written
+        // in its place; since serialization can't fail, it's fatal.
+        T          value {};
+        const auto result = _serializer->deserialize(_encoded, 0, value);
+        if (result.has_error())
+            Logger::fatal(
+                "Lazy :: Encoded value can't be converted to other format: ",
+                result.error().what()
+            );
+        const auto encoded = serializer->serialize(value);
+        serializer->serialize_to(sink, encoded);
+    }
+    virtual Result<uint64, RuntimeError> deserialize(
+        const Serializer* const serializer,
+        const String&           data,
+        const uint64            from_pos = 0
+    ) override {
+        const auto result = serializer->deserialize(data, from_pos, _encoded);
+        if (result.has_error()) return Failure(result.error());
+        _serializer = serializer;
+        _decoded    = false;
+        return result;
+    }
+
+  private:
+    T                 _value {};
+    bool              _decoded    = true;
+    String            _encoded {};
+    const Serializer* _serializer = nullptr;
+};
+
+} // namespace CORE_NAMESPACE
@@ -0,0 +1,332 @@
+/**
+ * @file record_log.hpp
+ * @author Android172 (android172unity@gmail.com)
+ * @brief Defines append only log of checksummed serialized records
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+
+#include "serializer.hpp"
+#include "files/file_system.hpp"
+#include "files/file_types.hpp"
+#include "files/mapped_file.hpp"
+#include "multithreading/parallel.hpp"
+
+namespace CORE_NAMESPACE {
+
+/**
+ * @brief Policy by which a record log syncs committed data to the storage
+ * device (see `platform::sync_file`)
+ */
+enum class LogSync {
+    /// @brief Data is never synced explicitly; system writes it out
+    /// eventually. Committed records can be lost on power loss (but not on
+    /// process crash).
+    Never,
+    /// @brief Every commit is synced before it returns. Committed records
+    /// are durable.
+    OnCommit,
+    /// @brief Commit is synced only if enough time passed since the last
+    /// sync. Bounds the time span of records which can be lost.
+    Interval
+};
+
+/**
+ * @brief Settings of record log writer
+ */
+struct RecordLogSettings {
+    /// @brief Appended records are collected in memory and written
+    /// together, once their total size reaches this many bytes (or on an
+    /// explicit commit)
+    uint64  commit_size    = 64 * KB;
+    /// @brief When committed data is synced to the storage device
+    LogSync sync           = LogSync::OnCommit;
+    /// @brief Minimum time between syncs in seconds, with `LogSync::Interval`
+    float64 sync_interval  = 1.0;
+    /// @brief Every n-th record is added to the sparse index, used for
+    /// seeking. Index isn't written if 0.
+    uint64  index_interval = 0;
+};
+
+/**
+ * @brief Append only log of serialized records (ex. an event journal). Each
+ * record is a separately serialized object, stored in a frame with its size
+ * and CRC32C checksum. Records are written in batches (see
+ * `RecordLogWriter`) and read sequentially (see `RecordLogReader`).
+ *
+ * A crash can leave the last frames partially written (a torn tail). Reader
+ * recognizes this by frame size or checksum, and stops at the last complete
+ * record; writer cuts such tail off before appending. Damage followed by an
+ * intact frame isn't a torn tail, so writer refuses to open such log.
+ *
+ * Log layout (all integers little endian):
+ *  - header: magic "RLOG", version, 3 reserved bytes
+ *  - header frame: serializer's header (see `Serializer::write_header`)
+ *  - record frames: 4 byte payload size, 4 byte checksum of size and
+ *    payload, payload
+ *
+ * Sparse index is kept in a separate file (see `index_path`) of 16 byte
+ * entries: 8 byte record number and 8 byte offset of its frame. It's only a
+ * hint; log itself is never read through it without verifying checksums.
+ */
+class RecordLog {
+  public:
+    /// @brief Size of log header
+    static const constexpr uint64 header_size       = 8;
+    /// @brief Size of frame header (payload size and checksum)
+    static const constexpr uint64 frame_header_size = 8;
+    /// @brief Size of single sparse index entry
+    static const constexpr uint64 index_entry_size  = 16;
+    /// @brief Maximum size of single record
+    static const constexpr uint64 max_record_size   = uint32_max;
+
+    /**
+     * @brief Compute CRC32C (Castagnoli) checksum of @p data
+     *
+     * @param data Data to checksum
+     * @param size Size of the data in bytes
+     * @param crc Checksum of preceding data, to continue from
+     * @return uint32 Checksum
+     */
+    static uint32 checksum(
+        const byte* const data, const uint64 size, const uint32 crc = 0
+    );
+
+    /// @brief Path of sparse index file belonging to log at @p log_path
+    static Path index_path(const Path& log_path) {
+        return Path(log_path.string() + ".idx");
+    }
+};
+
+/**
+ * @brief Writer appending records to a log (see `RecordLog`). Appended
+ * records are framed right away, but collected in memory; once a batch is
+ * full (or `commit` is called) it's written to the file with a single write,
+ * and synced according to the settings. Appending is thread safe: records
+ * are serialized without holding any lock, and while one thread commits a
+ * batch, others keep filling the next one.
+ *
+ * Opening an existing log continues it, after cutting off any torn tail.
+ * Remaining batch is committed and synced on destruction.
+ *
+ * If writing a batch fails, its partially written data is cut off and the
+ * writer fails every further append and commit. Records of the failed batch,
+ * and those appended after it, are lost. Failed sync fails the writer the
+ * same way, though data it already wrote stays in the log.
+ */
+class RecordLogWriter {
+  public:
+    /**
+     * @brief Open log at @p file_path for appending. Log is created if it
+     * doesn't exist.
+     *
+     * @param file_path Log file path
+     * @param serializer Serializer of records. Must outlive the writer, and
+     * be of the same type as one which created the log.
+     * @param settings Writer settings
+     * @return RecordLogWriter Opened writer
+     * @throw RuntimeError If file can't be opened, isn't a record log of
+     * this serializer, or is corrupted in the middle
+     */
+    static Result<std::unique_ptr<RecordLogWriter>, RuntimeError> open(
+        const Path&              file_path,
+        const Serializer* const  serializer,
+        const RecordLogSettings& settings = {}
+    );
+    ~RecordLogWriter();
+
+    RecordLogWriter(const RecordLogWriter&)            = delete;
+    RecordLogWriter& operator=(const RecordLogWriter&) = delete;
+
+    /**
+     * @brief Append one record, made of given attribute list serialized as
+     * one object. Commits current batch if it became full.
+     *
+     * @tparam T Variable length list of attribute types. All attributes
+     * listed must be serializable.
+     * @param data Variable length list of attributes as parameters.
+     * @throw RuntimeError If record is too large, commit failed or writer
+     * failed earlier
+     */
+    template<typename... T>
+    Result<void, RuntimeError> append(const T&... data) {
+        auto& record = scratch();
+        record.clear();
+        _serializer->serialize_to(record, data...);
+        const auto result = add_frame(record.data(), record.size());
+        release_scratch();
+        return result;
+    }
+
+    /**
+     * @brief Write all appended records to the file, syncing them if
+     * required by the sync policy
+     * @throw RuntimeError If writing or syncing failed, or writer failed
+     * earlier
+     */
+    Result<void, RuntimeError> commit();
+    /**
+     * @brief Write all appended records to the file and sync them,
+     * regardless of the sync policy
+     * @throw RuntimeError If writing or syncing failed, or writer failed
+     * earlier
+     */
+    Result<void, RuntimeError> sync();
+
+    /// @brief Number of records in the log, including uncommitted ones
+    uint64 record_count() const {
+        std::lock_guard<parallel::Mutex> lock { _batch_lock };
+        return _records;
+    }
+    /// @brief Size of the log in bytes, including uncommitted records
+    uint64 size() const {
+        std::lock_guard<parallel::Mutex> lock { _batch_lock };
+        return _size;
+    }
+
+  private:
+    Path                             _path;
+    const Serializer*                _serializer;
+    RecordLogSettings                _settings;
+    std::unique_ptr<File<BinaryOut>> _file {};
+    std::unique_ptr<File<BinaryOut>> _index_file {};
+
+    // Batch being filled. Guarded by `_batch_lock`.
+    mutable parallel::Mutex _batch_lock {};
+    String                  _batch {};
+    String                  _index_batch {};
+    uint64                  _size    = 0;
+    uint64                  _records = 0;
+    bool                    _failed  = false;
+
+    // Batch being written. Guarded by `_commit_lock`.
+    parallel::Mutex _commit_lock {};
+    String          _committing {};
+    String          _committing_index {};
+    uint64          _committed = 0;
+    float64         _last_sync = 0;
+    bool            _unsynced  = false;
+
+    RecordLogWriter(
+        const Path&              file_path,
+        const Serializer* const  serializer,
+        const RecordLogSettings& settings
+    );
+
+    Result<void, RuntimeError> create();
+    Result<void, RuntimeError> recover();
+    Result<void, RuntimeError> add_frame(
+        const byte* const payload, const uint64 size
+    );
+    Result<void, RuntimeError> write_batch(const bool force_sync);
+    void                       fail();
+    Failure<RuntimeError>      failed_error() const;
+
+    // Per thread buffer records are serialized into
+    static BufferSink& scratch();
+    static void        release_scratch();
+};
+
+/**
+ * @brief Sequential reader of a log (see `RecordLog`). Log file is mapped
+ * into memory, and records are verified and decoded one after another.
+ * Reading stops cleanly at the end of the last complete record; if any
+ * bytes follow it (a torn tail), `torn` is set. Records appended after the
+ * log was opened aren't visible. Move only.
+ */
+class RecordLogReader {
+  public:
+    RecordLogReader() {}
+
+    /**
+     * @brief Open log at @p file_path for reading. Sparse index is loaded,
+     * if present.
+     *
+     * @param file_path Log file path
+     * @param serializer Serializer of records. Must outlive the reader, and
+     * be of the same type as one which created the log.
+     * @return RecordLogReader Reader positioned at the first record
+     * @throw RuntimeError If file can't be opened, or isn't a record log of
+     * this serializer
+     */
+    static Result<RecordLogReader, RuntimeError> open(
+        const Path& file_path, const Serializer* const serializer
+    );
+
+    /**
+     * @brief Decode next record
+     *
+     * @tparam T Variable length list of attribute types, as appended
+     * @param data Decoded attributes
+     * @return true If record was decoded
+     * @return false If there are no more complete records
+     * @throw RuntimeError If record is intact, but couldn't be decoded into
+     * given attributes. Reader still moves past it.
+     */
+    template<typename... T>
+    Result<bool, RuntimeError> next(T&... data) {
+        if (!next_frame()) return false;
+        _payload.assign(_frame);
+        const auto read = _serializer->deserialize(_payload, 0, data...);
+        if (read.has_error()) return Failure(read.error());
+        if (read.value() != _payload.size())
+            return Failure("Record wasn't fully decoded");
+        return true;
+    }
+    /**
+     * @brief Move past next record without decoding it (only its checksum
+     * is verified)
+     * @return true If record was skipped
+     * @return false If there are no more complete records
+     */
+    bool skip() { return next_frame(); }
+    /**
+     * @brief Position reader at record with given number. Closest preceding
+     * record of the sparse index is found first, so only records after it
+     * are skipped.
+     *
+     * @param record Number of the record (0 is the first one). Number of
+     * records in the log positions reader after the last one.
+     * @throw RuntimeError If log doesn't contain the record
+     */
+    Result<void, RuntimeError> seek(const uint64 record);
+
+    /// @brief Number of the next record
+    uint64 record() const { return _record; }
+    /// @brief Offset of the next record's frame. After the last record, it's
+    /// the size of the intact part of the log.
+    uint64 position() const { return _position; }
+    /// @brief True if reading stopped at incomplete or corrupted data
+    bool   torn() const { return _torn; }
+    /// @brief True if sparse index was loaded
+    bool   has_index() const { return !_index.empty(); }
+
+  private:
+    struct IndexEntry {
+        uint64 record;
+        uint64 offset;
+    };
+
+    MappedFile         _file {};
+    const Serializer*  _serializer = nullptr;
+    Vector<IndexEntry> _index {
+        TAllocator<IndexEntry>(BaseMemoryTags.Unknown)
+    };
+    // Offset of the first record frame
+    uint64             _start    = 0;
+    uint64             _position = 0;
+    uint64             _record   = 0;
+    bool               _torn     = false;
+    // Payload of the last read frame
+    StringView         _frame {};
+    String             _payload {};
+
+    bool next_frame();
+    void load_index(const Path& index_path);
+};
+
+} // namespace CORE_NAMESPACE
@@ -16,11 +16,17 @@
 #include "files/path.hpp"
 #include "result.hpp"
 #include "string.hpp"
+#include "serialization_sink.hpp"
+
+#include <tuple>
 
 namespace CORE_NAMESPACE {
 class String;
 class Serializer;
 class RuntimeError;
+struct CompressionSettings;
+template<typename Tp>
+class Vector;
 
 /**
  * @brief An abstract class that provides an interface for objects to be
@@ -55,6 +61,25 @@ class Serializable {
      * @return String Object representing the serialized data.
      */
     virtual String serialize(const Serializer* const serializer) const = 0;
+    /**
+     * @brief Writes the object in serialized format directly into @p sink,
+     * using the provided serializer. Used for nested objects, so their data
+     * goes straight into the parent's output.
+     *
+     * Default implementation copies result of `serialize` into the sink.
+     * Objects using `serializable_attributes` macro override it and write
+     * their attributes directly.
+     *
+     * @param sink Output sink
+     * @param serializer A pointer to a Serializer object used for
+     * serialization.
+     */
+    virtual void serialize_to(
+        SerializationSink& sink, const Serializer* const serializer
+    ) const {
+        const auto data = serialize(serializer);
+        sink.write(data.data(), data.size());
+    }
     /**
      * @brief Restores the object's original state by deserializing the data
      * using the provided serializer.
@@ -79,18 +104,19 @@ class Serializable {
      * @param data The String object containing the serialized data.
      * @param from_pos The optional starting position for deserialization
      * (default is 0).
-     * @return uint32 The position after deserialization
+     * @return uint64 The position after deserialization
      * @throw RuntimeError If deserialization failed
      */
-    virtual Result<uint32, RuntimeError> deserialize(
+    virtual Result<uint64, RuntimeError> deserialize(
         const Serializer* const serializer,
         const String&           data,
-        const uint32            from_pos = 0
+        const uint64            from_pos = 0
     ) = 0;
 
     /**
-     * @brief Converts object into serialized format and saves it to a file.
-     * Uses `serialize` method internally.
+     * @brief Converts object into serialized format and saves it to a file,
+     * after serializer's header. Uses `serialize_to` method internally,
+     * writing through a small buffer.
      *
      * @param file_path Path of output file
      * @param serializer A pointer to a Serializer object used for
@@ -99,43 +125,39 @@ class Serializable {
      */
     Result<void, RuntimeError> serialize_to_file(
         const Path& file_path, const Serializer* const serializer
-    ) const {
-        // Open file
-        auto result = FileSystem::create_or_open<TextOut>(file_path);
-        if (result.has_error()) return Failure(result.error());
-        const auto file { std::move(result.value()) };
-
-        // Write all data
-        const auto str = this->serialize(serializer);
-        file->write(str);
-
-        // Close file
-        file->close();
-        return {};
-    }
+    ) const;
+    /**
+     * @brief Converts object into serialized format and saves it to a file
+     * compressed (see `Compression`), after serializer's header. Serialized
+     * data is compressed block by block while being written.
+     *
+     * @param file_path Path of output file
+     * @param serializer A pointer to a Serializer object used for
+     * serialization.
+     * @param compression Compression settings
+     * @throw RuntimeError If file can not be opened or created.
+     */
+    Result<void, RuntimeError> serialize_to_file(
+        const Path&                file_path,
+        const Serializer* const    serializer,
+        const CompressionSettings& compression
+    ) const;
 
     /**
      * @brief Restores the object's original state by deserializing the data
-     * from file. Uses `deserialize` method internally.
+     * from file, after verifying serializer's header. Uses `deserialize`
+     * method internally. Compressed files are detected and decompressed, in
+     * parallel, before deserialization.
      *
      * @param file_path Input file's path
      * @param serializer A pointer to a Serializer object used for
      * deserialization.
-     * @return uint32 The position after deserialization
+     * @return uint64 The position after deserialization
      * @throw RuntimeError If file read or deserialization fails
      */
-    Result<uint32, RuntimeError> deserialize_from_file(
+    Result<uint64, RuntimeError> deserialize_from_file(
         const Path& file_path, const Serializer* const serializer
-    ) {
-        // Read file
-        auto result = FileSystem::open<TextIn>(file_path);
-        if (result.has_error()) return Failure(result.error());
-        const auto file { std::move(result.value()) };
-
-        // Deserialize read data
-        const auto data = file->read_all();
-        return this->deserialize(serializer, data, 0);
-    }
+    );
 };
 
 /**
@@ -158,6 +180,24 @@ String serialize_object(const T& obj, const Serializer* const serializer) {
     );
 }
 
+/**
+ * Serializes an object of type @b T directly into @p sink. By default copies
+ * result of `serialize_object` into the sink. Specializing this function
+ * instead avoids creation of the intermediate String.
+ *
+ * @tparam T The type of the object to be serialized.
+ * @param obj The object to be serialized.
+ * @param serializer The serializer to be used for serialization.
+ * @param sink Output sink
+ */
+template<typename T>
+void serialize_object(
+    const T& obj, const Serializer* const serializer, SerializationSink& sink
+) {
+    const auto data = serialize_object(obj, serializer);
+    sink.write(data.data(), data.size());
+}
+
 /**
  * Deserializes an object of type @b T using the provided serializer and data.
  * This function is useful for external types which cannot be made serializable
@@ -171,15 +211,15 @@ String serialize_object(const T& obj, const Serializer* const serializer) {
  * @param data The data to be deserialized.
  * @param from_pos The starting position in the data for deserialization
  * (default: 0).
- * @return uint32 The position after deserialization
+ * @return uint64 The position after deserialization
  * @throw RuntimeError If deserialization failed
  */
 template<typename T>
-Result<uint32, RuntimeError> deserialize_object(
+Result<uint64, RuntimeError> deserialize_object(
     T&                      obj,
     const Serializer* const serializer,
     const String&           data,
-    const uint32            from_pos = 0
+    const uint64            from_pos = 0
 ) {
     static_assert(
         std::is_same_v<T, void>,
@@ -187,17 +227,106 @@ Result<uint32, RuntimeError> deserialize_object(
     );
 }
 
+namespace __detail__ {
+    /**
+     * @brief Gives serialization code access to compile-time field lists of
+     * serializable objects, generated by `serializable_attributes` macro.
+     * Fields are listed as a tuple of references, in serialization order.
+     */
+    struct SerializableFields {
+        template<typename T>
+        static auto of(const T& object) {
+            return object.serializable_fields();
+        }
+        template<typename T>
+        static auto of(T& object) {
+            return object.serializable_fields();
+        }
+
+        /// @brief True if type @b T has a compile-time field list
+        template<typename T, typename = void>
+        struct exist : std::false_type {};
+        template<typename T>
+        struct exist<
+            T,
+            std::void_t<decltype(std::declval<const T&>().serializable_fields()
+            )>> : std::true_type {};
+
+        /// @brief Tuple of const references to fields of type @b T
+        template<typename T>
+        using List = decltype(of(std::declval<const T&>()));
+        /// @brief Number of fields of type @b T
+        template<typename T>
+        static const constexpr uint64 count = std::tuple_size_v<List<T>>;
+        /// @brief Type of @b I -th field of type @b T
+        template<typename T, uint64 I>
+        using Type = std::decay_t<std::tuple_element_t<I, List<T>>>;
+        /// @brief Sequence of field indices of type @b T
+        template<typename T>
+        using Indices = std::make_integer_sequence<uint64, count<T>>;
+    };
+
+    // Attribute types stored by value
+    template<typename T>
+    static const constexpr bool is_scalar_attribute =
+        std::is_same_v<T, bool> || std::is_same_v<T, char> ||
+        std::is_same_v<T, int8> || std::is_same_v<T, int16> ||
+        std::is_same_v<T, int32> || std::is_same_v<T, int64> ||
+        std::is_same_v<T, int128> || std::is_same_v<T, uint8> ||
+        std::is_same_v<T, uint16> || std::is_same_v<T, uint32> ||
+        std::is_same_v<T, uint64> || std::is_same_v<T, uint128> ||
+        std::is_same_v<T, float32> || std::is_same_v<T, float64>;
+    template<typename T>
+    static const constexpr bool is_string_attribute =
+        std::is_same_v<T, String> || std::is_same_v<T, StringView>;
+    template<typename T>
+    struct is_vector_attribute : std::false_type {};
+    template<typename T>
+    struct is_vector_attribute<Vector<T>> : std::true_type {};
+
+    /// @brief True if encoding of type @b T takes at least one byte, which
+    /// only objects with all fields possibly empty don't. Used to reject
+    /// element counts which can't fit into remaining input, before
+    /// allocating.
+    template<typename T>
+    constexpr bool is_never_empty();
+    template<typename T, uint64... I>
+    constexpr bool fields_never_empty(std::integer_sequence<uint64, I...>) {
+        return (
+            false || ... || is_never_empty<SerializableFields::Type<T, I>>()
+        );
+    }
+    template<typename T>
+    constexpr bool is_never_empty() {
+        if constexpr (!SerializableFields::exist<T>::value) return true;
+        else
+            return fields_never_empty<T>(SerializableFields::Indices<T>());
+    }
+} // namespace __detail__
+
+// Besides (de)serialization methods, also defines compile-time list of
+// attributes, used by serialized views (see `SerializedView`)
 #define serializable_attributes(attributes...)                                 \
     virtual String serialize(const Serializer* const serializer)               \
         const override {                                                       \
         return serializer->serialize(attributes);                              \
     }                                                                          \
-    virtual Result<uint32, RuntimeError> deserialize(                          \
+    virtual void serialize_to(                                                 \
+        SerializationSink& sink, const Serializer* const serializer            \
+    ) const override {                                                         \
+        serializer->serialize_to(sink, attributes);                            \
+    }                                                                          \
+    virtual Result<uint64, RuntimeError> deserialize(                          \
         const Serializer* const serializer,                                    \
         const String&           data,                                          \
-        const uint32            from_pos = 0                                   \
+        const uint64            from_pos = 0                                   \
     ) override {                                                               \
         return serializer->deserialize(data, from_pos, attributes);            \
-    }
+    }                                                                          \
+    auto serializable_fields() const {                                         \
+        return std::forward_as_tuple(attributes);                              \
+    }                                                                          \
+    auto serializable_fields() { return std::forward_as_tuple(attributes); }   \
+    friend struct CORE_NAMESPACE::__detail__::SerializableFields;
 
 } // namespace CORE_NAMESPACE
\ No newline at end of file
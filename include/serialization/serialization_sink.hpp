@@ -0,0 +1,243 @@
+/**
+ * @file serialization_sink.hpp
+ * @author Android172 (android172unity@gmail.com)
+ * @brief Defines output sinks serializers write into
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+
+#include "string.hpp"
+
+#include <cstring>
+#include <ostream>
+
+namespace CORE_NAMESPACE {
+
+/**
+ * @brief Destination of serialized bytes. Sink exposes a window of writable
+ * memory, so writes which fit into it are a single copy, without any virtual
+ * call or allocation. Only once the window is exhausted does the concrete
+ * sink get involved, to provide a new window (by growing its buffer or
+ * flushing it) or to take over the data directly.
+ */
+class SerializationSink {
+  public:
+    SerializationSink() {}
+    virtual ~SerializationSink() {}
+
+    SerializationSink(const SerializationSink&)            = delete;
+    SerializationSink& operator=(const SerializationSink&) = delete;
+
+    /**
+     * @brief Write @p size bytes from @p data
+     */
+    void write(const void* const data, const uint64 size) {
+        if (size > available() && !make_room(size))
+            return write_through(data, size);
+        std::memcpy(_cursor, data, size);
+        _cursor += size;
+    }
+    /**
+     * @brief Write single byte @p value
+     */
+    void put(const byte value) {
+        if (_cursor == _end && !make_room(1)) return write_through(&value, 1);
+        *_cursor++ = value;
+    }
+
+    /**
+     * @brief Get direct access to at least @p size writable bytes. Bytes
+     * actually written must be confirmed with `commit`, before any other
+     * write.
+     * @return byte* Start of writable memory, or nullptr if sink can't
+     * provide @p size contiguous bytes (`write` should be used instead)
+     */
+    byte* reserve(const uint64 size) {
+        if (size > available() && !make_room(size)) return nullptr;
+        return _cursor;
+    }
+    /**
+     * @brief Confirm that @p size bytes were written to reserved memory
+     */
+    void commit(const uint64 size) { _cursor += size; }
+
+    /// @brief Total number of bytes written to the sink
+    uint64 size() const { return _offset + (uint64) (_cursor - _begin); }
+
+    /// @brief Pass all written bytes on to the final destination (if any)
+    virtual void flush() {}
+
+  protected:
+    // Current window of writable memory
+    byte*  _begin  = nullptr;
+    byte*  _cursor = nullptr;
+    byte*  _end    = nullptr;
+    // Number of bytes written before current window
+    uint64 _offset = 0;
+
+    uint64 available() const { return (uint64) (_end - _cursor); }
+
+    /**
+     * @brief Provide window with at least @p size writable bytes
+     * @return true If window was provided
+     * @return false If it isn't possible
+     */
+    virtual bool make_room(const uint64 size) = 0;
+    /**
+     * @brief Take data which couldn't be placed into a window
+     */
+    virtual void write_through(const void* const data, const uint64 size) = 0;
+};
+
+/**
+ * @brief Sink writing into a growable, owned buffer. Buffer is kept when the
+ * sink is cleared, so a sink reused for many objects stops allocating once it
+ * reaches their size.
+ */
+class BufferSink : public SerializationSink {
+  public:
+    /**
+     * @brief Construct a new Buffer Sink object
+     *
+     * @param capacity Initial capacity of the buffer
+     */
+    explicit BufferSink(const uint64 capacity = 0) {
+        if (capacity != 0) grow(capacity);
+    }
+    ~BufferSink() override {}
+
+    /// @brief Written bytes
+    const byte* data() const { return _begin; }
+    /// @brief View of written bytes
+    StringView view() const { return { _begin, size() }; }
+    /// @brief Number of bytes which can be written without reallocation
+    uint64 capacity() const { return _buffer.size(); }
+
+    /// @brief Discard written bytes, keeping allocated buffer
+    void clear() { _cursor = _begin; }
+    /**
+     * @brief Move written bytes out of the sink as a String. Sink is left
+     * empty and without a buffer.
+     */
+    String take() {
+        _buffer.resize(size());
+        String result { std::move(_buffer) };
+        _buffer = String();
+        _begin = _cursor = _end = nullptr;
+        return result;
+    }
+
+  protected:
+    bool make_room(const uint64 size) override {
+        grow(size);
+        return true;
+    }
+    void write_through(const void* const data, const uint64 size) override {}
+
+  private:
+    String _buffer {};
+
+    void grow(const uint64 size) {
+        const auto used     = (uint64) (_cursor - _begin);
+        auto       capacity = std::max<uint64>(2 * _buffer.size(), 64);
+        while (capacity < used + size)
+            capacity *= 2;
+        _buffer.resize(capacity);
+        _begin  = _buffer.data();
+        _cursor = _begin + used;
+        _end    = _begin + capacity;
+    }
+};
+
+/**
+ * @brief Sink writing into fixed, caller provided memory. Never allocates.
+ * Data which doesn't fit is dropped and sink is marked as overflowed; its
+ * size still counts dropped bytes, so it tells the capacity required.
+ */
+class SpanSink : public SerializationSink {
+  public:
+    /**
+     * @brief Construct a new Span Sink object
+     *
+     * @param data Start of the target memory
+     * @param capacity Size of the target memory in bytes
+     */
+    SpanSink(void* const data, const uint64 capacity) {
+        _begin = _cursor = (byte*) data;
+        _end             = _begin + capacity;
+    }
+    ~SpanSink() override {}
+
+    /// @brief True if any of the written data didn't fit into the span
+    bool overflowed() const { return _overflowed; }
+
+  protected:
+    bool make_room(const uint64 size) override { return false; }
+    void write_through(const void* const data, const uint64 size) override {
+        _overflowed = true;
+        _offset += size;
+    }
+
+  private:
+    bool _overflowed = false;
+};
+
+/**
+ * @brief Sink writing into an output stream (ex. `BinaryOut` file), through
+ * a fixed inline buffer. Stream is only written to once the buffer fills up,
+ * on `flush` and on destruction.
+ */
+class StreamSink : public SerializationSink {
+  public:
+    /// @brief Size of the inline buffer
+    static const constexpr uint64 buffer_size = 4 * 1024;
+
+    /**
+     * @brief Construct a new Stream Sink object
+     *
+     * @param stream Output stream. Must outlive the sink.
+     */
+    explicit StreamSink(std::ostream& stream) : _stream(stream) {
+        _begin = _cursor = _buffer;
+        _end             = _buffer + buffer_size;
+    }
+    ~StreamSink() override { flush_buffer(); }
+
+    /// @brief Write buffered data and flush the stream
+    void flush() override {
+        flush_buffer();
+        _stream.flush();
+    }
+
+    /// @brief True if writing to the stream failed
+    bool failed() const { return _stream.fail(); }
+
+  protected:
+    bool make_room(const uint64 size) override {
+        flush_buffer();
+        return size <= buffer_size;
+    }
+    void write_through(const void* const data, const uint64 size) override {
+        flush_buffer();
+        _stream.write((const byte*) data, size);
+        _offset += size;
+    }
+
+  private:
+    std::ostream& _stream;
+    byte          _buffer[buffer_size];
+
+    void flush_buffer() {
+        const auto used = (uint64) (_cursor - _begin);
+        if (used == 0) return;
+        _stream.write(_begin, used);
+        _offset += used;
+        _cursor = _begin;
+    }
+};
+
+} // namespace CORE_NAMESPACE
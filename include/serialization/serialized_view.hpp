@@ -0,0 +1,554 @@
+/**
+ * @file serialized_view.hpp
+ * @author Android172 (android172unity@gmail.com)
+ * @brief Defines zero-copy, read only views over serialized data
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+
+#include "serializer.hpp"
+#include "container/vector.hpp"
+#include "platform/platform.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+
+namespace CORE_NAMESPACE {
+
+template<typename T>
+class SerializedView;
+template<typename T>
+class SerializedArray;
+
+namespace __detail__ {
+    // -------------------------------------------------------------------------
+    // Layout
+    // -------------------------------------------------------------------------
+
+    // Strings and vectors are stored out of line, and referenced by their
+    // offset from the buffer start and their length (both 8 bytes)
+    template<typename T>
+    static const constexpr bool is_view_reference =
+        is_string_attribute<T> || is_vector_attribute<T>::value;
+    static const constexpr uint64 view_reference_size = 16;
+    // Header: 2 magic bytes, version, 5 reserved bytes and 8 byte total size
+    static const constexpr uint64 view_header_size    = 16;
+    static const constexpr uint8  view_version        = 1;
+
+    template<typename T>
+    constexpr uint64 view_inline_size();
+
+    template<typename T, uint64... I>
+    constexpr uint64 view_fields_size(std::integer_sequence<uint64, I...>) {
+        return (
+            (uint64) 0 + ... +
+            view_inline_size<SerializableFields::Type<T, I>>()
+        );
+    }
+
+    // Size of in place representation of T
+    template<typename T>
+    constexpr uint64 view_inline_size() {
+        if constexpr (is_scalar_attribute<T>) return sizeof(T);
+        else if constexpr (is_view_reference<T>) return view_reference_size;
+        else {
+            static_assert(
+                SerializableFields::exist<T>::value,
+                "Serialized views support arithmetic types, strings, vectors "
+                "and objects using `serializable_attributes`."
+            );
+            return view_fields_size<T>(SerializableFields::Indices<T>());
+        }
+    }
+
+    // Offset of field F within in place representation of T
+    template<typename T, uint64 F, uint64... I>
+    constexpr uint64 view_field_offset(std::integer_sequence<uint64, I...>) {
+        return (
+            (uint64) 0 + ... +
+            (I < F ? view_inline_size<SerializableFields::Type<T, I>>() : 0)
+        );
+    }
+    template<typename T, uint64 F>
+    static const constexpr uint64 view_field_offset_v =
+        view_field_offset<T, F>(SerializableFields::Indices<T>());
+
+    // Alignment of out of line arrays of T. Scalar arrays are naturally
+    // aligned (relative to the buffer start), so they can be used directly.
+    template<typename T>
+    constexpr uint64 view_alignment() {
+        if constexpr (is_scalar_attribute<T>) return sizeof(T);
+        else return 8;
+    }
+
+    template<typename T>
+    constexpr bool view_has_references();
+
+    template<typename T, uint64... I>
+    constexpr bool view_fields_have_references(
+        std::integer_sequence<uint64, I...>
+    ) {
+        return (
+            false || ... ||
+            view_has_references<SerializableFields::Type<T, I>>()
+        );
+    }
+
+    // True if representation of T references out of line data
+    template<typename T>
+    constexpr bool view_has_references() {
+        if constexpr (is_scalar_attribute<T>) return false;
+        else if constexpr (is_view_reference<T>) return true;
+        else
+            return view_fields_have_references<T>(
+                SerializableFields::Indices<T>()
+            );
+    }
+
+    // -------------------------------------------------------------------------
+    // Values
+    // -------------------------------------------------------------------------
+
+    // Scalars are stored little endian
+    template<typename T>
+    T view_load(const byte* const source) {
+        if constexpr (std::is_same_v<T, bool>) return *source != 0;
+        else {
+            T value;
+            std::memcpy(&value, source, sizeof(T));
+            if (!platform::is_little_endian)
+                std::reverse((byte*) &value, (byte*) &value + sizeof(T));
+            return value;
+        }
+    }
+    template<typename T>
+    void view_store(byte* const target, T value) {
+        if (!platform::is_little_endian)
+            std::reverse((byte*) &value, (byte*) &value + sizeof(T));
+        std::memcpy(target, &value, sizeof(T));
+    }
+
+    // View type of in place representation of T
+    template<typename T, typename = void>
+    struct ViewType {
+        typedef SerializedView<T> type;
+    };
+    template<typename T>
+    struct ViewType<T, std::enable_if_t<is_scalar_attribute<T>>> {
+        typedef T type;
+    };
+    template<typename T>
+    struct ViewType<T, std::enable_if_t<is_string_attribute<T>>> {
+        typedef StringView type;
+    };
+    template<typename T>
+    struct ViewType<Vector<T>> {
+        typedef SerializedArray<T> type;
+    };
+
+    /**
+     * @brief Reads and validates in place representations of values
+     */
+    struct ViewAccess {
+        /**
+         * @brief Get view of value of type T, represented at @p at
+         *
+         * @param buffer Start of the whole serialized buffer
+         * @param at Start of in place representation
+         */
+        template<typename T>
+        static typename ViewType<T>::type read(
+            const byte* const buffer, const byte* const at
+        ) {
+            if constexpr (is_scalar_attribute<T>) return view_load<T>(at);
+            else if constexpr (is_string_attribute<T>)
+                return { buffer + view_load<uint64>(at),
+                         view_load<uint64>(at + 8) };
+            else if constexpr (is_vector_attribute<T>::value)
+                return { buffer,
+                         buffer + view_load<uint64>(at),
+                         view_load<uint64>(at + 8) };
+            else return { buffer, at };
+        }
+
+        /**
+         * @brief Check that all data referenced by representation of value of
+         * type T, at offset @p at, lies within the buffer. Representation
+         * itself must already be known to be within it.
+         *
+         * @param buffer Start of the whole serialized buffer
+         * @param size Size of the whole serialized buffer
+         * @param at Offset of in place representation
+         */
+        template<typename T>
+        static bool validate(
+            const byte* const buffer, const uint64 size, const uint64 at
+        ) {
+            if constexpr (!view_has_references<T>()) return true;
+            else if constexpr (is_string_attribute<T>) {
+                const auto offset = view_load<uint64>(buffer + at);
+                const auto length = view_load<uint64>(buffer + at + 8);
+                return offset <= size && length <= size - offset;
+            } else if constexpr (is_vector_attribute<T>::value) {
+                typedef typename T::value_type E;
+                const auto offset = view_load<uint64>(buffer + at);
+                const auto count  = view_load<uint64>(buffer + at + 8);
+                const auto stride = view_inline_size<E>();
+                if (offset > size || offset % view_alignment<E>() != 0)
+                    return false;
+                if (stride != 0 && count > (size - offset) / stride)
+                    return false;
+                for (uint64 i = 0; i < count; i++)
+                    if (!validate<E>(buffer, size, offset + i * stride))
+                        return false;
+                return true;
+            } else
+                return validate_fields<T>(
+                    buffer,
+                    size,
+                    at,
+                    SerializableFields::Indices<T>()
+                );
+        }
+
+      private:
+        template<typename T, uint64... I>
+        static bool validate_fields(
+            const byte* const buffer,
+            const uint64      size,
+            const uint64      at,
+            std::integer_sequence<uint64, I...>
+        ) {
+            return (
+                true && ... &&
+                validate<SerializableFields::Type<T, I>>(
+                    buffer, size, at + view_field_offset_v<T, I>
+                )
+            );
+        }
+    };
+
+    // -------------------------------------------------------------------------
+    // Builder
+    // -------------------------------------------------------------------------
+
+    /**
+     * @brief Writes offset based representation of values into a buffer.
+     * Out of line data is appended to the buffer end, so buffer is always
+     * addressed by offsets (it moves as it grows).
+     */
+    class ViewBuilder {
+      public:
+        explicit ViewBuilder(String& buffer) : _buffer(buffer) {}
+
+        /**
+         * @brief Append @p size zeroed bytes, aligned to @p alignment
+         * @return uint64 Offset of appended bytes
+         */
+        uint64 allocate(const uint64 size, const uint64 alignment) {
+            const auto offset =
+                (_buffer.size() + alignment - 1) / alignment * alignment;
+            _buffer.resize(offset + size);
+            return offset;
+        }
+        byte* at(const uint64 offset) { return _buffer.data() + offset; }
+
+        /**
+         * @brief Write representation of @p value at offset @p at, appending
+         * any out of line data it references
+         */
+        template<typename T>
+        void write(const uint64 at, const T& value) {
+            if constexpr (is_scalar_attribute<T>)
+                view_store(this->at(at), value);
+            else if constexpr (is_string_attribute<T>) {
+                const auto data = allocate(value.size(), 1);
+                std::memcpy(this->at(data), value.data(), value.size());
+                write_reference(at, data, value.size());
+            } else if constexpr (is_vector_attribute<T>::value) {
+                typedef typename T::value_type E;
+                const auto count  = value.size();
+                const auto stride = view_inline_size<E>();
+                const auto data =
+                    allocate(count * stride, view_alignment<E>());
+                if constexpr (is_scalar_attribute<E> &&
+                              !std::is_same_v<E, bool>) {
+                    if (platform::is_little_endian && count != 0) {
+                        std::memcpy(
+                            this->at(data), value.data(), count * stride
+                        );
+                        return write_reference(at, data, count);
+                    }
+                }
+                for (uint64 i = 0; i < count; i++)
+                    write<E>(data + i * stride, value[i]);
+                write_reference(at, data, count);
+            } else
+                write_fields<T>(
+                    at,
+                    SerializableFields::of(value),
+                    SerializableFields::Indices<T>()
+                );
+        }
+
+      private:
+        String& _buffer;
+
+        void write_reference(
+            const uint64 at, const uint64 offset, const uint64 count
+        ) {
+            view_store(this->at(at), offset);
+            view_store(this->at(at + 8), count);
+        }
+
+        template<typename T, typename Fields, uint64... I>
+        void write_fields(
+            const uint64  at,
+            const Fields& fields,
+            std::integer_sequence<uint64, I...>
+        ) {
+            (write<SerializableFields::Type<T, I>>(
+                 at + view_field_offset_v<T, I>, std::get<I>(fields)
+             ),
+             ...);
+        }
+    };
+} // namespace __detail__
+
+/**
+ * @brief Read only view of an array within serialized view data. Elements
+ * are read in place, without copying or allocating.
+ *
+ * @tparam T Type of serialized elements
+ */
+template<typename T>
+class SerializedArray {
+  public:
+    /// @brief Type of element views (ex. `StringView` for `String` elements)
+    typedef typename __detail__::ViewType<T>::type value_type;
+
+    SerializedArray() {}
+
+    /// @brief Number of elements
+    uint64 size() const { return _size; }
+    /// @brief True if array has no elements
+    bool   empty() const { return _size == 0; }
+
+    /// @brief View of @p index -th element
+    value_type operator[](const uint64 index) const {
+        return __detail__::ViewAccess::read<T>(_buffer, _data + index * stride);
+    }
+
+    /**
+     * @brief Elements as a plain array, available for arithmetic types only.
+     * Elements are stored naturally aligned and little endian, so this only
+     * fails on big endian systems or if the whole buffer isn't aligned to
+     * 16 bytes (mapped files and allocated strings always are).
+     * @return const T* Start of the elements, or nullptr if they can't be
+     * accessed directly
+     */
+    const T* data() const {
+        static_assert(
+            __detail__::is_scalar_attribute<T> && !std::is_same_v<T, bool>,
+            "Only arrays of arithmetic values can be accessed directly."
+        );
+        if (!platform::is_little_endian || (uintptr_t) _data % sizeof(T) != 0)
+            return nullptr;
+        return (const T*) _data;
+    }
+
+    class Iterator {
+      public:
+        Iterator(const SerializedArray* array, const uint64 index)
+            : _array(array), _index(index) {}
+
+        value_type operator*() const { return (*_array)[_index]; }
+        Iterator&  operator++() {
+            _index++;
+            return *this;
+        }
+        bool operator==(const Iterator& other) const {
+            return _index == other._index;
+        }
+        bool operator!=(const Iterator& other) const {
+            return _index != other._index;
+        }
+
+      private:
+        const SerializedArray* _array;
+        uint64                 _index;
+    };
+
+    Iterator begin() const { return { this, 0 }; }
+    Iterator end() const { return { this, _size }; }
+
+  private:
+    static const constexpr uint64 stride = __detail__::view_inline_size<T>();
+
+    const byte* _buffer = nullptr;
+    const byte* _data   = nullptr;
+    uint64      _size   = 0;
+
+    SerializedArray(
+        const byte* const buffer, const byte* const data, const uint64 size
+    )
+        : _buffer(buffer), _data(data), _size(size) {}
+
+    friend struct __detail__::ViewAccess;
+};
+
+/**
+ * @brief Read only view of an object serialized with `serialize_view`.
+ * Serialized data is an offset based layout, FlatBuffers style: every object
+ * has a fixed size in place representation, holding its arithmetic fields
+ * and (nested objects) directly, and strings and vectors as offsets to their
+ * out of line data. Views read fields straight from the buffer, so data can
+ * be used from a mapped file (see `MappedFile`) or a received buffer without
+ * any deserialization pass or allocation.
+ *
+ * Buffer is validated once, on `load`; afterwards all accesses are unchecked.
+ * Fields are accessed by their index in `serializable_attributes` list:
+ *
+ *  ```cpp
+ *      class Mesh : public Serializable {
+ *        public:
+ *          String          name;
+ *          Vector<float32> vertices;
+ *          serializable_attributes(name, vertices);
+ *      };
+ *
+ *      const String data = serialize_view(mesh);
+ *      const auto   view = SerializedView<Mesh>::load(data).value();
+ *      StringView   name = view.get<0>();
+ *      float32      x    = view.get<1>()[0];
+ *  ```
+ *
+ * Views don't own the buffer, which must outlive them. Data is stored little
+ * endian, independent of the system.
+ *
+ * @tparam T Type of serialized object. Must use `serializable_attributes`,
+ * with fields of arithmetic, `String`, `Vector` or such object types.
+ */
+template<typename T>
+class SerializedView {
+  public:
+    /// @brief Number of fields of the object
+    static const constexpr uint64 field_count =
+        __detail__::SerializableFields::count<T>;
+
+    /// @brief Type of @b I -th field view: value for arithmetic fields,
+    /// `StringView` for strings, `SerializedArray` for vectors and
+    /// `SerializedView` for nested objects
+    template<uint64 I>
+    using FieldView = typename __detail__::ViewType<
+        __detail__::SerializableFields::Type<T, I>>::type;
+
+    SerializedView() {}
+
+    /**
+     * @brief Validate serialized data and create view of its root object
+     *
+     * @param data Start of data created by `serialize_view`
+     * @param size Size of available data in bytes
+     * @return SerializedView View of the root object
+     * @throw RuntimeError If data isn't a valid serialized view of type @b T
+     */
+    static Result<SerializedView, RuntimeError> load(
+        const void* const data, const uint64 size
+    ) {
+        using namespace __detail__;
+        const auto buffer = (const byte*) data;
+        if (size < view_header_size || buffer[0] != 'S' || buffer[1] != 'V')
+            return Failure(RuntimeError("Data isn't a serialized view."));
+        if ((uint8) buffer[2] != view_version)
+            return Failure(
+                RuntimeError("Serialized view was written by unknown version.")
+            );
+
+        // Everything must lie within serialized size
+        const auto used = view_load<uint64>(buffer + 8);
+        if (used > size || used < view_header_size + view_inline_size<T>())
+            return Failure(RuntimeError("Serialized view is truncated."));
+        if (!ViewAccess::validate<T>(buffer, used, view_header_size))
+            return Failure(
+                RuntimeError("Serialized view references data out of bounds.")
+            );
+        return SerializedView { buffer, buffer + view_header_size };
+    }
+    /**
+     * @brief Validate serialized data and create view of its root object
+     *
+     * @param data Data created by `serialize_view` (ex. `String`, or
+     * `MappedFile::view`)
+     * @return SerializedView View of the root object
+     * @throw RuntimeError If data isn't a valid serialized view of type @b T
+     */
+    static Result<SerializedView, RuntimeError> load(const StringView data) {
+        return load(data.data(), data.size());
+    }
+
+    /// @brief View of @b I -th field
+    template<uint64 I>
+    FieldView<I> get() const {
+        static_assert(I < field_count, "Field index out of range.");
+        return __detail__::ViewAccess::read<
+            __detail__::SerializableFields::Type<T, I>>(
+            _buffer, _data + __detail__::view_field_offset_v<T, I>
+        );
+    }
+
+  private:
+    const byte* _buffer = nullptr;
+    const byte* _data   = nullptr;
+
+    SerializedView(const byte* const buffer, const byte* const data)
+        : _buffer(buffer), _data(data) {}
+
+    friend struct __detail__::ViewAccess;
+};
+
+/**
+ * @brief Serialize @p object into an offset based layout, which can be read
+ * in place with `SerializedView`.
+ *
+ * @tparam T Type of serialized object. Must use `serializable_attributes`,
+ * with fields of arithmetic, `String`, `Vector` or such object types.
+ * @param object Object to serialize
+ * @return String Serialized data
+ */
+template<typename T>
+String serialize_view(const T& object) {
+    using namespace __detail__;
+    String      buffer {};
+    ViewBuilder builder { buffer };
+
+    builder.allocate(view_header_size, 1);
+    builder.write(builder.allocate(view_inline_size<T>(), 8), object);
+
+    const auto header = builder.at(0);
+    header[0]         = 'S';
+    header[1]         = 'V';
+    header[2]         = (byte) view_version;
+    view_store<uint64>(header + 8, buffer.size());
+    return buffer;
+}
+
+/**
+ * @brief Serialize @p object into an offset based layout (see
+ * `serialize_view`), writing it into @p sink
+ *
+ * @param sink Output sink (ex. `StreamSink` of a file)
+ * @param object Object to serialize
+ */
+template<typename T>
+void serialize_view_to(SerializationSink& sink, const T& object) {
+    const auto data = serialize_view(object);
+    sink.write(data.data(), data.size());
+}
+
+} // namespace CORE_NAMESPACE
@@ -10,10 +10,33 @@
 #pragma once
 
 #include "serializable.hpp"
+#include "compression.hpp"
 #include "outcome.hpp"
+#include "files/mapped_file.hpp"
+
+#include <atomic>
+#include <deque>
 
 namespace CORE_NAMESPACE {
 
+template<typename T>
+class ChunkedVector;
+
+/**
+ * @brief Describes type of values in a block of arithmetic values (see
+ * `Serializer::has_block_encoding`)
+ */
+struct BlockElement {
+    uint8 size;
+    bool  is_signed;
+    bool  is_floating_point;
+
+    template<typename T>
+    static constexpr BlockElement of() {
+        return { sizeof(T), (T) -1 < (T) 0, std::is_floating_point_v<T> };
+    }
+};
+
 /**
  * @brief The  Serializer  class is an abstract class that provides a blueprint
  * for serialization and deserialization of different data types into a string
@@ -33,12 +56,33 @@ class Serializer {
      */
     template<typename... T>
     String serialize(const T&... data) const {
-        bool   add_sep = false;
-        String s {};
-        object_add_beg(s);
-        (serialize_attribute(s, data, add_sep), ...);
-        object_add_end(s);
-        return s;
+        BufferSink sink {};
+        serialize_to(sink, data...);
+        return sink.take();
+    }
+
+    /**
+     * @brief Serialize given attribute list as one object, writing it
+     * directly into @p sink. Nested objects are written into the same sink,
+     * so no intermediate strings are created.
+     *
+     * @tparam T Variable length list of attribute types. All attributes listed
+     * myst be serializable.
+     * @param sink Output sink (ex. reused `BufferSink`, `SpanSink` or
+     * `StreamSink`)
+     * @param data Variable length list of attributes as parameters.
+     */
+    template<typename... T>
+    void serialize_to(SerializationSink& sink, const T&... data) const {
+        object_add_beg(sink);
+        if (has_field_framing()) {
+            uint64 id = 0;
+            (serialize_field(sink, data, ++id), ...);
+        } else {
+            bool add_sep = false;
+            (serialize_attribute(sink, data, add_sep), ...);
+        }
+        object_add_end(sink);
     }
 
     /**
@@ -49,20 +93,25 @@ class Serializer {
      * @param data The String to deserialize.
      * @param from_pos Position from which we will start deserializing.
      * @param out_data The loaded data will be stored in this parameters.
-     * @return uint32 The number of bytes used for the deserialization which can
+     * @return uint64 The number of bytes used for the deserialization which can
      * be used for advancing the position in the string to deserialize next
      * data.
      * @throw RuntimeError If serialization fails.
      */
     template<typename... T>
-    Result<uint32, RuntimeError> deserialize(
-        const String& data, const uint32 from_pos, T&... out_data
+    Result<uint64, RuntimeError> deserialize(
+        const String& data, const uint64 from_pos, T&... out_data
     ) const {
-        uint32 position = from_pos;
+        uint64 position = from_pos;
 
         // Remove modifiers
         if (object_remove_beg(data, position).failed())
             return _deserialization_failure;
+        if (has_field_framing()) {
+            if (deserialize_fields(data, position, out_data...).failed())
+                return _deserialization_failure;
+            return position - from_pos;
+        }
         if (object_remove_end(data, position).failed())
             return _deserialization_failure;
 
@@ -74,103 +123,287 @@ class Serializer {
         return position - from_pos;
     }
 
+    /**
+     * @brief Deserialize only one attribute of an object, skipping all
+     * others without decoding them. Requires serializer which frames fields
+     * (see `has_field_framing`).
+     *
+     * @tparam T Attribute type
+     * @param data The String to deserialize.
+     * @param from_pos Position of the object.
+     * @param id Field ID of the attribute; its 1-based position in the
+     * attribute list.
+     * @param out_data The loaded attribute will be stored in this parameter.
+     * @throw RuntimeError If fields aren't framed, attribute isn't present or
+     * deserialization fails.
+     */
+    template<typename T>
+    Result<void, RuntimeError> deserialize_field(
+        const String& data, const uint64 from_pos, const uint64 id, T& out_data
+    ) const {
+        if (!has_field_framing())
+            return Failure("Serializer doesn't support field access.");
+
+        uint64 position = from_pos;
+        if (object_remove_beg(data, position).failed())
+            return _deserialization_failure;
+        while (true) {
+            uint64 field_id = 0, size = 0;
+            if (field_remove_header(data, field_id, size, position).failed())
+                return _deserialization_failure;
+            if (field_id == 0) return Failure("Field not found.");
+            if (size > data.size() - position) return _deserialization_failure;
+
+            const auto end = position + size;
+            if (field_id == id) {
+                if (deserialize_one(data, out_data, position).failed() ||
+                    position != end)
+                    return _deserialization_failure;
+                return {};
+            }
+            position = end;
+        }
+    }
+
+    /// @brief Default number of elements in a chunk of chunked vector
+    static const constexpr uint64 default_chunk_size = 4096;
+
+    /**
+     * @brief Serialize vector as independently encoded chunks, in parallel.
+     * Elements are split into chunks of @p chunk_size, each encoded on the
+     * pool into its own buffer. Encoded vector holds element count, chunk
+     * size and an index of chunk sizes, followed by the chunks themselves.
+     * Large chunks bypass buffered sinks (ex. `StreamSink`), so they are
+     * passed on without being copied again. Used for `ChunkedVector`
+     * attributes.
+     *
+     * @tparam T Element type
+     * @param sink Output sink
+     * @param data Vector to serialize
+     * @param chunk_size Number of elements in a chunk
+     * @param pool Pool used for parallel encoding
+     */
+    template<typename T>
+    void serialize_chunked(
+        SerializationSink&    sink,
+        const Vector<T>&      data,
+        const uint64          chunk_size = default_chunk_size,
+        parallel::ThreadPool& pool       = parallel::ThreadPool::global()
+    ) const {
+        const uint64 count       = data.size();
+        const uint64 size        = std::max<uint64>(chunk_size, 1);
+        const uint64 chunk_count = (count + size - 1) / size;
+
+        std::deque<BufferSink> chunks(chunk_count);
+        pool.run_joined(chunk_count, [&](const uint64 chunk) {
+            const auto end = std::min(count, (chunk + 1) * size);
+            auto&      out = chunks[chunk];
+            for (uint64 i = chunk * size; i < end; i++) {
+                if (i != chunk * size) vector_add_sep(out, count, sizeof(T), i);
+                serialize_one(out, data[i]);
+            }
+        });
+
+        vector_add_beg(sink, count, sizeof(T));
+        serialize_type(sink, size);
+        for (const auto& chunk : chunks)
+            serialize_type(sink, chunk.size());
+        for (const auto& chunk : chunks)
+            sink.write(chunk.data(), chunk.size());
+        vector_add_end(sink, count, sizeof(T));
+    }
+
+    /**
+     * @brief Deserialize vector written by `serialize_chunked`. Chunks are
+     * located with the chunk index and decoded in parallel, directly into
+     * @p out_data.
+     *
+     * @tparam T Element type
+     * @param data The String to deserialize.
+     * @param from_pos Position of the vector.
+     * @param out_data The loaded vector will be stored in this parameter.
+     * @param pool Pool used for parallel decoding
+     * @return uint64 The number of bytes used for the deserialization
+     * @throw RuntimeError If deserialization fails.
+     */
+    template<typename T>
+    Result<uint64, RuntimeError> deserialize_chunked(
+        const String&         data,
+        const uint64          from_pos,
+        Vector<T>&            out_data,
+        parallel::ThreadPool& pool = parallel::ThreadPool::global()
+    ) const {
+        uint64 position = from_pos, count = 0, size = 0;
+        if (vector_remove_beg(data, count, sizeof(T), position).failed() ||
+            deserialize_type(data, size, position).failed() || size == 0)
+            return _deserialization_failure;
+
+        // Each element, and so each chunk index entry, takes at least a byte
+        if (position > data.size() || count > data.size() - position)
+            return _deserialization_failure;
+        const auto chunk_count = count / size + (count % size != 0);
+        Vector<uint64> offsets(
+            chunk_count + 1, TAllocator<uint64>(BaseMemoryTags.Unknown)
+        );
+        for (uint64 i = 0; i < chunk_count; i++) {
+            uint64 chunk_size = 0;
+            if (deserialize_type(data, chunk_size, position).failed())
+                return _deserialization_failure;
+            offsets[i + 1] = offsets[i] + chunk_size;
+            if (offsets[i + 1] < offsets[i]) return _deserialization_failure;
+        }
+        if (position > data.size() ||
+            offsets[chunk_count] > data.size() - position ||
+            offsets[chunk_count] < count)
+            return _deserialization_failure;
+
+        // Chunks
+        if (out_data.size() != count) out_data.resize(count);
+        std::atomic<bool> failed { false };
+        pool.run_joined(chunk_count, [&](const uint64 chunk) {
+            if (failed.load(std::memory_order_relaxed)) return;
+            uint64     at  = position + offsets[chunk];
+            const auto end = std::min(count, (chunk + 1) * size);
+            for (uint64 i = chunk * size; i < end; i++) {
+                if ((i != chunk * size &&
+                     vector_remove_sep(data, count, sizeof(T), i, at)
+                         .failed()) ||
+                    deserialize_one(data, out_data[i], at).failed())
+                    return failed.store(true, std::memory_order_relaxed);
+            }
+            if (at != position + offsets[chunk + 1])
+                failed.store(true, std::memory_order_relaxed);
+        });
+        if (failed) return _deserialization_failure;
+
+        position += offsets[chunk_count];
+        if (vector_remove_end(data, count, sizeof(T), position).failed())
+            return _deserialization_failure;
+        return position - from_pos;
+    }
+
+    /**
+     * @brief Write header describing the encoding. It is placed only once,
+     * at the start of a whole serialized document (ex. a file), never in
+     * front of nested objects. Default implementation writes nothing.
+     *
+     * @param out Output sink
+     */
+    virtual void write_header(SerializationSink& out) const {}
+    /**
+     * @brief Read and verify header written by `write_header`.
+     *
+     * @param data Serialized document
+     * @param position Position of the header. Advanced past it.
+     * @throw RuntimeError If header is missing or describes encoding this
+     * serializer can't read.
+     */
+    virtual Result<void, RuntimeError> read_header(
+        const String& data, uint64& position
+    ) const {
+        return {};
+    }
+
   protected:
     // clang-format off
     // === Serialize for types ===
     // Bool
-    virtual void serialize_type(String& out_str, const bool data)       const = 0;
+    virtual void serialize_type(SerializationSink& out, const bool data)       const = 0;
     // Char
-    virtual void serialize_type(String& out_str, const char data)       const = 0;
+    virtual void serialize_type(SerializationSink& out, const char data)       const = 0;
     // Int
-    virtual void serialize_type(String& out_str, const int8 data)       const = 0;
-    virtual void serialize_type(String& out_str, const int16 data)      const = 0;
-    virtual void serialize_type(String& out_str, const int32 data)      const = 0;
-    virtual void serialize_type(String& out_str, const int64 data)      const = 0;
-    virtual void serialize_type(String& out_str, const int128 data)     const = 0;
-    virtual void serialize_type(String& out_str, const uint8 data)      const = 0;
-    virtual void serialize_type(String& out_str, const uint16 data)     const = 0;
-    virtual void serialize_type(String& out_str, const uint32 data)     const = 0;
-    virtual void serialize_type(String& out_str, const uint64 data)     const = 0;
-    virtual void serialize_type(String& out_str, const uint128 data)    const = 0;
+    virtual void serialize_type(SerializationSink& out, const int8 data)       const = 0;
+    virtual void serialize_type(SerializationSink& out, const int16 data)      const = 0;
+    virtual void serialize_type(SerializationSink& out, const int32 data)      const = 0;
+    virtual void serialize_type(SerializationSink& out, const int64 data)      const = 0;
+    virtual void serialize_type(SerializationSink& out, const int128 data)     const = 0;
+    virtual void serialize_type(SerializationSink& out, const uint8 data)      const = 0;
+    virtual void serialize_type(SerializationSink& out, const uint16 data)     const = 0;
+    virtual void serialize_type(SerializationSink& out, const uint32 data)     const = 0;
+    virtual void serialize_type(SerializationSink& out, const uint64 data)     const = 0;
+    virtual void serialize_type(SerializationSink& out, const uint128 data)    const = 0;
     // Float
-    virtual void serialize_type(String& out_str, const float32 data)    const = 0;
-    virtual void serialize_type(String& out_str, const float64 data)    const = 0;
+    virtual void serialize_type(SerializationSink& out, const float32 data)    const = 0;
+    virtual void serialize_type(SerializationSink& out, const float64 data)    const = 0;
     // String
-    virtual void serialize_type(String& out_str, const String& data)    const = 0;
+    virtual void serialize_type(SerializationSink& out, const String& data)    const = 0;
+    virtual void serialize_type(SerializationSink& out, const StringView data) const = 0;
     // Math
-    // virtual void serialize_type(String& out_str, const glm::vec1& data) const = 0;
-    // virtual void serialize_type(String& out_str, const glm::vec2& data) const = 0;
-    // virtual void serialize_type(String& out_str, const glm::vec3& data) const = 0;
-    // virtual void serialize_type(String& out_str, const glm::vec4& data) const = 0;
-    // virtual void serialize_type(String& out_str, const glm::mat2& data) const = 0;
-    // virtual void serialize_type(String& out_str, const glm::mat3& data) const = 0;
-    // virtual void serialize_type(String& out_str, const glm::mat4& data) const = 0;
+    // virtual void serialize_type(SerializationSink& out, const glm::vec1& data) const = 0;
+    // virtual void serialize_type(SerializationSink& out, const glm::vec2& data) const = 0;
+    // virtual void serialize_type(SerializationSink& out, const glm::vec3& data) const = 0;
+    // virtual void serialize_type(SerializationSink& out, const glm::vec4& data) const = 0;
+    // virtual void serialize_type(SerializationSink& out, const glm::mat2& data) const = 0;
+    // virtual void serialize_type(SerializationSink& out, const glm::mat3& data) const = 0;
+    // virtual void serialize_type(SerializationSink& out, const glm::mat4& data) const = 0;
 
     // === Deserialize for types ===
     // Bool
-    virtual Outcome deserialize_type(const String& in_str, bool& data, uint32& position)      const = 0;
+    virtual Outcome deserialize_type(const String& in_str, bool& data, uint64& position)      const = 0;
     // Char
-    virtual Outcome deserialize_type(const String& in_str, char& data, uint32& position)      const = 0;
+    virtual Outcome deserialize_type(const String& in_str, char& data, uint64& position)      const = 0;
     // Int
-    virtual Outcome deserialize_type(const String& in_str, int8& data, uint32& position)      const = 0;
-    virtual Outcome deserialize_type(const String& in_str, int16& data, uint32& position)     const = 0;
-    virtual Outcome deserialize_type(const String& in_str, int32& data, uint32& position)     const = 0;
-    virtual Outcome deserialize_type(const String& in_str, int64& data, uint32& position)     const = 0;
-    virtual Outcome deserialize_type(const String& in_str, int128& data, uint32& position)    const = 0;
-    virtual Outcome deserialize_type(const String& in_str, uint8& data, uint32& position)     const = 0;
-    virtual Outcome deserialize_type(const String& in_str, uint16& data, uint32& position)    const = 0;
-    virtual Outcome deserialize_type(const String& in_str, uint32& data, uint32& position)    const = 0;
-    virtual Outcome deserialize_type(const String& in_str, uint64& data, uint32& position)    const = 0;
-    virtual Outcome deserialize_type(const String& in_str, uint128& data, uint32& position)   const = 0;
+    virtual Outcome deserialize_type(const String& in_str, int8& data, uint64& position)      const = 0;
+    virtual Outcome deserialize_type(const String& in_str, int16& data, uint64& position)     const = 0;
+    virtual Outcome deserialize_type(const String& in_str, int32& data, uint64& position)     const = 0;
+    virtual Outcome deserialize_type(const String& in_str, int64& data, uint64& position)     const = 0;
+    virtual Outcome deserialize_type(const String& in_str, int128& data, uint64& position)    const = 0;
+    virtual Outcome deserialize_type(const String& in_str, uint8& data, uint64& position)     const = 0;
+    virtual Outcome deserialize_type(const String& in_str, uint16& data, uint64& position)    const = 0;
+    virtual Outcome deserialize_type(const String& in_str, uint32& data, uint64& position)    const = 0;
+    virtual Outcome deserialize_type(const String& in_str, uint64& data, uint64& position)    const = 0;
+    virtual Outcome deserialize_type(const String& in_str, uint128& data, uint64& position)   const = 0;
     // Float
-    virtual Outcome deserialize_type(const String& in_str, float32& data, uint32& position)   const = 0;
-    virtual Outcome deserialize_type(const String& in_str, float64& data, uint32& position)   const = 0;
+    virtual Outcome deserialize_type(const String& in_str, float32& data, uint64& position)   const = 0;
+    virtual Outcome deserialize_type(const String& in_str, float64& data, uint64& position)   const = 0;
     // String
-    virtual Outcome deserialize_type(const String& in_str, String& data, uint32& position)    const = 0;
+    virtual Outcome deserialize_type(const String& in_str, String& data, uint64& position)    const = 0;
+    // Views into the deserialized string, valid only while it is alive
+    virtual Outcome deserialize_type(const String& in_str, StringView& data, uint64& position) const = 0;
     // Math
-    // virtual Outcome deserialize_type(const String& in_str, glm::vec1& data, uint32& position) const = 0;
-    // virtual Outcome deserialize_type(const String& in_str, glm::vec2& data, uint32& position) const = 0;
-    // virtual Outcome deserialize_type(const String& in_str, glm::vec3& data, uint32& position) const = 0;
-    // virtual Outcome deserialize_type(const String& in_str, glm::vec4& data, uint32& position) const = 0;
-    // virtual Outcome deserialize_type(const String& in_str, glm::mat2& data, uint32& position) const = 0;
-    // virtual Outcome deserialize_type(const String& in_str, glm::mat3& data, uint32& position) const = 0;
-    // virtual Outcome deserialize_type(const String& in_str, glm::mat4& data, uint32& position) const = 0;
+    // virtual Outcome deserialize_type(const String& in_str, glm::vec1& data, uint64& position) const = 0;
+    // virtual Outcome deserialize_type(const String& in_str, glm::vec2& data, uint64& position) const = 0;
+    // virtual Outcome deserialize_type(const String& in_str, glm::vec3& data, uint64& position) const = 0;
+    // virtual Outcome deserialize_type(const String& in_str, glm::vec4& data, uint64& position) const = 0;
+    // virtual Outcome deserialize_type(const String& in_str, glm::mat2& data, uint64& position) const = 0;
+    // virtual Outcome deserialize_type(const String& in_str, glm::mat3& data, uint64& position) const = 0;
+    // virtual Outcome deserialize_type(const String& in_str, glm::mat4& data, uint64& position) const = 0;
 
     // === Padding ===
     // Attribute
-    virtual void attribute_add_beg(String& out_string) const {};
-    virtual void attribute_add_sep(String& out_string) const {};
-    virtual void attribute_add_end(String& out_string) const {};
-    virtual Outcome attribute_remove_beg(const String& in_string, uint32& position) const { return Outcome::Successful; };
-    virtual Outcome attribute_remove_sep(const String& in_string, uint32& position) const { return Outcome::Successful; };
-    virtual Outcome attribute_remove_end(const String& in_string, uint32& position) const { return Outcome::Successful; };
+    virtual void attribute_add_beg(SerializationSink& out) const {};
+    virtual void attribute_add_sep(SerializationSink& out) const {};
+    virtual void attribute_add_end(SerializationSink& out) const {};
+    virtual Outcome attribute_remove_beg(const String& in_string, uint64& position) const { return Outcome::Successful; };
+    virtual Outcome attribute_remove_sep(const String& in_string, uint64& position) const { return Outcome::Successful; };
+    virtual Outcome attribute_remove_end(const String& in_string, uint64& position) const { return Outcome::Successful; };
     
     // Whole object
-    virtual void object_add_beg(String& out_string) const {};
-    virtual void object_add_end(String& out_string) const {};
-    virtual Outcome object_remove_beg(const String& in_string, uint32& position) const { return Outcome::Successful; };
-    virtual Outcome object_remove_end(const String& in_string, uint32& position) const { return Outcome::Successful; };
+    virtual void object_add_beg(SerializationSink& out) const {};
+    virtual void object_add_end(SerializationSink& out) const {};
+    virtual Outcome object_remove_beg(const String& in_string, uint64& position) const { return Outcome::Successful; };
+    virtual Outcome object_remove_end(const String& in_string, uint64& position) const { return Outcome::Successful; };
     // clang-format on
 
     // Containers
     virtual void vector_add_beg(
-        String& out_str, const uint64 count, const uint64 type_size
+        SerializationSink& out, const uint64 count, const uint64 type_size
     ) const {}
     virtual void vector_add_sep(
-        String&      out_str,
-        const uint64 count,
-        const uint64 type_size,
-        const uint64 current
+        SerializationSink& out,
+        const uint64       count,
+        const uint64       type_size,
+        const uint64       current
     ) const {}
     virtual void vector_add_end(
-        String& out_str, const uint64 count, const uint64 type_size
+        SerializationSink& out, const uint64 count, const uint64 type_size
     ) const {}
 
     virtual Outcome vector_remove_beg(
         const String& in_str,
         uint64&       count,
         const uint64  type_size,
-        uint32&       position
+        uint64&       position
     ) const {
         return Outcome::Successful;
     }
@@ -179,7 +412,7 @@ class Serializer {
         uint64&       count,
         const uint64  type_size,
         const uint64  current,
-        uint32&       position
+        uint64&       position
     ) const {
         return Outcome::Successful;
     }
@@ -187,37 +420,124 @@ class Serializer {
         const String& in_str,
         uint64&       count,
         const uint64  type_size,
-        uint32&       position
+        uint64&       position
     ) const {
         return Outcome::Successful;
     }
 
+    // Arrays of arithmetic values
+    /**
+     * @brief Whether vectors of arithmetic values are encoded as one block,
+     * with `serialize_block` and `deserialize_block`, in place of encoding
+     * each element separately. Block is placed in between vector beginning
+     * and end; no separators are used.
+     */
+    virtual bool has_block_encoding() const { return false; }
+    virtual void serialize_block(
+        SerializationSink& out,
+        const void* const  data,
+        const uint64       count,
+        const BlockElement element
+    ) const {}
+    virtual Outcome deserialize_block(
+        const String&      in_str,
+        void* const        data,
+        const uint64       count,
+        const BlockElement element,
+        uint64&            position
+    ) const {
+        return Outcome::Failed;
+    }
+    /// @brief Smallest number of bytes a block element can be encoded in.
+    /// Used to reject element counts before allocating for them.
+    virtual uint64 min_block_element_size(const BlockElement element) const {
+        return element.size;
+    }
+
+    // Field framing
+    /**
+     * @brief Whether each attribute is written as a field, prefixed with its
+     * ID and size (see `field_add_header`), in place of attribute padding.
+     * Attribute ID is its 1-based position in the attribute list. Object's
+     * fields are followed by the end of object (`object_add_end`), which
+     * `field_remove_header` must read as field with ID 0.
+     *
+     * Readers skip fields with unknown IDs without decoding them and leave
+     * attributes without a field unchanged, so attributes can be added to
+     * (the end of) an object without breaking older readers or data.
+     */
+    virtual bool has_field_framing() const { return false; }
+    virtual void field_add_header(
+        SerializationSink& out, const uint64 id, const uint64 size
+    ) const {}
+    virtual Outcome field_remove_header(
+        const String& in_str, uint64& id, uint64& size, uint64& position
+    ) const {
+        return Outcome::Failed;
+    }
+
   private:
+    // Types whose vectors can be encoded as blocks
     template<typename T>
-    void serialize_type(String& out_str, const Vector<T>& data) const {
+    static const constexpr bool is_block_element =
+        std::is_same_v<T, char> || std::is_same_v<T, int8> ||
+        std::is_same_v<T, int16> || std::is_same_v<T, int32> ||
+        std::is_same_v<T, int64> || std::is_same_v<T, int128> ||
+        std::is_same_v<T, uint8> || std::is_same_v<T, uint16> ||
+        std::is_same_v<T, uint32> || std::is_same_v<T, uint64> ||
+        std::is_same_v<T, uint128> || std::is_same_v<T, float32> ||
+        std::is_same_v<T, float64>;
+
+    template<typename T>
+    void serialize_type(SerializationSink& out, const Vector<T>& data) const {
         const auto count = data.size();
         const auto size  = sizeof(T);
-        vector_add_beg(out_str, count, size);
+        vector_add_beg(out, count, size);
+        if constexpr (is_block_element<T>) {
+            if (has_block_encoding()) {
+                const auto element = BlockElement::of<T>();
+                serialize_block(out, data.data(), count, element);
+                return vector_add_end(out, count, size);
+            }
+        }
         for (uint64 i = 0; i < count; i++) {
-            if (i != 0) vector_add_sep(out_str, count, size, i);
-            serialize_one(out_str, data[i]);
+            if (i != 0) vector_add_sep(out, count, size, i);
+            serialize_one(out, data[i]);
         }
-        vector_add_end(out_str, count, size);
+        vector_add_end(out, count, size);
     }
 
     template<typename T>
     Outcome deserialize_type(
-        const String& in_str, Vector<T>& data, uint32& position
+        const String& in_str, Vector<T>& data, uint64& position
     ) const {
         uint64     count = 0;
         const auto size  = sizeof(T);
 
         // Deserialize beginning
-        if (vector_remove_beg(in_str, count, size, position).failed())
+        if (vector_remove_beg(in_str, count, size, position).failed() ||
+            position > in_str.size())
             return Outcome::Failed;
-        if (data.size() != count) data.resize(count);
+        const auto remaining = in_str.size() - position;
 
-        // Deserialize elements
+        // Deserialize elements. Counts which can't fit into remaining input
+        // are rejected before allocating.
+        if constexpr (is_block_element<T>) {
+            if (has_block_encoding()) {
+                const auto element = BlockElement::of<T>();
+                if (count > remaining / min_block_element_size(element))
+                    return Outcome::Failed;
+                if (data.size() != count) data.resize(count);
+                const auto read = deserialize_block(
+                    in_str, data.data(), count, element, position
+                );
+                if (read.failed()) return Outcome::Failed;
+                return vector_remove_end(in_str, count, size, position);
+            }
+        }
+        if (__detail__::is_never_empty<T>() && count > remaining)
+            return Outcome::Failed;
+        if (data.size() != count) data.resize(count);
         for (uint64 i = 0; i < count; i++) {
             if (i != 0 &&
                 vector_remove_sep(in_str, count, size, i, position).failed())
@@ -233,25 +553,44 @@ class Serializer {
         return Outcome::Successful;
     }
 
+    template<typename T>
+    void serialize_type(
+        SerializationSink& out, const ChunkedVector<T>& data
+    ) const {
+        serialize_chunked(out, data);
+    }
+
+    template<typename T>
+    Outcome deserialize_type(
+        const String& in_str, ChunkedVector<T>& data, uint64& position
+    ) const {
+        const auto read = deserialize_chunked(in_str, position, data);
+        if (read.has_error()) return Outcome::Failed;
+        position += read.value();
+        return Outcome::Successful;
+    }
+
     // Serialize one
     template<typename T>
-    void serialize_one(String& out_str, const T& data) const {
-        if constexpr (has_serialize_method<Serializer, String&, T>::value)
-            serialize_type(out_str, data);
-        else if constexpr (std::is_base_of_v<Serializable, T>) {
-            auto serializable_data = dynamic_cast<Serializable*>((T*) &data);
-            out_str += serializable_data->serialize(this);
-        } else out_str += serialize_object(data, this);
+    void serialize_one(SerializationSink& out, const T& data) const {
+        if constexpr (has_serialize_method<
+                          Serializer,
+                          SerializationSink&,
+                          T>::value)
+            serialize_type(out, data);
+        else if constexpr (std::is_base_of_v<Serializable, T>)
+            static_cast<const Serializable&>(data).serialize_to(out, this);
+        else serialize_object(data, this, out);
     }
 
     template<typename T>
-    Outcome deserialize_one(const String& data, T& out_data, uint32& position)
+    Outcome deserialize_one(const String& data, T& out_data, uint64& position)
         const {
         if constexpr (has_deserialize_method<
                           Serializer,
                           const String&,
                           T&,
-                          uint32&>::value)
+                          uint64&>::value)
             return deserialize_type(data, out_data, position);
         else if constexpr (std::is_base_of_v<Serializable, T>) {
             auto serializable_data =
@@ -306,19 +645,83 @@ class Serializer {
 
     template<typename T>
     void serialize_attribute(
-        String& out_str, const T& data, bool& add_separator
+        SerializationSink& out, const T& data, bool& add_separator
     ) const {
-        if (add_separator) attribute_add_sep(out_str);
+        if (add_separator) attribute_add_sep(out);
         else add_separator = true;
 
-        attribute_add_beg(out_str);
-        serialize_one(out_str, data);
-        attribute_add_end(out_str);
+        attribute_add_beg(out);
+        serialize_one(out, data);
+        attribute_add_end(out);
+    }
+
+    // Framed fields are encoded into scratch memory first, to learn their
+    // size. Scalars use stack memory, other values a sink kept by the thread
+    // for each nesting depth, so steady state serialization doesn't allocate.
+    static const constexpr uint64 scalar_scratch_size = 32;
+    static const constexpr uint64 max_kept_scratch    = 1024 * 1024;
+
+    inline static thread_local uint32 _field_depth = 0;
+
+    static BufferSink& field_scratch(const uint32 depth) {
+        thread_local std::deque<BufferSink> scratch {};
+        while (scratch.size() <= depth)
+            scratch.emplace_back();
+        return scratch[depth];
+    }
+
+    template<typename T>
+    void serialize_field(
+        SerializationSink& out, const T& data, const uint64 id
+    ) const {
+        if constexpr (__detail__::is_scalar_attribute<T>) {
+            byte     buffer[scalar_scratch_size];
+            SpanSink scratch { buffer, sizeof(buffer) };
+            serialize_one(scratch, data);
+            if (!scratch.overflowed()) {
+                field_add_header(out, id, scratch.size());
+                return out.write(buffer, scratch.size());
+            }
+        }
+
+        auto& scratch = field_scratch(_field_depth++);
+        scratch.clear();
+        serialize_one(scratch, data);
+        _field_depth--;
+        field_add_header(out, id, scratch.size());
+        out.write(scratch.data(), scratch.size());
+        if (scratch.capacity() > max_kept_scratch) scratch.take();
+    }
+
+    template<typename... T>
+    Outcome deserialize_fields(
+        const String& data, uint64& position, T&... out_data
+    ) const {
+        while (true) {
+            uint64 id = 0, size = 0;
+            if (field_remove_header(data, id, size, position).failed())
+                return Outcome::Failed;
+            if (id == 0) return Outcome::Successful;
+            if (size > data.size() - position) return Outcome::Failed;
+
+            // Known field must be decoded exactly, unknown one is skipped
+            const auto end        = position + size;
+            uint64     index      = 0;
+            bool       successful = true;
+            ((++index == id &&
+              (successful =
+                   deserialize_one(data, out_data, position).succeeded(),
+               true)) ||
+             ...);
+            if (!successful || (index >= id && position != end))
+                return Outcome::Failed;
+            position = end;
+        }
     }
 
     template<typename T>
     void deserialize_attribute(
-        String const& data, T& out_data, uint32& position, bool& successful
+        String const& data, T& out_data, uint64& position, bool& successful
     ) const {
         if (!successful) return;
         successful = false;
@@ -330,4 +733,84 @@ class Serializer {
     }
 };
 
-} // namespace CORE_NAMESPACE
\ No newline at end of file
+// -----------------------------------------------------------------------------
+// Serializable file methods
+// -----------------------------------------------------------------------------
+
+inline Result<void, RuntimeError> Serializable::serialize_to_file(
+    const Path& file_path, const Serializer* const serializer
+) const {
+    // Open file
+    auto result = FileSystem::create_or_open<BinaryOut>(
+        file_path, FileSystem::binary | FileSystem::trunc
+    );
+    if (result.has_error()) return Failure(result.error());
+    const auto file { std::move(result.value()) };
+
+    // Write header and all data, through a small buffer
+    StreamSink sink { *file };
+    serializer->write_header(sink);
+    this->serialize_to(sink, serializer);
+    sink.flush();
+    const auto failed = sink.failed();
+
+    // Close file
+    file->close();
+    if (failed) return Failure("Failed to write file:" + file_path.string());
+    return {};
+}
+
+inline Result<void, RuntimeError> Serializable::serialize_to_file(
+    const Path&                file_path,
+    const Serializer* const    serializer,
+    const CompressionSettings& compression
+) const {
+    // Open file
+    auto result = FileSystem::create_or_open<BinaryOut>(
+        file_path, FileSystem::binary | FileSystem::trunc
+    );
+    if (result.has_error()) return Failure(result.error());
+    const auto file { std::move(result.value()) };
+
+    // Write header and all data, compressed block by block
+    StreamSink      sink { *file };
+    CompressionSink compressed { sink, compression };
+    serializer->write_header(compressed);
+    this->serialize_to(compressed, serializer);
+    compressed.finish();
+    sink.flush();
+    const auto failed = sink.failed();
+
+    // Close file
+    file->close();
+    if (failed) return Failure("Failed to write file:" + file_path.string());
+    return {};
+}
+
+inline Result<uint64, RuntimeError> Serializable::deserialize_from_file(
+    const Path& file_path, const Serializer* const serializer
+) {
+    // Map file, decompressing it if needed
+    auto result = MappedFile::open(file_path);
+    if (result.has_error()) return Failure(result.error());
+    const auto file { std::move(result.value()) };
+
+    String data {};
+    if (Compression::is_compressed(file.view())) {
+        auto decompressed = Compression::decompress(file.view());
+        if (decompressed.has_error()) return Failure(decompressed.error());
+        data = std::move(decompressed.value());
+    } else data.assign(file.view());
+
+    // Verify header
+    uint64     position = 0;
+    const auto header   = serializer->read_header(data, position);
+    if (header.has_error()) return Failure(header.error());
+
+    // Deserialize read data
+    const auto read = this->deserialize(serializer, data, position);
+    if (read.has_error()) return Failure(read.error());
+    return position + read.value();
+}
+
+} // namespace CORE_NAMESPACE
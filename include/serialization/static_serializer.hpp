@@ -0,0 +1,390 @@
+/**
+ * @file static_serializer.hpp
+ * @author Android172 (android172unity@gmail.com)
+ * @brief Defines compile-time serializer, with encoding chosen as a template
+ * parameter
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+
+#include "serializer.hpp"
+#include "varint.hpp"
+#include "container/vector.hpp"
+
+namespace CORE_NAMESPACE {
+
+// -----------------------------------------------------------------------------
+// Encoders
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief Encoder storing values in fixed width, little endian. Produces the
+ * same data as `BinarySerializer` with little endian wire byte order (without
+ * the header).
+ */
+struct BinaryEncoder {
+    /// @brief True if values of type @b T are stored exactly as they are
+    /// held in memory on little endian systems
+    template<typename T>
+    static const constexpr bool is_raw = __detail__::is_scalar_attribute<T>;
+
+    template<typename T>
+    static void write(SerializationSink& out, T value) {
+        if (!platform::is_little_endian)
+            std::reverse((byte*) &value, (byte*) &value + sizeof(T));
+        out.write(&value, sizeof(T));
+    }
+    template<typename T>
+    static Outcome read(const byte*& source, const byte* const end, T& value) {
+        if ((uint64) (end - source) < sizeof(T)) return Outcome::Failed;
+        std::memcpy(&value, source, sizeof(T));
+        if (!platform::is_little_endian)
+            std::reverse((byte*) &value, (byte*) &value + sizeof(T));
+        source += sizeof(T);
+        return Outcome::Successful;
+    }
+
+    static void write_size(SerializationSink& out, const uint64 size) {
+        write(out, size);
+    }
+    static Outcome read_size(
+        const byte*& source, const byte* const end, uint64& size
+    ) {
+        return read(source, end, size);
+    }
+
+    template<typename T>
+    static void write_block(
+        SerializationSink& out, const T* const values, const uint64 count
+    ) {
+        if (count == 0) return;
+        if (!platform::is_little_endian && sizeof(T) != 1) {
+            for (uint64 i = 0; i < count; i++)
+                write(out, values[i]);
+            return;
+        }
+        out.write(values, count * sizeof(T));
+    }
+    template<typename T>
+    static Outcome read_block(
+        const byte*&      source,
+        const byte* const end,
+        T* const          values,
+        const uint64      count
+    ) {
+        if (!platform::is_little_endian && sizeof(T) != 1) {
+            for (uint64 i = 0; i < count; i++)
+                if (read(source, end, values[i]).failed())
+                    return Outcome::Failed;
+            return Outcome::Successful;
+        }
+        if ((uint64) (end - source) / sizeof(T) < count) return Outcome::Failed;
+        if (count == 0) return Outcome::Successful;
+        std::memcpy(values, source, count * sizeof(T));
+        source += count * sizeof(T);
+        return Outcome::Successful;
+    }
+};
+
+/**
+ * @brief Encoder storing integers wider than a byte, as well as sizes, as
+ * zigzag encoded varints. Produces the same data as `CompactBinarySerializer`
+ * with little endian wire byte order (without the header).
+ */
+struct CompactBinaryEncoder {
+    // Same types as `CompactBinarySerializer` encodes as varints. Listed
+    // explicitly, as 128 bit integers aren't integral in strict C++17.
+    template<typename T>
+    static const constexpr bool is_varint =
+        std::is_same_v<T, int16> || std::is_same_v<T, int32> ||
+        std::is_same_v<T, int64> || std::is_same_v<T, int128> ||
+        std::is_same_v<T, uint16> || std::is_same_v<T, uint32> ||
+        std::is_same_v<T, uint64> || std::is_same_v<T, uint128>;
+
+    template<typename T>
+    static const constexpr bool is_raw =
+        BinaryEncoder::is_raw<T> && !is_varint<T>;
+
+    template<typename T>
+    static void write(SerializationSink& out, const T value) {
+        if constexpr (is_varint<T>) __detail__::write_varint_value(out, value);
+        else BinaryEncoder::write(out, value);
+    }
+    template<typename T>
+    static Outcome read(const byte*& source, const byte* const end, T& value) {
+        if constexpr (is_varint<T>)
+            return __detail__::read_varint_value(source, end, value);
+        else return BinaryEncoder::read(source, end, value);
+    }
+
+    static void write_size(SerializationSink& out, const uint64 size) {
+        __detail__::write_varint(out, size);
+    }
+    static Outcome read_size(
+        const byte*& source, const byte* const end, uint64& size
+    ) {
+        return __detail__::read_varint_value(source, end, size);
+    }
+
+    template<typename T>
+    static void write_block(
+        SerializationSink& out, const T* const values, const uint64 count
+    ) {
+        if constexpr (is_varint<T>)
+            __detail__::write_varint_values(out, values, count);
+        else BinaryEncoder::write_block(out, values, count);
+    }
+    template<typename T>
+    static Outcome read_block(
+        const byte*&      source,
+        const byte* const end,
+        T* const          values,
+        const uint64      count
+    ) {
+        if constexpr (is_varint<T>)
+            return __detail__::read_varint_values(source, end, values, count);
+        else return BinaryEncoder::read_block(source, end, values, count);
+    }
+};
+
+// -----------------------------------------------------------------------------
+// Static serializer
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief Serializer resolved entirely at compile time. Objects are traversed
+ * through compile-time attribute lists generated by `serializable_attributes`
+ * macro and every value is encoded by @b Encoder directly, so serialization
+ * of a whole object compiles down to inlined code, without virtual calls or
+ * dynamic casts.
+ *
+ * Objects whose attributes are all stored raw by the encoder, and which lie
+ * in memory one after another (in the listed order, without padding), are
+ * written and read with a single copy. Vectors of arithmetic values are
+ * always encoded as one block.
+ *
+ * Supports arithmetic types, `String`, `StringView` (deserialized as a view
+ * into the input), `Vector` and objects using `serializable_attributes` with
+ * such attributes. For runtime selection of format (or custom object
+ * serialization) virtual `Serializer` should be used instead.
+ *
+ *  ```cpp
+ *      String data = StaticBinarySerializer::serialize(object);
+ *      StaticBinarySerializer::deserialize(data, 0, object);
+ *  ```
+ *
+ * @tparam Encoder Encoding of values (ex. `BinaryEncoder`)
+ */
+template<typename Encoder>
+class StaticSerializer {
+  public:
+    /**
+     * @brief Serialize @p object
+     *
+     * @param object Object to serialize
+     * @return String Serialized data
+     */
+    template<typename T>
+    static String serialize(const T& object) {
+        BufferSink sink {};
+        serialize_to(sink, object);
+        return sink.take();
+    }
+    /**
+     * @brief Serialize @p object, writing it directly into @p sink
+     *
+     * @param sink Output sink
+     * @param object Object to serialize
+     */
+    template<typename T>
+    static void serialize_to(SerializationSink& sink, const T& object) {
+        write(sink, object);
+    }
+
+    /**
+     * @brief Deserialize @p object
+     *
+     * @param data Serialized data
+     * @param from_pos Position at which object starts
+     * @param object Deserialized object
+     * @return uint64 Number of bytes used for the deserialization
+     * @throw RuntimeError If data is truncated or malformed
+     */
+    template<typename T>
+    static Result<uint64, RuntimeError> deserialize(
+        const String& data, const uint64 from_pos, T& object
+    ) {
+        if (from_pos > data.size()) return deserialization_failure();
+        const byte* source = data.data() + from_pos;
+        if (read(source, data.data() + data.size(), object).failed())
+            return deserialization_failure();
+        return (uint64) (source - data.data() - from_pos);
+    }
+
+  private:
+    typedef __detail__::SerializableFields Fields;
+
+    static Failure<RuntimeError> deserialization_failure() {
+        return Failure(
+            RuntimeError("Deserialization failed. Input formatting error.")
+        );
+    }
+
+    // -------------------------------------------------------------------------
+    // Packed objects
+    // -------------------------------------------------------------------------
+
+    template<typename T, uint64... I>
+    static constexpr bool are_fields_raw(std::integer_sequence<uint64, I...>) {
+        return sizeof...(I) != 0 &&
+               (Encoder::template is_raw<Fields::Type<T, I>> && ...);
+    }
+
+    // Size of object's attributes if they are all raw and placed contiguously
+    // in memory, in the listed order, starting with the first one; else 0.
+    // Attribute addresses are fixed relative to the object, so compiler
+    // folds the check into a constant.
+    template<typename T, typename List, uint64... I>
+    static uint64 packed_size(
+        const List& fields, std::integer_sequence<uint64, I...>
+    ) {
+        if constexpr (!are_fields_raw<T>(
+                          std::integer_sequence<uint64, I...>()
+                      ))
+            return 0;
+        else {
+            if (!platform::is_little_endian) return 0;
+            const auto start  = (const byte*) &std::get<0>(fields);
+            uint64     offset = 0;
+            const bool packed =
+                (((const byte*) &std::get<I>(fields) == start + offset &&
+                  (offset += sizeof(Fields::Type<T, I>), true)) &&
+                 ...);
+            return packed ? offset : 0;
+        }
+    }
+
+    // -------------------------------------------------------------------------
+    // Write
+    // -------------------------------------------------------------------------
+
+    template<typename T>
+    static void write(SerializationSink& out, const T& value) {
+        using namespace __detail__;
+        if constexpr (is_scalar_attribute<T>) Encoder::write(out, value);
+        else if constexpr (is_string_attribute<T>) {
+            Encoder::write_size(out, value.size());
+            out.write(value.data(), value.size());
+        } else if constexpr (is_vector_attribute<T>::value) {
+            typedef typename T::value_type E;
+            Encoder::write_size(out, value.size());
+            if constexpr (is_scalar_attribute<E> && !std::is_same_v<E, bool>)
+                Encoder::write_block(out, value.data(), value.size());
+            else
+                for (const E& element : value)
+                    write(out, element);
+        } else {
+            static_assert(
+                Fields::exist<T>::value,
+                "Static serialization supports arithmetic types, strings, "
+                "vectors and objects using `serializable_attributes`."
+            );
+            const auto fields = Fields::of(value);
+            const auto packed = packed_size<T>(fields, Fields::Indices<T>());
+            if (packed != 0)
+                return out.write(&std::get<0>(fields), packed);
+            write_fields<T>(out, fields, Fields::Indices<T>());
+        }
+    }
+    template<typename T, typename List, uint64... I>
+    static void write_fields(
+        SerializationSink& out,
+        const List&        fields,
+        std::integer_sequence<uint64, I...>
+    ) {
+        (write(out, std::get<I>(fields)), ...);
+    }
+
+    // -------------------------------------------------------------------------
+    // Read
+    // -------------------------------------------------------------------------
+
+    template<typename T>
+    static Outcome read(
+        const byte*& source, const byte* const end, T& value
+    ) {
+        using namespace __detail__;
+        if constexpr (is_scalar_attribute<T>)
+            return Encoder::read(source, end, value);
+        else if constexpr (is_string_attribute<T>) {
+            uint64 size = 0;
+            if (Encoder::read_size(source, end, size).failed())
+                return Outcome::Failed;
+            if (size > (uint64) (end - source)) return Outcome::Failed;
+            value = T(source, size);
+            source += size;
+            return Outcome::Successful;
+        } else if constexpr (is_vector_attribute<T>::value) {
+            typedef typename T::value_type E;
+            uint64 count = 0;
+            if (Encoder::read_size(source, end, count).failed())
+                return Outcome::Failed;
+            if (__detail__::is_never_empty<E>() &&
+                count > (uint64) (end - source))
+                return Outcome::Failed;
+            value.resize(count);
+
+            if constexpr (is_scalar_attribute<E> && !std::is_same_v<E, bool>)
+                return Encoder::read_block(source, end, value.data(), count);
+            else if constexpr (std::is_same_v<E, bool>) {
+                for (uint64 i = 0; i < count; i++) {
+                    bool element = false;
+                    if (read(source, end, element).failed())
+                        return Outcome::Failed;
+                    value[i] = element;
+                }
+                return Outcome::Successful;
+            } else {
+                for (uint64 i = 0; i < count; i++)
+                    if (read(source, end, value[i]).failed())
+                        return Outcome::Failed;
+                return Outcome::Successful;
+            }
+        } else {
+            const auto fields = Fields::of(value);
+            const auto packed = packed_size<T>(fields, Fields::Indices<T>());
+            if (packed != 0) {
+                if (packed > (uint64) (end - source)) return Outcome::Failed;
+                std::memcpy((void*) &std::get<0>(fields), source, packed);
+                source += packed;
+                return Outcome::Successful;
+            }
+            return read_fields<T>(source, end, fields, Fields::Indices<T>());
+        }
+    }
+    template<typename T, typename List, uint64... I>
+    static Outcome read_fields(
+        const byte*&      source,
+        const byte* const end,
+        const List&       fields,
+        std::integer_sequence<uint64, I...>
+    ) {
+        bool successful = true;
+        ((successful = successful &&
+                       read(source, end, std::get<I>(fields)).succeeded()),
+         ...);
+        return successful ? Outcome::Successful : Outcome::Failed;
+    }
+};
+
+/// @brief Static serializer producing the same data as `BinarySerializer`
+typedef StaticSerializer<BinaryEncoder>        StaticBinarySerializer;
+/// @brief Static serializer producing the same data as
+/// `CompactBinarySerializer`
+typedef StaticSerializer<CompactBinaryEncoder> StaticCompactBinarySerializer;
+
+} // namespace CORE_NAMESPACE
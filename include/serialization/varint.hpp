@@ -0,0 +1,214 @@
+/**
+ * @file varint.hpp
+ * @author Android172 (android172unity@gmail.com)
+ * @brief Defines variable length integer encoding used by compact binary
+ * serializers
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+
+#include "serialization_sink.hpp"
+#include "outcome.hpp"
+#include "platform/platform.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace CORE_NAMESPACE {
+
+namespace __detail__ {
+    // Unsigned integer of given size
+    template<uint64 Size>
+    struct unsigned_of_size;
+    template<>
+    struct unsigned_of_size<2> {
+        typedef uint16 type;
+    };
+    template<>
+    struct unsigned_of_size<4> {
+        typedef uint32 type;
+    };
+    template<>
+    struct unsigned_of_size<8> {
+        typedef uint64 type;
+    };
+    template<>
+    struct unsigned_of_size<16> {
+        typedef uint128 type;
+    };
+
+    template<typename T>
+    using unsigned_of = typename unsigned_of_size<sizeof(T)>::type;
+
+    // Maximum encoded size of a varint holding values of type T
+    template<typename T>
+    static const constexpr uint64 varint_max_size = (sizeof(T) * 8 + 6) / 7;
+
+    // -------------------------------------------------------------------------
+    // Zigzag
+    // -------------------------------------------------------------------------
+
+    // Maps signed values to unsigned ones, so that values of small magnitude
+    // become small: 0, -1, 1, -2, 2... map to 0, 1, 2, 3, 4...
+    template<typename T>
+    inline unsigned_of<T> to_wire(const T value) {
+        typedef unsigned_of<T> U;
+        if constexpr ((T) -1 < (T) 0)
+            return ((U) value << 1) ^ (U) (value >> (sizeof(T) * 8 - 1));
+        else return value;
+    }
+    template<typename T>
+    inline T from_wire(const unsigned_of<T> value) {
+        typedef unsigned_of<T> U;
+        if constexpr ((T) -1 < (T) 0)
+            return (T) ((value >> 1) ^ (U) - (value & 1));
+        else return value;
+    }
+
+    // -------------------------------------------------------------------------
+    // Varint encoding
+    // -------------------------------------------------------------------------
+
+    // Encodes @p value at @p target, advancing it past the encoded bytes
+    template<typename U>
+    inline void encode_varint(byte*& target, U value) {
+        while (value >= 0x80) {
+            *target++ = (byte) ((uint8) value | 0x80);
+            value >>= 7;
+        }
+        *target++ = (byte) value;
+    }
+
+    template<typename U>
+    inline void write_varint(SerializationSink& out, const U value) {
+        const auto target = out.reserve(varint_max_size<U>);
+        if (target) {
+            auto end = target;
+            encode_varint(end, value);
+            return out.commit(end - target);
+        }
+
+        byte buffer[varint_max_size<U>];
+        auto end = buffer;
+        encode_varint(end, value);
+        out.write(buffer, end - buffer);
+    }
+
+    // Decodes one varint byte by byte. Fails on truncated input and on values
+    // which don't fit into U.
+    template<typename U>
+    inline Outcome decode_varint(
+        const byte*& source, const byte* const end, U& value
+    ) {
+        const uint32 bits = sizeof(U) * 8;
+        value             = 0;
+        for (uint32 shift = 0; source != end; shift += 7) {
+            const auto b = (uint8) *source++;
+            if (shift >= bits) return Outcome::Failed;
+            if (bits - shift < 7 && ((b & 0x7f) >> (bits - shift)) != 0)
+                return Outcome::Failed;
+
+            value |= (U) (b & 0x7f) << shift;
+            if ((b & 0x80) == 0) return Outcome::Successful;
+        }
+        return Outcome::Failed;
+    }
+
+    // Decodes one varint of at most 64 bits. If 8 bytes can be loaded at
+    // once, varints of up to 8 bytes (56 bits) are decoded without branching
+    // on individual bytes: length is found from the continuation bits, and 7
+    // bit groups are merged pairwise in 3 mask and shift steps.
+    inline Outcome decode_varint_fast(
+        const byte*& source, const byte* const end, uint64& value
+    ) {
+        if (platform::is_little_endian && end - source >= 8) {
+            uint64 word;
+            std::memcpy(&word, source, sizeof(word));
+            const uint64 stops = ~word & 0x8080808080808080ull;
+            if (stops != 0) {
+                const uint32 length = (__builtin_ctzll(stops) >> 3) + 1;
+                word &= ~0ull >> (64 - 8 * length);
+                word &= 0x7f7f7f7f7f7f7f7full;
+                word = (word & 0x007f007f007f007full) |
+                       ((word & 0x7f007f007f007f00ull) >> 1);
+                word = (word & 0x00003fff00003fffull) |
+                       ((word & 0x3fff00003fff0000ull) >> 2);
+                word = (word & 0x000000000fffffffull) |
+                       ((word & 0x0fffffff00000000ull) >> 4);
+                value = word;
+                source += length;
+                return Outcome::Successful;
+            }
+        }
+        return decode_varint(source, end, value);
+    }
+
+    // -------------------------------------------------------------------------
+    // Values
+    // -------------------------------------------------------------------------
+
+    template<typename T>
+    inline void write_varint_value(SerializationSink& out, const T value) {
+        write_varint(out, to_wire(value));
+    }
+
+    template<typename T>
+    inline Outcome read_varint_value(
+        const byte*& source, const byte* const end, T& value
+    ) {
+        typedef unsigned_of<T> U;
+        U                      wire;
+        if constexpr (sizeof(U) <= sizeof(uint64)) {
+            uint64 wide;
+            if (decode_varint_fast(source, end, wide).failed())
+                return Outcome::Failed;
+            if (wide > (U) ~(U) 0) return Outcome::Failed;
+            wire = (U) wide;
+        } else if (decode_varint(source, end, wire).failed())
+            return Outcome::Failed;
+        value = from_wire<T>(wire);
+        return Outcome::Successful;
+    }
+
+    template<typename T>
+    inline void write_varint_values(
+        SerializationSink& out, const T* const values, const uint64 count
+    ) {
+        // Encode chunk by chunk, directly into the sink if possible
+        const uint64 max_size    = varint_max_size<T>;
+        const uint64 chunk_count = StreamSink::buffer_size / max_size;
+        for (uint64 i = 0; i < count; i += chunk_count) {
+            const auto n      = std::min(chunk_count, count - i);
+            const auto target = out.reserve(n * max_size);
+            if (!target) {
+                for (uint64 j = i; j < i + n; j++)
+                    write_varint_value(out, values[j]);
+                continue;
+            }
+
+            auto end = target;
+            for (uint64 j = i; j < i + n; j++)
+                encode_varint(end, to_wire(values[j]));
+            out.commit(end - target);
+        }
+    }
+
+    template<typename T>
+    inline Outcome read_varint_values(
+        const byte*&      source,
+        const byte* const end,
+        T* const          values,
+        const uint64      count
+    ) {
+        for (uint64 i = 0; i < count; i++)
+            if (read_varint_value(source, end, values[i]).failed())
+                return Outcome::Failed;
+        return Outcome::Successful;
+    }
+} // namespace __detail__
+
+} // namespace CORE_NAMESPACE
@@ -11,6 +11,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 
 #include "common/defines.hpp"
 #include "result.hpp"
@@ -35,6 +36,12 @@ string to_string(const CORE_NAMESPACE::Vector<unsigned char>& in);
 
 namespace CORE_NAMESPACE {
 
+/**
+ * @brief Non owning, read only view of a character sequence. Doesn't keep
+ * viewed characters alive.
+ */
+typedef std::string_view StringView;
+
 /**
  * @brief String (array of characters). Extends std::string, with some
  * additional methods
@@ -44,8 +51,15 @@ class String : public std::string {
     using std::string::string;
     String() noexcept;
     String(const std::string& __str) noexcept : std::string(__str) {}
+    String(const String&)     = default;
+    String(String&&) noexcept = default;
     ~String() noexcept;
 
+    // Declared destructor would otherwise suppress moves, so they're
+    // defaulted explicitly
+    String& operator=(const String&)     = default;
+    String& operator=(String&&) noexcept = default;
+
     // String builder
     /**
      * @brief Concatenates argument list into one string string object.
@@ -211,6 +225,8 @@ class String : public std::string {
     void* operator new(size_t size) {
         return ::operator new(size, BaseMemoryTags.String);
     }
+    // Placement new (otherwise hidden by the above)
+    void* operator new(size_t, void* ptr) noexcept { return ptr; }
 
   private:
     // String builder
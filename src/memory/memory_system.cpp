@@ -3,7 +3,9 @@
 #include "memory/memory_allocators/c_allocator.hpp"
 #include "memory/memory_allocators/free_list_allocator.hpp"
 #include "memory/memory_allocators/stack_allocator.hpp"
+#include "multithreading/synchronization.hpp"
 
+#include <algorithm>
 #include <cstring>
 #include <iostream>
 
@@ -32,11 +34,18 @@ Allocator**             MemorySystem::_allocator_array =
     MemorySystem::initialize_allocator_array(MemorySystem::_memory_map);
 MemoryTagType MemorySystem::_aa_size = 0;
 
+// Custom allocators aren't thread safe, while allocations can now come from
+// worker threads. All (de)allocations are therefore serialized. Critical
+// sections are short, so a spin lock fits better than a mutex.
+static parallel::SpinLock allocation_lock {};
+
 void* MemorySystem::allocate(uint64 size, const MemoryTag tag) {
+    std::lock_guard<parallel::SpinLock> lock { allocation_lock };
     auto allocator = _allocator_array[tag.id];
     return allocator->allocate(size, MEMORY_PADDING);
 }
 void MemorySystem::deallocate(void* ptr, const MemoryTag tag) {
+    std::lock_guard<parallel::SpinLock> lock { allocation_lock };
     auto allocator = _allocator_array[tag.id];
     if (!allocator->owns(ptr)) {
         std::cerr << MEMORY_SYS_LOG << "Deallocation with wrong memory tag."
@@ -47,6 +56,7 @@ void MemorySystem::deallocate(void* ptr, const MemoryTag tag) {
 }
 
 void MemorySystem::reset_memory(const MemoryTag tag) {
+    std::lock_guard<parallel::SpinLock> lock { allocation_lock };
     auto allocator = _allocator_array[tag.id];
     allocator->reset();
 }
@@ -112,10 +122,14 @@ void MemorySystem::register_tag(const MemoryTag& tag, Allocator& allocator) {
     memory_map[allocator->start()]         = BaseMemoryTags.tag
 
 Allocator** MemorySystem::initialize_allocator_array(MemoryMap& memory_map) {
-    _aa_size = MemoryTag::id_count;
+    // Tag counter is reset once base tags are constructed, so it can't be
+    // relied on for their count
+    const MemoryTagType base_tag_count =
+        sizeof(BaseMemoryTags) / sizeof(MemoryTag);
+    _aa_size = std::max(MemoryTag::id_count, base_tag_count);
 
     // Reserve memory for AA
-    const auto allocator_array = new Allocator*[MemoryTag::id_count]();
+    const auto allocator_array = new Allocator*[_aa_size]();
 
     // Define used allocators
     auto unknown_allocator = new CAllocator();
@@ -138,6 +152,7 @@ Allocator** MemorySystem::initialize_allocator_array(MemoryMap& memory_map) {
     assign_allocator(Set, general_allocator);
     assign_allocator(String, general_allocator);
     assign_allocator(Callback, general_allocator);
+    assign_allocator(Coroutine, general_allocator);
 
     return allocator_array;
 }
@@ -147,7 +162,7 @@ void MemorySystem::update_allocator_array() {
     // Declare new AA
     _allocator_array  = new Allocator*[MemoryTag::id_count]();
     // Copy data over
-    memcpy(_allocator_array, old_aa, _aa_size);
+    memcpy(_allocator_array, old_aa, _aa_size * sizeof(Allocator*));
     // Update size
     _aa_size = MemoryTag::id_count;
 }
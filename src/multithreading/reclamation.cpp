@@ -0,0 +1,282 @@
+#include "multithreading/reclamation.hpp"
+
+#include "container/vector.hpp"
+#include "multithreading/synchronization.hpp"
+
+#include <algorithm>
+#include <thread>
+
+namespace CORE_NAMESPACE {
+
+namespace parallel {
+
+    using __detail__::RetiredObject;
+
+    // Backlog of retired objects can grow large while some reader stalls, so
+    // it is kept out of general purpose memory
+    struct RetiredList : public Vector<RetiredObject> {
+        RetiredList()
+            : Vector<RetiredObject>(
+                  TAllocator<RetiredObject>(BaseMemoryTags.Unknown)
+              ) {}
+    };
+
+    // Objects retired by threads which exited before they could be freed
+    struct OrphanList {
+        SpinLock    lock {};
+        RetiredList objects {};
+
+        void adopt(RetiredList& retired) {
+            if (retired.empty()) return;
+            std::lock_guard<SpinLock> guard { lock };
+            objects.insert(objects.end(), retired.begin(), retired.end());
+            retired.clear();
+        }
+        void take(RetiredList& retired) {
+            if (!lock.try_lock()) return;
+            retired.insert(retired.end(), objects.begin(), objects.end());
+            objects.clear();
+            lock.unlock();
+        }
+    };
+
+    // Frees (and removes) all retired objects for which predicate holds
+    template<typename Predicate>
+    static void free_retired(RetiredList& retired, Predicate can_free) {
+        // Deleters may retire more objects, so safe ones are moved out first
+        const auto it = std::partition(
+            retired.begin(),
+            retired.end(),
+            [&can_free](const RetiredObject& object) {
+                return !can_free(object);
+            }
+        );
+        if (it == retired.end()) return;
+
+        RetiredList safe {};
+        safe.insert(safe.end(), it, retired.end());
+        retired.erase(it, retired.end());
+        for (const auto& object : safe)
+            object.deleter(object.pointer);
+    }
+
+    // -------------------------------------------------------------------------
+    // Epoch based reclamation
+    // -------------------------------------------------------------------------
+
+    // Number of retirements between two reclamation attempts
+    static const constexpr uint64 epoch_collect_interval = 64;
+    // Retired objects above which retiring thread yields to stalled readers
+    static const constexpr uint64 epoch_backlog_limit    = 1024;
+    static const constexpr uint32 epoch_backlog_retries  = 16;
+
+    struct EpochRecord {
+        // Observed global epoch shifted left, lowest bit set while active
+        alignas(cache_line_size) std::atomic<uint64> state { 0 };
+        std::atomic<bool> in_use { true };
+        EpochRecord*      next = nullptr;
+    };
+
+    alignas(cache_line_size) static std::atomic<uint64> global_epoch { 0 };
+    static std::atomic<EpochRecord*> epoch_records { nullptr };
+
+    static OrphanList& epoch_orphans() {
+        static OrphanList orphans {};
+        return orphans;
+    }
+
+    static EpochRecord* acquire_epoch_record() {
+        // Reuse record of an exited thread
+        for (auto record = epoch_records.load(std::memory_order_acquire);
+             record;
+             record = record->next) {
+            bool expected = false;
+            if (record->in_use.compare_exchange_strong(expected, true))
+                return record;
+        }
+
+        // Records are never freed, so they can be iterated without locks
+        const auto record = new EpochRecord();
+        auto       head   = epoch_records.load(std::memory_order_relaxed);
+        do {
+            record->next = head;
+        } while (!epoch_records.compare_exchange_weak(
+            head, record, std::memory_order_release
+        ));
+        return record;
+    }
+
+    struct EpochThreadState {
+        EpochRecord*          record       = nullptr;
+        uint32                nesting      = 0;
+        uint64                retire_count = 0;
+        RetiredList           retired {};
+
+        ~EpochThreadState() {
+            epoch_orphans().adopt(retired);
+            if (record) record->in_use.store(false, std::memory_order_release);
+        }
+    };
+    static thread_local EpochThreadState epoch_thread {};
+
+    // Advances global epoch if all active threads observed the current one
+    static uint64 try_advance_epoch() {
+        auto epoch = global_epoch.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        for (auto record = epoch_records.load(std::memory_order_acquire);
+             record;
+             record = record->next) {
+            const auto state = record->state.load(std::memory_order_acquire);
+            if ((state & 1) && (state >> 1) != epoch) return epoch;
+        }
+        if (global_epoch.compare_exchange_strong(
+                epoch, epoch + 1, std::memory_order_acq_rel
+            ))
+            return epoch + 1;
+        return epoch;
+    }
+
+    void EpochReclamation::enter() {
+        auto& thread = epoch_thread;
+        if (thread.nesting++ != 0) return;
+        if (!thread.record) thread.record = acquire_epoch_record();
+
+        const auto epoch = global_epoch.load(std::memory_order_relaxed);
+        thread.record->state.store((epoch << 1) | 1, std::memory_order_relaxed);
+        // Announcement must be visible before any protected read
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+    void EpochReclamation::exit() {
+        auto& thread = epoch_thread;
+        if (--thread.nesting == 0)
+            thread.record->state.store(0, std::memory_order_release);
+    }
+    bool EpochReclamation::in_critical_region() {
+        return epoch_thread.nesting != 0;
+    }
+
+    void EpochReclamation::retire(void* pointer, void (*deleter)(void*)) {
+        auto& thread = epoch_thread;
+        // Unlinking of the object must precede epoch read
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const auto epoch = global_epoch.load(std::memory_order_relaxed);
+        thread.retired.push_back({ pointer, deleter, epoch });
+        if (++thread.retire_count % epoch_collect_interval != 0) return;
+
+        collect();
+        // Some reader is stalled inside its critical region (ex. preempted),
+        // give it a chance to leave before backlog grows further
+        for (uint32 i = 0; i < epoch_backlog_retries &&
+                           thread.retired.size() >= epoch_backlog_limit;
+             i++) {
+            std::this_thread::yield();
+            collect();
+        }
+    }
+
+    void EpochReclamation::collect() {
+        auto& thread = epoch_thread;
+        epoch_orphans().take(thread.retired);
+
+        // Objects retired 2 epochs ago can't be seen by any active reader
+        const auto epoch = try_advance_epoch();
+        free_retired(thread.retired, [epoch](const RetiredObject& object) {
+            return object.epoch + 2 <= epoch;
+        });
+    }
+
+    void EpochReclamation::synchronize() {
+        while (true) {
+            collect();
+            if (epoch_thread.retired.empty()) break;
+            std::this_thread::yield();
+        }
+    }
+
+    // -------------------------------------------------------------------------
+    // Hazard pointers
+    // -------------------------------------------------------------------------
+
+    using __detail__::HazardRecord;
+
+    static std::atomic<HazardRecord*> hazard_records { nullptr };
+    static std::atomic<uint64>        hazard_record_count { 0 };
+
+    static OrphanList& hazard_orphans() {
+        static OrphanList orphans {};
+        return orphans;
+    }
+
+    struct HazardThreadState {
+        RetiredList retired {};
+
+        ~HazardThreadState() { hazard_orphans().adopt(retired); }
+    };
+    static thread_local HazardThreadState hazard_thread {};
+
+    HazardPointer::HazardPointer() {
+        // Reuse free record
+        for (auto record = hazard_records.load(std::memory_order_acquire);
+             record;
+             record = record->next) {
+            bool expected = false;
+            if (record->in_use.compare_exchange_strong(expected, true)) {
+                _record = record;
+                return;
+            }
+        }
+
+        // Records are never freed, so they can be iterated without locks
+        _record = new HazardRecord();
+        _record->in_use.store(true, std::memory_order_relaxed);
+        auto head = hazard_records.load(std::memory_order_relaxed);
+        do {
+            _record->next = head;
+        } while (!hazard_records.compare_exchange_weak(
+            head, _record, std::memory_order_release
+        ));
+        hazard_record_count.fetch_add(1, std::memory_order_relaxed);
+    }
+    HazardPointer::~HazardPointer() {
+        reset();
+        _record->in_use.store(false, std::memory_order_release);
+    }
+
+    void HazardPointer::retire(void* pointer, void (*deleter)(void*)) {
+        auto& retired = hazard_thread.retired;
+        retired.push_back({ pointer, deleter, 0 });
+
+        // Scanning is linear in number of records, so it is amortized over
+        // proportionally many retirements
+        const auto threshold =
+            2 * hazard_record_count.load(std::memory_order_relaxed) + 64;
+        if (retired.size() >= threshold) collect();
+    }
+
+    void HazardPointer::collect() {
+        auto& retired = hazard_thread.retired;
+        hazard_orphans().take(retired);
+        if (retired.empty()) return;
+
+        // Snapshot all protected pointers
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        Vector<void*> hazards {};
+        for (auto record = hazard_records.load(std::memory_order_acquire);
+             record;
+             record = record->next) {
+            const auto pointer =
+                record->pointer.load(std::memory_order_acquire);
+            if (pointer) hazards.push_back(pointer);
+        }
+        std::sort(hazards.begin(), hazards.end());
+
+        free_retired(retired, [&hazards](const RetiredObject& object) {
+            return !std::binary_search(
+                hazards.begin(), hazards.end(), object.pointer
+            );
+        });
+    }
+
+} // namespace parallel
+
+} // namespace CORE_NAMESPACE
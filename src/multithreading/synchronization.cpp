@@ -0,0 +1,260 @@
+#include "multithreading/synchronization.hpp"
+
+namespace CORE_NAMESPACE {
+
+namespace parallel {
+
+    // Busy waiting limits, before thread is put to sleep
+    static const constexpr uint32 spin_count  = 64;
+    static const constexpr uint32 max_backoff = 64;
+
+    // Spin with exponential backoff. Returns false once limit is reached.
+    static bool spin(uint32& iteration) {
+        if (iteration >= spin_count) return false;
+        const auto pauses = std::min(1u << (iteration / 4), max_backoff);
+        for (uint32 i = 0; i < pauses; i++)
+            cpu_relax();
+        iteration++;
+        return true;
+    }
+
+    // -------------------------------------------------------------------------
+    // Spin lock
+    // -------------------------------------------------------------------------
+
+    void SpinLock::lock_slow() {
+        uint32 iteration = 0;
+        while (spin(iteration)) {
+            uint32 expected = Unlocked;
+            if (_state.load(std::memory_order_relaxed) == Unlocked &&
+                _state.compare_exchange_weak(
+                    expected, Locked, std::memory_order_acquire
+                ))
+                return;
+        }
+
+        // Lock is held for longer, sleep. Lock taken this way is marked
+        // contended, so unlock knows to wake next sleeper.
+        while (_state.exchange(Contended, std::memory_order_acquire) !=
+               Unlocked)
+            platform::futex_wait(&_state, Contended);
+    }
+
+    // -------------------------------------------------------------------------
+    // Reader-writer lock
+    // -------------------------------------------------------------------------
+
+    void RWLock::lock_slow() {
+        uint32 iteration = 0;
+        auto   state     = _state.load(std::memory_order_relaxed);
+        while (true) {
+            // No readers nor writer, take the lock (keeping parked flag)
+            if ((state & (Writer | ReaderMask)) == 0) {
+                if (_state.compare_exchange_weak(
+                        state,
+                        Writer | (state & Parked),
+                        std::memory_order_acquire
+                    ))
+                    return;
+                continue;
+            }
+
+            // Announce ourselves, blocking new readers
+            if ((state & WriterWaiting) == 0) {
+                if (!_state.compare_exchange_weak(
+                        state,
+                        state | WriterWaiting,
+                        std::memory_order_relaxed
+                    ))
+                    continue;
+                state |= WriterWaiting;
+            }
+
+            // Wait for readers to drain
+            if (spin(iteration)) {
+                state = _state.load(std::memory_order_relaxed);
+                continue;
+            }
+            if ((state & Parked) == 0) {
+                if (!_state.compare_exchange_weak(
+                        state, state | Parked, std::memory_order_relaxed
+                    ))
+                    continue;
+                state |= Parked;
+            }
+            platform::futex_wait(&_state, state);
+            state = _state.load(std::memory_order_relaxed);
+        }
+    }
+
+    void RWLock::lock_shared_slow() {
+        uint32 iteration = 0;
+        auto   state     = _state.load(std::memory_order_relaxed);
+        while (true) {
+            if ((state & (Writer | WriterWaiting)) == 0) {
+                if (_state.compare_exchange_weak(
+                        state, state + 1, std::memory_order_acquire
+                    ))
+                    return;
+                continue;
+            }
+
+            if (spin(iteration)) {
+                state = _state.load(std::memory_order_relaxed);
+                continue;
+            }
+            if ((state & Parked) == 0) {
+                if (!_state.compare_exchange_weak(
+                        state, state | Parked, std::memory_order_relaxed
+                    ))
+                    continue;
+                state |= Parked;
+            }
+            platform::futex_wait(&_state, state);
+            state = _state.load(std::memory_order_relaxed);
+        }
+    }
+
+    // -------------------------------------------------------------------------
+    // Parking lot
+    // -------------------------------------------------------------------------
+
+    namespace __detail__ {
+        // Parked thread. Lives on the stack of the parked thread.
+        struct ParkedThread {
+            const void*         key;
+            ParkedThread*       next = nullptr;
+            std::atomic<uint32> unparked { 0 };
+        };
+
+        struct ParkingBucket {
+            SpinLock      lock {};
+            ParkedThread* head = nullptr;
+            ParkedThread* tail = nullptr;
+
+            void push(ParkedThread* thread) {
+                if (tail) tail->next = thread;
+                else head = thread;
+                tail = thread;
+            }
+            // Removes thread after `previous` (or head if nullptr)
+            void remove(ParkedThread* previous, ParkedThread* thread) {
+                if (previous) previous->next = thread->next;
+                else head = thread->next;
+                if (tail == thread) tail = previous;
+            }
+        };
+
+        static const constexpr uint64 parking_bucket_count = 256;
+        static ParkingBucket          parking_buckets[parking_bucket_count] {};
+
+        static ParkingBucket& bucket_of(const void* key) {
+            // Fibonacci hashing
+            const auto hash = ((uint64) key >> 4) * 11400714819323198485ull;
+            return parking_buckets[hash >> 56];
+        }
+    } // namespace __detail__
+
+    bool ParkingLot::park(
+        const void* key,
+        bool (*validate)(void*),
+        void* validate_context,
+        void (*before_sleep)(void*),
+        void*        before_sleep_context,
+        const uint64 timeout_ms
+    ) {
+        using namespace __detail__;
+        auto&        bucket = bucket_of(key);
+        ParkedThread thread {};
+        thread.key = key;
+
+        {
+            std::lock_guard<SpinLock> lock { bucket.lock };
+            if (!validate(validate_context)) return false;
+            bucket.push(&thread);
+        }
+        before_sleep(before_sleep_context);
+
+        // Sleep until unparked
+        while (thread.unparked.load(std::memory_order_acquire) == 0) {
+            if (platform::futex_wait(&thread.unparked, 0, timeout_ms)) continue;
+
+            // Timed out. Leave queue, unless unparked in the meantime.
+            std::lock_guard<SpinLock> lock { bucket.lock };
+            if (thread.unparked.load(std::memory_order_acquire) != 0)
+                return true;
+            ParkedThread* previous = nullptr;
+            for (auto it = bucket.head; it != &thread; it = it->next)
+                previous = it;
+            bucket.remove(previous, &thread);
+            return false;
+        }
+        return true;
+    }
+
+    bool ParkingLot::unpark_one(
+        const void* key, void (*callback)(void*, bool), void* context
+    ) {
+        using namespace __detail__;
+        auto& bucket = bucket_of(key);
+
+        ParkedThread* woken = nullptr;
+        {
+            std::lock_guard<SpinLock> lock { bucket.lock };
+            ParkedThread*             previous = nullptr;
+            for (auto it = bucket.head; it; previous = it, it = it->next) {
+                if (it->key != key) continue;
+                bucket.remove(previous, it);
+                woken = it;
+                break;
+            }
+
+            bool has_more = false;
+            for (auto it = bucket.head; it && !has_more; it = it->next)
+                has_more = it->key == key;
+            callback(context, has_more);
+
+            // Thread may return as soon as flag is set (ex. on timeout), so
+            // it must be set under bucket lock. Wake only touches the address.
+            if (woken) woken->unparked.store(1, std::memory_order_release);
+        }
+        if (woken) platform::futex_wake_one(&woken->unparked);
+        return woken != nullptr;
+    }
+
+    uint64 ParkingLot::unpark_all(const void* key) {
+        using namespace __detail__;
+        auto& bucket = bucket_of(key);
+
+        // Collect threads first, wake them outside of bucket lock
+        ParkedThread* woken[parking_bucket_count];
+        uint64        count = 0, total = 0;
+        while (true) {
+            {
+                std::lock_guard<SpinLock> lock { bucket.lock };
+                ParkedThread*             previous = nullptr;
+                for (auto it = bucket.head;
+                     it && count < parking_bucket_count;) {
+                    const auto next = it->next;
+                    if (it->key == key) {
+                        bucket.remove(previous, it);
+                        woken[count++] = it;
+                    } else previous = it;
+                    it = next;
+                }
+                for (uint64 i = 0; i < count; i++)
+                    woken[i]->unparked.store(1, std::memory_order_release);
+            }
+            for (uint64 i = 0; i < count; i++)
+                platform::futex_wake_one(&woken[i]->unparked);
+
+            total += count;
+            if (count < parking_bucket_count) break;
+            count = 0;
+        }
+        return total;
+    }
+
+} // namespace parallel
+
+} // namespace CORE_NAMESPACE
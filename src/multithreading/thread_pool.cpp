@@ -0,0 +1,114 @@
+#include "multithreading/thread_pool.hpp"
+
+#include "platform/platform.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+namespace CORE_NAMESPACE {
+
+namespace parallel {
+
+    // Pool owning the current thread (nullptr for non worker threads)
+    static thread_local const ThreadPool* current_pool = nullptr;
+
+    // Constructor & Destructor
+    ThreadPool::ThreadPool(const uint32 thread_count) {
+        auto count = thread_count;
+        if (count == 0) count = std::thread::hardware_concurrency();
+        if (count == 0) count = 1;
+
+        _workers.reserve(count);
+        for (uint32 i = 0; i < count; i++)
+            _workers.emplace_back([this]() { worker_loop(); });
+    }
+    ThreadPool::~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock { _mutex };
+            _stopping = true;
+        }
+        _condition.notify_all();
+        for (auto& worker : _workers)
+            worker.join();
+    }
+
+    // ////////////////////////// //
+    // THREAD POOL PUBLIC METHODS //
+    // ////////////////////////// //
+
+    void ThreadPool::submit(Job job) {
+        {
+            std::lock_guard<std::mutex> lock { _mutex };
+            _jobs.push_back(std::move(job));
+        }
+        _condition.notify_one();
+    }
+
+    void ThreadPool::submit_after(const uint64 delay_ms, Job job) {
+        if (delay_ms == 0) return submit(std::move(job));
+
+        const auto deadline = platform::get_absolute_time() + delay_ms * 1e-3;
+        {
+            std::lock_guard<std::mutex> lock { _mutex };
+            _timed_jobs.push_back({ deadline, _timed_sequence++, std::move(job) }
+            );
+            std::push_heap(_timed_jobs.begin(), _timed_jobs.end());
+        }
+        // Wake everyone; sleeping workers need to recompute their timeouts
+        _condition.notify_all();
+    }
+
+    bool ThreadPool::is_worker_thread() const { return current_pool == this; }
+
+    ThreadPool& ThreadPool::global() {
+        static ThreadPool pool {};
+        return pool;
+    }
+
+    // /////////////////////////// //
+    // THREAD POOL PRIVATE METHODS //
+    // /////////////////////////// //
+
+    void ThreadPool::worker_loop() {
+        current_pool = this;
+
+        std::unique_lock<std::mutex> lock { _mutex };
+        while (true) {
+            const auto now = platform::get_absolute_time();
+            release_due_jobs(now);
+
+            // Execute next job
+            if (!_jobs.empty()) {
+                auto job = std::move(_jobs.front());
+                _jobs.pop_front();
+                lock.unlock();
+                job();
+                lock.lock();
+                continue;
+            }
+            if (_stopping) break;
+
+            // Wait for new work (or for the earliest deadline)
+            if (_timed_jobs.empty()) _condition.wait(lock);
+            else {
+                const auto timeout = _timed_jobs.front().deadline - now;
+                _condition.wait_for(
+                    lock, std::chrono::duration<float64>(timeout)
+                );
+            }
+        }
+
+        current_pool = nullptr;
+    }
+
+    void ThreadPool::release_due_jobs(const float64 now) {
+        while (!_timed_jobs.empty() && _timed_jobs.front().deadline <= now) {
+            std::pop_heap(_timed_jobs.begin(), _timed_jobs.end());
+            _jobs.push_back(std::move(_timed_jobs.back().job));
+            _timed_jobs.pop_back();
+        }
+    }
+
+} // namespace parallel
+
+} // namespace CORE_NAMESPACE
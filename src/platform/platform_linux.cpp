@@ -2,6 +2,15 @@
 #if PLATFORM == LINUX
 
 #    include <iostream>
+#    include <cerrno>
+#    include <climits>
+
+#    include <fcntl.h>
+#    include <linux/futex.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <sys/syscall.h>
+#    include <unistd.h>
 
 #    if _POSIX_C_SOURCE >= 199309L
 #        include <time.h>
@@ -32,6 +41,68 @@ namespace platform {
 #    endif
     }
 
+    // ///// //
+    // Futex //
+    // ///// //
+
+    bool futex_wait(
+        std::atomic<uint32>* address, uint32 expected, uint64 timeout_ms
+    ) {
+        struct timespec  ts;
+        struct timespec* timeout = nullptr;
+        if (timeout_ms != uint64_max) {
+            ts.tv_sec  = timeout_ms / 1000;
+            ts.tv_nsec = (timeout_ms % 1000) * 1000000;
+            timeout    = &ts;
+        }
+        const auto result = syscall(
+            SYS_futex, address, FUTEX_WAIT_PRIVATE, expected, timeout, 0, 0
+        );
+        return result == 0 || errno != ETIMEDOUT;
+    }
+    void futex_wake_one(std::atomic<uint32>* address) {
+        syscall(SYS_futex, address, FUTEX_WAKE_PRIVATE, 1, 0, 0, 0);
+    }
+    void futex_wake_all(std::atomic<uint32>* address) {
+        syscall(SYS_futex, address, FUTEX_WAKE_PRIVATE, INT_MAX, 0, 0, 0);
+    }
+
+    // //////////// //
+    // Mapped files //
+    // //////////// //
+
+    const void* map_file(const char* path, uint64& size) {
+        size                 = 0;
+        const int descriptor = open(path, O_RDONLY | O_CLOEXEC);
+        if (descriptor < 0) return nullptr;
+
+        struct stat info;
+        void*       data = MAP_FAILED;
+        if (fstat(descriptor, &info) == 0 && info.st_size > 0) {
+            data = mmap(
+                nullptr, info.st_size, PROT_READ, MAP_PRIVATE, descriptor, 0
+            );
+        }
+        close(descriptor); // Mapping keeps the file referenced
+        if (data == MAP_FAILED) return nullptr;
+
+        size = info.st_size;
+        return data;
+    }
+    void unmap_file(const void* data, uint64 size) {
+        munmap((void*) data, size);
+    }
+    bool sync_file(const char* path) {
+        const int descriptor = open(path, O_WRONLY | O_CLOEXEC);
+        if (descriptor < 0) return false;
+
+        // Syncs all dirty pages of the file, regardless of descriptor used
+        // to write them. File size is synced too; other metadata isn't.
+        const bool synced = fdatasync(descriptor) == 0;
+        close(descriptor);
+        return synced;
+    }
+
     // /////// //
     // Console //
     // /////// //
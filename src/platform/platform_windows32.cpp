@@ -3,6 +3,7 @@
 #if PLATFORM == WINDOWS32
 
 #    include <windows.h>
+#    pragma comment(lib, "Synchronization.lib")
 
 namespace CORE_NAMESPACE {
 
@@ -36,6 +37,77 @@ namespace platform {
         Sleep(static_cast<DWORD>(ms)); //
     }
 
+    // ///// //
+    // Futex //
+    // ///// //
+
+    bool futex_wait(
+        std::atomic<uint32>* address, uint32 expected, uint64 timeout_ms
+    ) {
+        const DWORD timeout =
+            timeout_ms >= INFINITE ? INFINITE : static_cast<DWORD>(timeout_ms);
+        if (WaitOnAddress(address, &expected, sizeof(uint32), timeout))
+            return true;
+        return GetLastError() != ERROR_TIMEOUT;
+    }
+    void futex_wake_one(std::atomic<uint32>* address) {
+        WakeByAddressSingle(address);
+    }
+    void futex_wake_all(std::atomic<uint32>* address) {
+        WakeByAddressAll(address);
+    }
+
+    // //////////// //
+    // Mapped files //
+    // //////////// //
+
+    const void* map_file(const char* path, uint64& size) {
+        size        = 0;
+        HANDLE file = CreateFileA(
+            path,
+            GENERIC_READ,
+            FILE_SHARE_READ,
+            nullptr,
+            OPEN_EXISTING,
+            FILE_ATTRIBUTE_NORMAL,
+            nullptr
+        );
+        if (file == INVALID_HANDLE_VALUE) return nullptr;
+
+        LARGE_INTEGER file_size;
+        HANDLE        mapping = nullptr;
+        if (GetFileSizeEx(file, &file_size) && file_size.QuadPart > 0)
+            mapping =
+                CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file);
+        if (mapping == nullptr) return nullptr;
+
+        // View keeps the mapping referenced
+        const void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(mapping);
+        if (data == nullptr) return nullptr;
+
+        size = file_size.QuadPart;
+        return data;
+    }
+    void unmap_file(const void* data, uint64 size) { UnmapViewOfFile(data); }
+    bool sync_file(const char* path) {
+        HANDLE file = CreateFileA(
+            path,
+            GENERIC_WRITE,
+            FILE_SHARE_READ | FILE_SHARE_WRITE,
+            nullptr,
+            OPEN_EXISTING,
+            FILE_ATTRIBUTE_NORMAL,
+            nullptr
+        );
+        if (file == INVALID_HANDLE_VALUE) return false;
+
+        const bool synced = FlushFileBuffers(file) != 0;
+        CloseHandle(file);
+        return synced;
+    }
+
     // /////// //
     // Console //
     // /////// //
@@ -2,21 +2,115 @@
 
 #include "platform/platform.hpp"
 
+#include <cstring>
+
 namespace CORE_NAMESPACE {
 
+// Byte order reversal of single values
+static uint16 byte_swap(const uint16 value) { return __builtin_bswap16(value); }
+static uint32 byte_swap(const uint32 value) { return __builtin_bswap32(value); }
+static uint64 byte_swap(const uint64 value) { return __builtin_bswap64(value); }
+static uint128 byte_swap(const uint128 value) {
+    return ((uint128) byte_swap((uint64) value) << 64) |
+           byte_swap((uint64) (value >> 64));
+}
+
+// Copies @p count values while reversing their byte order. Kept as a plain
+// loop over unaligned loads and stores, so compiler can vectorize it.
+template<typename T>
+static void copy_swapped(
+    byte* const destination, const byte* const source, const uint64 count
+) {
+    for (uint64 i = 0; i < count; i++) {
+        T value;
+        std::memcpy(&value, source + i * sizeof(T), sizeof(T));
+        value = byte_swap(value);
+        std::memcpy(destination + i * sizeof(T), &value, sizeof(T));
+    }
+}
+static void copy_swapped(
+    byte* const       destination,
+    const byte* const source,
+    const uint64      count,
+    const uint8       type_size
+) {
+    switch (type_size) {
+    case 2: return copy_swapped<uint16>(destination, source, count);
+    case 4: return copy_swapped<uint32>(destination, source, count);
+    case 8: return copy_swapped<uint64>(destination, source, count);
+    case 16: return copy_swapped<uint128>(destination, source, count);
+    default: std::memcpy(destination, source, count * type_size);
+    }
+}
+
+// Header: magic, format id and wire byte order
+static const byte header_magic[2] = { 'B', 'S' };
+
+// //////////////////////////////// //
+// BINARY SERIALIZER PUBLIC METHODS //
+// //////////////////////////////// //
+
+BinarySerializer::BinarySerializer(const Endianness wire_endianness)
+    : _wire_endianness(wire_endianness),
+      _swap_bytes(
+          (wire_endianness == Endianness::Little) != platform::is_little_endian
+      ) {}
+
+void BinarySerializer::write_header(SerializationSink& out) const {
+    const byte header[header_size] = { header_magic[0],
+                                       header_magic[1],
+                                       (byte) format_id(),
+                                       (byte) _wire_endianness };
+    out.write(header, header_size);
+}
+Result<void, RuntimeError> BinarySerializer::read_header(
+    const String& data, uint64& position
+) const {
+    const auto endianness = header_endianness(data, position);
+    if (endianness.has_error()) return Failure(endianness.error());
+    if ((uint8) data[position + 2] != format_id())
+        return Failure(RuntimeError(
+            "Binary deserialization failed. Data was serialized with "
+            "different encoding."
+        ));
+    if (endianness.value() != _wire_endianness)
+        return Failure(RuntimeError(
+            "Binary deserialization failed. Data was serialized with "
+            "different byte order."
+        ));
+    position += header_size;
+    return {};
+}
+
+Result<Endianness, RuntimeError> BinarySerializer::header_endianness(
+    const String& data, const uint64 position
+) {
+    if (position > data.size() || data.size() - position < header_size ||
+        data[position] != header_magic[0] ||
+        data[position + 1] != header_magic[1])
+        return Failure(RuntimeError(
+            "Binary deserialization failed. Missing binary serializer header."
+        ));
+    const auto endianness = (Endianness) data[position + 3];
+    if (endianness != Endianness::Little && endianness != Endianness::Big)
+        return Failure(RuntimeError(
+            "Binary deserialization failed. Invalid byte order in header."
+        ));
+    return endianness;
+}
+
 // /////////////////////////////////// //
 // BINARY SERIALIZER PROTECTED METHODS //
 // /////////////////////////////////// //
 
 #define SERIALIZE_PRIMITIVE_TYPE(T)                                            \
-    void BinarySerializer::serialize_type(String& out_str, const T data)       \
-        const {                                                                \
-        void* const data_p = (void* const) &data;                              \
-        const uint8 size   = sizeof(T);                                        \
-        serialize_primitive(out_str, data_p, size);                            \
+    void BinarySerializer::serialize_type(                                     \
+        SerializationSink& out, const T data                                   \
+    ) const {                                                                  \
+        serialize_primitive(out, &data, sizeof(T));                            \
     }                                                                          \
     Outcome BinarySerializer::deserialize_type(                                \
-        const String& in_str, T& data, uint32& position                        \
+        const String& in_str, T& data, uint64& position                        \
     ) const {                                                                  \
         byte* const data_p = (byte* const) &data;                              \
         const uint8 size   = sizeof(T);                                        \
@@ -39,119 +133,131 @@ SERIALIZE_PRIMITIVE_TYPE(float32)
 SERIALIZE_PRIMITIVE_TYPE(float64)
 
 void BinarySerializer::serialize_primitive(
-    String& out_str, void* const data, const uint8& size
+    SerializationSink& out, const void* const data, const uint8 size
 ) const {
-    byte* bytes = (byte*) data;
-    if (platform::is_little_endian) {
-        for (uint32 i = 0; i < size / 2; i++) {
-            auto j   = size - 1 - i;
-            auto t   = bytes[i];
-            bytes[i] = bytes[j];
-            bytes[j] = t;
-        }
-    }
-    out_str += std::string(bytes, size);
+    if (!_swap_bytes || size == 1) return out.write(data, size);
+
+    byte swapped[sizeof(uint128)];
+    copy_swapped(swapped, (const byte*) data, 1, size);
+    out.write(swapped, size);
 }
 Outcome BinarySerializer::deserialize_primitive(
     const String& data,
-    uint32&       position,
+    uint64&       position,
     byte* const   out_data,
-    const uint8&  size
+    const uint8   size
 ) const {
-    auto bytes = (byte*) (data.data() + position);
-    if (platform::is_little_endian)
-        for (uint32 i = 0; i < size; i++)
-            out_data[i] = bytes[size - 1 - i];
-    else
-        for (uint32 i = 0; i < size; i++)
-            out_data[i] = bytes[i];
+    if (position > data.size() || data.size() - position < size)
+        return Outcome::Failed;
+
+    const auto bytes = data.data() + position;
+    if (_swap_bytes) copy_swapped(out_data, bytes, 1, size);
+    else std::memcpy(out_data, bytes, size);
     position += size;
     return Outcome::Successful;
 }
 
-void BinarySerializer::serialize_type(String& out_str, const String& data)
-    const {
-    out_str += data;
-    out_str += '\0';
+void BinarySerializer::serialize_type(
+    SerializationSink& out, const String& data
+) const {
+    serialize_type(out, StringView { data });
+}
+void BinarySerializer::serialize_type(
+    SerializationSink& out, const StringView data
+) const {
+    serialize_size(out, data.size());
+    out.write(data.data(), data.size());
+}
+Outcome BinarySerializer::deserialize_type(
+    const String& in_str, String& data, uint64& position
+) const {
+    StringView view {};
+    if (deserialize_type(in_str, view, position).failed())
+        return Outcome::Failed;
+    data.assign(view.data(), view.size());
+    return Outcome::Successful;
 }
 Outcome BinarySerializer::deserialize_type(
-    const String& in_str, String& data, uint32& position
+    const String& in_str, StringView& data, uint64& position
 ) const {
-    auto end_i = in_str.find('\0', position);
-    if (end_i == std::string::npos) return Outcome::Failed;
-    data = in_str.substr(position, end_i - position);
-    position += data.size() + 1;
+    uint64 size = 0;
+    auto   end  = position;
+    if (deserialize_size(in_str, size, end).failed()) return Outcome::Failed;
+    if (size > in_str.size() - end) return Outcome::Failed;
+
+    data     = StringView { in_str.data() + end, size };
+    position = end + size;
     return Outcome::Successful;
 }
 
-// void BinarySerializer::serialize_type(String& out_str, const glm::vec1& data)
+// void BinarySerializer::serialize_type(SerializationSink& out, const glm::vec1& data)
 //     const {
-//     serialize_type(out_str, data.x);
+//     serialize_type(out, data.x);
 // }
-// void BinarySerializer::serialize_type(String& out_str, const glm::vec2& data)
+// void BinarySerializer::serialize_type(SerializationSink& out, const glm::vec2& data)
 //     const {
-//     serialize_type(out_str, data.x);
-//     serialize_type(out_str, data.y);
+//     serialize_type(out, data.x);
+//     serialize_type(out, data.y);
 // }
-// void BinarySerializer::serialize_type(String& out_str, const glm::vec3& data)
+// void BinarySerializer::serialize_type(SerializationSink& out, const glm::vec3& data)
 //     const {
-//     serialize_type(out_str, data.x);
-//     serialize_type(out_str, data.y);
-//     serialize_type(out_str, data.z);
+//     serialize_type(out, data.x);
+//     serialize_type(out, data.y);
+//     serialize_type(out, data.z);
 // }
-// void BinarySerializer::serialize_type(String& out_str, const glm::vec4& data)
+// void BinarySerializer::serialize_type(SerializationSink& out, const glm::vec4& data)
 //     const {
-//     serialize_type(out_str, data.x);
-//     serialize_type(out_str, data.y);
-//     serialize_type(out_str, data.z);
-//     serialize_type(out_str, data.w);
+//     serialize_type(out, data.x);
+//     serialize_type(out, data.y);
+//     serialize_type(out, data.z);
+//     serialize_type(out, data.w);
 // }
-// void BinarySerializer::serialize_type(String& out_str, const glm::mat2& data)
+// void BinarySerializer::serialize_type(SerializationSink& out, const glm::mat2& data)
 //     const {
-//     serialize_type(out_str, data[0][0]);
-//     serialize_type(out_str, data[0][1]);
-//     serialize_type(out_str, data[1][0]);
-//     serialize_type(out_str, data[1][1]);
+//     serialize_type(out, data[0][0]);
+//     serialize_type(out, data[0][1]);
+//     serialize_type(out, data[1][0]);
+//     serialize_type(out, data[1][1]);
 // }
-// void BinarySerializer::serialize_type(String& out_str, const glm::mat3& data)
+// void BinarySerializer::serialize_type(SerializationSink& out, const glm::mat3& data)
 //     const {
-//     serialize_type(out_str, data[0][0]);
-//     serialize_type(out_str, data[0][1]);
-//     serialize_type(out_str, data[0][2]);
-//     serialize_type(out_str, data[1][0]);
-//     serialize_type(out_str, data[1][1]);
-//     serialize_type(out_str, data[1][2]);
-//     serialize_type(out_str, data[2][0]);
-//     serialize_type(out_str, data[2][1]);
-//     serialize_type(out_str, data[2][2]);
+//     serialize_type(out, data[0][0]);
+//     serialize_type(out, data[0][1]);
+//     serialize_type(out, data[0][2]);
+//     serialize_type(out, data[1][0]);
+//     serialize_type(out, data[1][1]);
+//     serialize_type(out, data[1][2]);
+//     serialize_type(out, data[2][0]);
+//     serialize_type(out, data[2][1]);
+//     serialize_type(out, data[2][2]);
 // }
-// void BinarySerializer::serialize_type(String& out_str, const glm::mat4& data)
+// void BinarySerializer::serialize_type(SerializationSink& out, const glm::mat4& data)
 //     const {
-//     serialize_type(out_str, data[0][0]);
-//     serialize_type(out_str, data[0][1]);
-//     serialize_type(out_str, data[0][2]);
-//     serialize_type(out_str, data[0][3]);
-//     serialize_type(out_str, data[1][0]);
-//     serialize_type(out_str, data[1][1]);
-//     serialize_type(out_str, data[1][2]);
-//     serialize_type(out_str, data[1][3]);
-//     serialize_type(out_str, data[2][0]);
-//     serialize_type(out_str, data[2][1]);
-//     serialize_type(out_str, data[2][2]);
-//     serialize_type(out_str, data[2][3]);
-//     serialize_type(out_str, data[3][0]);
-//     serialize_type(out_str, data[3][1]);
-//     serialize_type(out_str, data[3][2]);
-//     serialize_type(out_str, data[3][3]);
+//     serialize_type(out, data[0][0]);
+//     serialize_type(out, data[0][1]);
+//     serialize_type(out, data[0][2]);
+//     serialize_type(out, data[0][3]);
+//     serialize_type(out, data[1][0]);
+//     serialize_type(out, data[1][1]);
+//     serialize_type(out, data[1][2]);
+//     serialize_type(out, data[1][3]);
+//     serialize_type(out, data[2][0]);
+//     serialize_type(out, data[2][1]);
+//     serialize_type(out, data[2][2]);
+//     serialize_type(out, data[2][3]);
+//     serialize_type(out, data[3][0]);
+//     serialize_type(out, data[3][1]);
+//     serialize_type(out, data[3][2]);
+//     serialize_type(out, data[3][3]);
 // }
 
 // Outcome BinarySerializer::deserialize_type(
-//     const String& in_str, glm::vec1& data, uint32& position
+//     const String& in_str, glm::vec1& data, uint64& position
 // ) const {
 //     return deserialize_type(in_str, data.x, position);
 // }
 // Outcome BinarySerializer::deserialize_type(
-//     const String& in_str, glm::vec2& data, uint32& position
+//     const String& in_str, glm::vec2& data, uint64& position
 // ) const {
 //     if (deserialize_type(in_str, data.x, position).failed())
 //         return Outcome::Failed;
@@ -160,7 +266,7 @@ Outcome BinarySerializer::deserialize_type(
 //     return Outcome::Successful;
 // }
 // Outcome BinarySerializer::deserialize_type(
-//     const String& in_str, glm::vec3& data, uint32& position
+//     const String& in_str, glm::vec3& data, uint64& position
 // ) const {
 //     if (deserialize_type(in_str, data.x, position).failed())
 //         return Outcome::Failed;
@@ -171,7 +277,7 @@ Outcome BinarySerializer::deserialize_type(
 //     return Outcome::Successful;
 // }
 // Outcome BinarySerializer::deserialize_type(
-//     const String& in_str, glm::vec4& data, uint32& position
+//     const String& in_str, glm::vec4& data, uint64& position
 // ) const {
 //     if (deserialize_type(in_str, data.x, position).failed())
 //         return Outcome::Failed;
@@ -184,7 +290,7 @@ Outcome BinarySerializer::deserialize_type(
 //     return Outcome::Successful;
 // }
 // Outcome BinarySerializer::deserialize_type(
-//     const String& in_str, glm::mat2& data, uint32& position
+//     const String& in_str, glm::mat2& data, uint64& position
 // ) const {
 //     if (deserialize_type(in_str, data[0][0], position).failed())
 //         return Outcome::Failed;
@@ -197,7 +303,7 @@ Outcome BinarySerializer::deserialize_type(
 //     return Outcome::Successful;
 // }
 // Outcome BinarySerializer::deserialize_type(
-//     const String& in_str, glm::mat3& data, uint32& position
+//     const String& in_str, glm::mat3& data, uint64& position
 // ) const {
 //     if (deserialize_type(in_str, data[0][0], position).failed())
 //         return Outcome::Failed;
@@ -220,7 +326,7 @@ Outcome BinarySerializer::deserialize_type(
 //     return Outcome::Successful;
 // }
 // Outcome BinarySerializer::deserialize_type(
-//     const String& in_str, glm::mat4& data, uint32& position
+//     const String& in_str, glm::mat4& data, uint64& position
 // ) const {
 //     if (deserialize_type(in_str, data[0][0], position).failed())
 //         return Outcome::Failed;
@@ -258,17 +364,74 @@ Outcome BinarySerializer::deserialize_type(
 // }
 
 void BinarySerializer::vector_add_beg(
-    String& out_str, const uint64 count, const uint64 type_size
+    SerializationSink& out, const uint64 count, const uint64 type_size
 ) const {
-    serialize_type(out_str, count);
+    serialize_size(out, count);
 }
 Outcome BinarySerializer::vector_remove_beg(
     const String& in_str,
     uint64&       count,
     const uint64  type_size,
-    uint32&       position
+    uint64&       position
+) const {
+    return deserialize_size(in_str, count, position);
+}
+
+void BinarySerializer::serialize_size(
+    SerializationSink& out, const uint64 size
 ) const {
-    return deserialize_type(in_str, count, position);
+    serialize_type(out, size);
+}
+Outcome BinarySerializer::deserialize_size(
+    const String& in_str, uint64& size, uint64& position
+) const {
+    return deserialize_type(in_str, size, position);
+}
+
+void BinarySerializer::serialize_block(
+    SerializationSink& out,
+    const void* const  data,
+    const uint64       count,
+    const BlockElement element
+) const {
+    const auto type_size = element.size;
+    const auto bytes     = (const byte*) data;
+    if (type_size == 1 || !_swap_bytes)
+        return out.write(bytes, count * type_size);
+
+    // Swap chunk by chunk, directly into the sink if possible
+    const uint64 chunk_count = StreamSink::buffer_size / type_size;
+    byte         buffer[StreamSink::buffer_size];
+    for (uint64 i = 0; i < count; i += chunk_count) {
+        const auto n      = std::min(chunk_count, count - i);
+        const auto source = bytes + i * type_size;
+        const auto target = out.reserve(n * type_size);
+        if (target) {
+            copy_swapped(target, source, n, type_size);
+            out.commit(n * type_size);
+        } else {
+            copy_swapped(buffer, source, n, type_size);
+            out.write(buffer, n * type_size);
+        }
+    }
+}
+Outcome BinarySerializer::deserialize_block(
+    const String&      in_str,
+    void* const        data,
+    const uint64       count,
+    const BlockElement element,
+    uint64&            position
+) const {
+    const auto type_size = element.size;
+    if (position > in_str.size()) return Outcome::Failed;
+    if (count > (in_str.size() - position) / type_size) return Outcome::Failed;
+
+    const auto source = in_str.data() + position;
+    if (type_size == 1 || !_swap_bytes)
+        std::memcpy(data, source, count * type_size);
+    else copy_swapped((byte*) data, source, count, type_size);
+    position += count * type_size;
+    return Outcome::Successful;
 }
 
 } // namespace CORE_NAMESPACE
\ No newline at end of file
@@ -0,0 +1,121 @@
+#include "serialization/compact_binary_serializer.hpp"
+#include "serialization/varint.hpp"
+
+namespace CORE_NAMESPACE {
+
+using namespace __detail__;
+
+template<typename T>
+static Outcome read_value(const String& in_str, T& value, uint64& position) {
+    if (position > in_str.size()) return Outcome::Failed;
+    const byte* source = in_str.data() + position;
+    const auto  end    = in_str.data() + in_str.size();
+    if (read_varint_value(source, end, value).failed()) return Outcome::Failed;
+    position = source - in_str.data();
+    return Outcome::Successful;
+}
+
+template<typename T>
+static Outcome read_values(
+    const String& in_str, T* const values, const uint64 count, uint64& position
+) {
+    if (position > in_str.size()) return Outcome::Failed;
+    const byte* source = in_str.data() + position;
+    const auto  end    = in_str.data() + in_str.size();
+    if (read_varint_values(source, end, values, count).failed())
+        return Outcome::Failed;
+    position = source - in_str.data();
+    return Outcome::Successful;
+}
+
+// /////////////////////////////////////////// //
+// COMPACT BINARY SERIALIZER PROTECTED METHODS //
+// /////////////////////////////////////////// //
+
+#define SERIALIZE_INTEGER_TYPE(T)                                              \
+    void CompactBinarySerializer::serialize_type(                              \
+        SerializationSink& out, const T data                                   \
+    ) const {                                                                  \
+        write_varint_value(out, data);                                         \
+    }                                                                          \
+    Outcome CompactBinarySerializer::deserialize_type(                         \
+        const String& in_str, T& data, uint64& position                        \
+    ) const {                                                                  \
+        return read_value(in_str, data, position);                             \
+    }
+
+SERIALIZE_INTEGER_TYPE(int16)
+SERIALIZE_INTEGER_TYPE(int32)
+SERIALIZE_INTEGER_TYPE(int64)
+SERIALIZE_INTEGER_TYPE(int128)
+SERIALIZE_INTEGER_TYPE(uint16)
+SERIALIZE_INTEGER_TYPE(uint32)
+SERIALIZE_INTEGER_TYPE(uint64)
+SERIALIZE_INTEGER_TYPE(uint128)
+
+// Returns call(T), for integer type T described by element
+#define DISPATCH_INTEGER_TYPE(element, call)                                   \
+    switch (element.size) {                                                    \
+    case 2:                                                                    \
+        if (element.is_signed) return call(int16);                             \
+        return call(uint16);                                                   \
+    case 4:                                                                    \
+        if (element.is_signed) return call(int32);                             \
+        return call(uint32);                                                   \
+    case 8:                                                                    \
+        if (element.is_signed) return call(int64);                             \
+        return call(uint64);                                                   \
+    default:                                                                   \
+        if (element.is_signed) return call(int128);                            \
+        return call(uint128);                                                  \
+    }
+
+void CompactBinarySerializer::serialize_block(
+    SerializationSink& out,
+    const void* const  data,
+    const uint64       count,
+    const BlockElement element
+) const {
+    if (element.is_floating_point || element.size == 1)
+        return BinarySerializer::serialize_block(out, data, count, element);
+
+#define WRITE_VALUES(T) write_varint_values(out, (const T*) data, count)
+    DISPATCH_INTEGER_TYPE(element, WRITE_VALUES)
+#undef WRITE_VALUES
+}
+Outcome CompactBinarySerializer::deserialize_block(
+    const String&      in_str,
+    void* const        data,
+    const uint64       count,
+    const BlockElement element,
+    uint64&            position
+) const {
+    if (element.is_floating_point || element.size == 1)
+        return BinarySerializer::deserialize_block(
+            in_str, data, count, element, position
+        );
+
+#define READ_VALUES(T) read_values(in_str, (T*) data, count, position)
+    DISPATCH_INTEGER_TYPE(element, READ_VALUES)
+#undef READ_VALUES
+}
+uint64 CompactBinarySerializer::min_block_element_size(
+    const BlockElement element
+) const {
+    // Integers are varints of at least a byte
+    if (element.is_floating_point || element.size == 1) return element.size;
+    return 1;
+}
+
+void CompactBinarySerializer::serialize_size(
+    SerializationSink& out, const uint64 size
+) const {
+    write_varint(out, size);
+}
+Outcome CompactBinarySerializer::deserialize_size(
+    const String& in_str, uint64& size, uint64& position
+) const {
+    return read_value(in_str, size, position);
+}
+
+} // namespace CORE_NAMESPACE
@@ -0,0 +1,864 @@
+#include "serialization/compression.hpp"
+
+#include "container/vector.hpp"
+#include "platform/platform.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+namespace CORE_NAMESPACE {
+
+// Container constants
+static const constexpr uint8  container_version = 1;
+static const constexpr uint8  entropy_flag      = 0x01;
+static const constexpr uint64 index_entry_size  = sizeof(uint64);
+
+// Block methods
+static const constexpr uint8 method_stored  = 0;
+static const constexpr uint8 method_lz      = 1;
+static const constexpr uint8 method_huffman = 2;
+
+// LZ format constants
+static const constexpr uint32 hash_log      = 12;
+static const constexpr uint64 min_match     = 4;
+static const constexpr uint64 max_offset    = 65535;
+// Last bytes of a block are always literals, and no match starts in the last
+// `match_limit` bytes. This leaves room for word sized reads while searching.
+static const constexpr uint64 last_literals = 5;
+static const constexpr uint64 match_limit   = 12;
+
+// Huffman constants
+static const constexpr uint32 max_code_length = 12;
+static const constexpr uint32 symbol_count    = 256;
+// Code lengths are stored as nibbles
+static const constexpr uint64 lengths_size    = symbol_count / 2;
+
+// //////////////// //
+// ENCODING HELPERS //
+// //////////////// //
+
+static void store_u32(byte* const target, const uint32 value) {
+    for (uint32 i = 0; i < sizeof(uint32); i++)
+        target[i] = (byte) (value >> (8 * i));
+}
+static void store_u64(byte* const target, const uint64 value) {
+    for (uint32 i = 0; i < sizeof(uint64); i++)
+        target[i] = (byte) (value >> (8 * i));
+}
+static uint32 load_u32(const byte* const source) {
+    uint32 value = 0;
+    for (uint32 i = 0; i < sizeof(uint32); i++)
+        value |= (uint32) (uint8) source[i] << (8 * i);
+    return value;
+}
+static uint64 load_u64(const byte* const source) {
+    uint64 value = 0;
+    for (uint32 i = 0; i < sizeof(uint64); i++)
+        value |= (uint64) (uint8) source[i] << (8 * i);
+    return value;
+}
+
+static uint32 read32(const byte* const source) {
+    uint32 value;
+    std::memcpy(&value, source, sizeof(value));
+    return value;
+}
+static uint64 read64(const byte* const source) {
+    uint64 value;
+    std::memcpy(&value, source, sizeof(value));
+    return value;
+}
+
+// ///////// //
+// LZ CODING //
+// ///////// //
+
+// Upper bound of LZ encoded size of @p size bytes
+static uint64 lz_bound(const uint64 size) { return size + size / 255 + 16; }
+// Upper bound of decoded size of @p size bytes of LZ data. Output grows by at
+// most 255 bytes per input byte (a length byte), besides the first sequence.
+static uint64 lz_decoded_bound(const uint64 size) { return size * 255 + 32; }
+
+static uint32 hash_of(const uint32 sequence) {
+    return (sequence * 2654435761u) >> (32 - hash_log);
+}
+
+// Number of equal bytes at @p current and earlier @p match, with @p current
+// not passing @p limit. Compares a word at a time.
+static uint64 match_length(
+    const byte* current, const byte* match, const byte* const limit
+) {
+    const auto start = current;
+    while (limit - current >= 8) {
+        const uint64 difference = read64(current) ^ read64(match);
+        if (difference != 0) {
+            const uint32 bits = platform::is_little_endian
+                                    ? __builtin_ctzll(difference)
+                                    : __builtin_clzll(difference);
+            return (uint64) (current - start) + (bits >> 3);
+        }
+        current += 8;
+        match += 8;
+    }
+    while (current < limit && *current == *match) {
+        current++;
+        match++;
+    }
+    return (uint64) (current - start);
+}
+
+// Writes length remaining after token's 4 bits are saturated
+static void write_length(byte*& target, uint64 length) {
+    length -= 15;
+    for (; length >= 255; length -= 255)
+        *target++ = (byte) 255;
+    *target++ = (byte) length;
+}
+static Outcome read_length(
+    const byte*& source, const byte* const end, uint64& length, uint64 limit
+) {
+    uint8 value;
+    do {
+        if (source == end || length > limit) return Outcome::Failed;
+        value = (uint8) *source++;
+        length += value;
+    } while (value == 255);
+    return Outcome::Successful;
+}
+
+static byte* write_literals(
+    byte* target, const byte* const literals, const uint64 count, uint8 token
+) {
+    token |= (uint8) (std::min<uint64>(count, 15) << 4);
+    *target++ = (byte) token;
+    if (count >= 15) write_length(target, count);
+    std::memcpy(target, literals, count);
+    return target + count;
+}
+
+static byte* write_sequence(
+    byte*             target,
+    const byte* const literals,
+    const uint64      literal_count,
+    const uint64      offset,
+    const uint64      match_count
+) {
+    const auto token  = target;
+    const auto length = match_count - min_match;
+    target = write_literals(target, literals, literal_count, 0);
+    *token = (byte) ((uint8) *token | (uint8) std::min<uint64>(length, 15));
+    *target++ = (byte) offset;
+    *target++ = (byte) (offset >> 8);
+    if (length >= 15) write_length(target, length);
+    return target;
+}
+
+// Greedy LZ77 encoding, with single entry hash table of 4 byte sequences.
+// Search step grows while no match is found, so incompressible data is
+// skipped quickly. Returns encoded size.
+static uint64 lz_compress(
+    const byte* const source, const uint64 size, byte* const target
+) {
+    const auto end    = source + size;
+    auto       anchor = source;
+    auto       output = target;
+
+    if (size > match_limit) {
+        const auto search_limit = end - match_limit;
+        const auto match_end    = end - last_literals;
+
+        uint32 table[1 << hash_log] = {};
+        auto   current              = source + 1;
+        uint32 step_counter         = 1 << 6;
+        while (current <= search_limit) {
+            const auto hash  = hash_of(read32(current));
+            auto       match = source + table[hash];
+            table[hash]      = (uint32) (current - source);
+
+            if (match >= current || (uint64) (current - match) > max_offset ||
+                read32(match) != read32(current)) {
+                current += step_counter++ >> 6;
+                continue;
+            }
+
+            // Extend match backwards over pending literals
+            while (current > anchor && match > source &&
+                   current[-1] == match[-1]) {
+                current--;
+                match--;
+            }
+            const auto length =
+                min_match +
+                match_length(current + min_match, match + min_match, match_end);
+
+            output = write_sequence(
+                output, anchor, current - anchor, current - match, length
+            );
+            current += length;
+            anchor       = current;
+            step_counter = 1 << 6;
+
+            // Also index a position inside the match
+            if (current <= search_limit)
+                table[hash_of(read32(current - 2))] =
+                    (uint32) (current - 2 - source);
+        }
+    }
+
+    output = write_literals(output, anchor, end - anchor, 0);
+    return (uint64) (output - target);
+}
+
+// Decodes exactly @p size bytes into @p target. Every length and offset is
+// validated, so malformed input fails instead of reading or writing out of
+// bounds. Copies are done in chunks while far enough from the end of output.
+static Outcome lz_decompress(
+    const byte* const source,
+    const uint64      source_size,
+    byte* const       target,
+    const uint64      size
+) {
+    auto       input        = source;
+    const auto input_end    = source + source_size;
+    auto       output       = target;
+    const auto output_end   = target + size;
+
+    while (true) {
+        if (input == input_end) return Outcome::Failed;
+        const auto token = (uint8) *input++;
+
+        // Literals
+        uint64 literal_count = token >> 4;
+        if (literal_count == 15 &&
+            read_length(input, input_end, literal_count, size).failed())
+            return Outcome::Failed;
+        if (literal_count > (uint64) (input_end - input) ||
+            literal_count > (uint64) (output_end - output))
+            return Outcome::Failed;
+        if (literal_count <= 16 && input_end - input >= 16 &&
+            output_end - output >= 16)
+            std::memcpy(output, input, 16);
+        else std::memcpy(output, input, literal_count);
+        input += literal_count;
+        output += literal_count;
+
+        // Last sequence has no match
+        if (input == input_end) break;
+
+        // Match
+        if (input_end - input < 2) return Outcome::Failed;
+        const uint64 offset = (uint8) input[0] | (uint64) (uint8) input[1] << 8;
+        input += 2;
+        if (offset == 0 || offset > (uint64) (output - target))
+            return Outcome::Failed;
+
+        uint64 match_count = token & 15;
+        if (match_count == 15 &&
+            read_length(input, input_end, match_count, size).failed())
+            return Outcome::Failed;
+        match_count += min_match;
+        if (match_count > (uint64) (output_end - output))
+            return Outcome::Failed;
+
+        const byte* match    = output - offset;
+        const auto  copy_end = output + match_count;
+        if (offset >= 8 && (uint64) (output_end - output) >= match_count + 8) {
+            do {
+                std::memcpy(output, match, 8);
+                output += 8;
+                match += 8;
+            } while (output < copy_end);
+            output = copy_end;
+        } else
+            while (output < copy_end)
+                *output++ = *match++;
+    }
+
+    return output == output_end ? Outcome::Successful : Outcome::Failed;
+}
+
+// ////////////// //
+// HUFFMAN CODING //
+// ////////////// //
+
+// Computes Huffman code lengths of symbols with given frequencies, limited to
+// `max_code_length` bits
+static void huffman_lengths(const uint64* const frequencies, uint8* lengths) {
+    // Nodes 0-255 are leaves, others are created by merging
+    uint64 weight[2 * symbol_count];
+    uint32 parent[2 * symbol_count];
+    bool   merged[2 * symbol_count] = {};
+    uint32 node_count               = symbol_count;
+    uint32 used                     = 0;
+    for (uint32 i = 0; i < symbol_count; i++) {
+        weight[i]  = frequencies[i];
+        lengths[i] = 0;
+        if (frequencies[i] != 0) used++;
+        else merged[i] = true;
+    }
+    if (used == 0) return;
+    if (used == 1) {
+        for (uint32 i = 0; i < symbol_count; i++)
+            if (frequencies[i] != 0) lengths[i] = 1;
+        return;
+    }
+
+    // Merge two lightest nodes until one remains
+    for (uint32 remaining = used; remaining > 1; remaining--) {
+        uint32 first = 2 * symbol_count, second = 2 * symbol_count;
+        for (uint32 i = 0; i < node_count; i++) {
+            if (merged[i]) continue;
+            if (first == 2 * symbol_count || weight[i] < weight[first]) {
+                second = first;
+                first  = i;
+            } else if (second == 2 * symbol_count ||
+                       weight[i] < weight[second])
+                second = i;
+        }
+        weight[node_count] = weight[first] + weight[second];
+        merged[first] = merged[second] = true;
+        parent[first] = parent[second] = node_count;
+        merged[node_count++]           = false;
+    }
+
+    // Leaf depth is the code length. Longer codes are clamped, after which
+    // Kraft sum (in units of shortest allowed code) is repaid by lengthening
+    // codes of the rarest symbols that are still below the limit.
+    const uint32 root  = node_count - 1;
+    uint64       kraft = 0;
+    for (uint32 i = 0; i < symbol_count; i++) {
+        if (frequencies[i] == 0) continue;
+        uint32 depth = 0;
+        for (uint32 node = i; node != root; node = parent[node])
+            depth++;
+        lengths[i] = (uint8) std::min(depth, max_code_length);
+        kraft += 1ull << (max_code_length - lengths[i]);
+    }
+    while (kraft > 1ull << max_code_length) {
+        uint32 rarest = symbol_count;
+        for (uint32 i = 0; i < symbol_count; i++) {
+            if (lengths[i] == 0 || lengths[i] == max_code_length) continue;
+            if (rarest == symbol_count || lengths[i] > lengths[rarest] ||
+                (lengths[i] == lengths[rarest] &&
+                 frequencies[i] < frequencies[rarest]))
+                rarest = i;
+        }
+        lengths[rarest]++;
+        kraft -= 1ull << (max_code_length - lengths[rarest]);
+    }
+}
+
+// Assigns canonical codes for given lengths, bit reversed so that they can be
+// written to and read from the least significant end of bit buffer
+static Outcome huffman_codes(const uint8* const lengths, uint16* codes) {
+    uint32 count[max_code_length + 1] = {};
+    for (uint32 i = 0; i < symbol_count; i++)
+        count[lengths[i]]++;
+    count[0] = 0;
+
+    uint32 next[max_code_length + 1] = {};
+    uint32 code                      = 0;
+    for (uint32 length = 1; length <= max_code_length; length++) {
+        code         = (code + count[length - 1]) << 1;
+        next[length] = code;
+        // Over subscribed code can't be decoded
+        if (next[length] + count[length] > 1u << length) return Outcome::Failed;
+    }
+
+    for (uint32 i = 0; i < symbol_count; i++) {
+        const auto length = lengths[i];
+        if (length == 0) continue;
+        const auto canonical = next[length]++;
+        uint32     reversed  = 0;
+        for (uint32 bit = 0; bit < length; bit++)
+            reversed |= ((canonical >> bit) & 1) << (length - 1 - bit);
+        codes[i] = (uint16) reversed;
+    }
+    return Outcome::Successful;
+}
+
+// Appends Huffman coding of @p size bytes of @p source to @p out, if it's
+// smaller than the source. Layout is code length of each symbol as nibbles,
+// followed by the bitstream.
+static bool huffman_compress(
+    const byte* const source, const uint64 size, String& out
+) {
+    uint64 frequencies[symbol_count] = {};
+    for (uint64 i = 0; i < size; i++)
+        frequencies[(uint8) source[i]]++;
+
+    uint8  lengths[symbol_count];
+    uint16 codes[symbol_count] = {};
+    huffman_lengths(frequencies, lengths);
+    if (huffman_codes(lengths, codes).failed()) return false;
+
+    uint64 bit_count = 0;
+    for (uint32 i = 0; i < symbol_count; i++)
+        bit_count += frequencies[i] * lengths[i];
+    const uint64 encoded_size = lengths_size + (bit_count + 7) / 8;
+    if (encoded_size >= size) return false;
+
+    const auto start = out.size();
+    out.resize(start + encoded_size);
+    auto target = out.data() + start;
+    for (uint32 i = 0; i < lengths_size; i++)
+        *target++ = (byte) (lengths[2 * i] | lengths[2 * i + 1] << 4);
+
+    uint64 buffer = 0;
+    uint32 bits   = 0;
+    for (uint64 i = 0; i < size; i++) {
+        const auto symbol = (uint8) source[i];
+        buffer |= (uint64) codes[symbol] << bits;
+        bits += lengths[symbol];
+        for (; bits >= 8; bits -= 8) {
+            *target++ = (byte) buffer;
+            buffer >>= 8;
+        }
+    }
+    if (bits > 0) *target++ = (byte) buffer;
+    return true;
+}
+
+// Decodes exactly @p size symbols into @p target, with a table indexed by
+// next `max_code_length` bits of input
+static Outcome huffman_decompress(
+    const byte* const source,
+    const uint64      source_size,
+    byte* const       target,
+    const uint64      size
+) {
+    if (source_size < lengths_size) return Outcome::Failed;
+    uint8 lengths[symbol_count];
+    for (uint32 i = 0; i < lengths_size; i++) {
+        lengths[2 * i]     = (uint8) source[i] & 0x0f;
+        lengths[2 * i + 1] = (uint8) source[i] >> 4;
+        if (lengths[2 * i] > max_code_length ||
+            lengths[2 * i + 1] > max_code_length)
+            return Outcome::Failed;
+    }
+    uint16 codes[symbol_count] = {};
+    if (huffman_codes(lengths, codes).failed()) return Outcome::Failed;
+
+    // Entries with zero length are left for incomplete codes
+    struct Entry {
+        uint8 symbol;
+        uint8 length;
+    };
+    Entry table[1 << max_code_length] = {};
+    for (uint32 i = 0; i < symbol_count; i++) {
+        const uint32 length = lengths[i];
+        if (length == 0) continue;
+        for (uint32 fill = 0; fill < 1u << (max_code_length - length); fill++)
+            table[codes[i] | fill << length] = { (uint8) i, (uint8) length };
+    }
+
+    auto         input     = source + lengths_size;
+    const auto   input_end = source + source_size;
+    const uint64 available = 8 * (uint64) (input_end - input);
+    uint64       consumed  = 0;
+    uint64       buffer    = 0;
+    uint32       bits      = 0;
+    for (uint64 i = 0; i < size; i++) {
+        if (bits < max_code_length) {
+            if (platform::is_little_endian && input_end - input >= 8) {
+                buffer |= read64(input) << bits;
+                input += (63 - bits) >> 3;
+                bits |= 56;
+            } else
+                // Past the end of input, zero bits are supplied; consuming
+                // them is detected below
+                for (; bits <= 56; bits += 8)
+                    if (input != input_end)
+                        buffer |= (uint64) (uint8) *input++ << bits;
+        }
+
+        const auto entry = table[buffer & ((1u << max_code_length) - 1)];
+        if (entry.length == 0) return Outcome::Failed;
+        target[i] = (byte) entry.symbol;
+        buffer >>= entry.length;
+        bits -= entry.length;
+        consumed += entry.length;
+    }
+    return consumed <= available ? Outcome::Successful : Outcome::Failed;
+}
+
+// ///////////// //
+// BLOCK HELPERS //
+// ///////////// //
+
+// Upper bound of decompressed size of a (non empty) block, by its method
+static uint64 block_decoded_bound(
+    const byte* const block, const uint64 block_size
+) {
+    const auto payload_size = block_size - 1;
+    switch ((uint8) block[0]) {
+    case method_stored: return payload_size;
+    case method_lz: return lz_decoded_bound(payload_size);
+    // Each LZ byte is coded with at least one bit
+    case method_huffman: return lz_decoded_bound(payload_size * 8);
+    default: return 0;
+    }
+}
+
+// //////////////////////////// //
+// COMPRESSION PUBLIC FUNCTIONS //
+// //////////////////////////// //
+
+static void write_header(String& out, const CompressionSettings& settings) {
+    byte header[Compression::header_size] = {
+        'C', 'Z', (byte) container_version,
+        (byte) (settings.entropy ? entropy_flag : 0)
+    };
+    store_u32(header + 4, settings.block_size);
+    out.append(header, sizeof(header));
+}
+
+static void write_footer(
+    String&      out,
+    const uint64 index_offset,
+    const uint64 size,
+    const uint64 block_count
+) {
+    byte footer[Compression::footer_size];
+    store_u64(footer, index_offset);
+    store_u64(footer + 8, size);
+    store_u32(footer + 16, (uint32) block_count);
+    std::memcpy(footer + 20, "CZIX", 4);
+    out.append(footer, sizeof(footer));
+}
+
+static CompressionSettings valid_settings(CompressionSettings settings) {
+    settings.block_size = std::clamp<uint32>(
+        settings.block_size, 1, CompressionSettings::max_block_size
+    );
+    return settings;
+}
+
+String Compression::compress(
+    const StringView           data,
+    const CompressionSettings& settings,
+    parallel::ThreadPool&      pool
+) {
+    const auto   valid       = valid_settings(settings);
+    const uint64 block_size  = valid.block_size;
+    const uint64 block_count = (data.size() + block_size - 1) / block_size;
+
+    // Compress blocks in parallel, then join them
+    Vector<String> blocks(
+        block_count, TAllocator<String>(BaseMemoryTags.Unknown)
+    );
+    pool.run_joined(block_count, [&](const uint64 i) {
+        const auto offset = i * block_size;
+        const auto size   = std::min(block_size, data.size() - offset);
+        compress_block(data.data() + offset, size, valid.entropy, blocks[i]);
+    });
+
+    String out {};
+    uint64 total = header_size + block_count * index_entry_size + footer_size;
+    for (const auto& block : blocks)
+        total += block.size();
+    out.reserve(total);
+
+    write_header(out, valid);
+    String index(block_count * index_entry_size, '\0');
+    for (uint64 i = 0; i < block_count; i++) {
+        store_u64(index.data() + i * index_entry_size, out.size());
+        out.append(blocks[i]);
+    }
+    const auto index_offset = out.size();
+    out.append(index);
+    write_footer(out, index_offset, data.size(), block_count);
+    return out;
+}
+
+Result<String, RuntimeError> Compression::decompress(
+    const StringView data, parallel::ThreadPool& pool
+) {
+    const auto reader = CompressedReader::open(data);
+    if (reader.has_error()) return Failure(reader.error());
+    return reader.value().read_all(pool);
+}
+
+bool Compression::is_compressed(const StringView data) {
+    return data.size() >= header_size && data[0] == 'C' && data[1] == 'Z' &&
+           (uint8) data[2] == container_version;
+}
+
+void Compression::compress_block(
+    const byte* const data, const uint64 size, const bool entropy, String& out
+) {
+    const auto start = out.size();
+    out.resize(start + 1 + lz_bound(size));
+    const auto lz_size = lz_compress(data, size, out.data() + start + 1);
+
+    // Incompressible blocks are stored
+    if (lz_size >= size) {
+        out.resize(start + 1 + size);
+        out[start] = (byte) method_stored;
+        std::memcpy(out.data() + start + 1, data, size);
+        return;
+    }
+    out.resize(start + 1 + lz_size);
+    out[start] = (byte) method_lz;
+    if (!entropy) return;
+
+    // Huffman code LZ output if it helps
+    String entropy_coded(sizeof(uint32), '\0');
+    store_u32(entropy_coded.data(), (uint32) lz_size);
+    if (!huffman_compress(out.data() + start + 1, lz_size, entropy_coded))
+        return;
+    if (entropy_coded.size() >= lz_size) return;
+    out.resize(start);
+    out.push_back((byte) method_huffman);
+    out.append(entropy_coded);
+}
+
+Outcome Compression::decompress_block(
+    const byte* const block,
+    const uint64      block_size,
+    byte* const       out,
+    const uint64      size
+) {
+    if (block_size == 0) return Outcome::Failed;
+    const auto payload      = block + 1;
+    const auto payload_size = block_size - 1;
+    switch ((uint8) block[0]) {
+    case method_stored:
+        if (payload_size != size) return Outcome::Failed;
+        std::memcpy(out, payload, size);
+        return Outcome::Successful;
+    case method_lz: return lz_decompress(payload, payload_size, out, size);
+    case method_huffman: {
+        if (payload_size < sizeof(uint32)) return Outcome::Failed;
+        const uint64 lz_size = load_u32(payload);
+        if (lz_size > lz_bound(size)) return Outcome::Failed;
+        String lz_data(lz_size, '\0');
+        if (huffman_decompress(
+                payload + sizeof(uint32),
+                payload_size - sizeof(uint32),
+                lz_data.data(),
+                lz_size
+            )
+                .failed())
+            return Outcome::Failed;
+        return lz_decompress(lz_data.data(), lz_size, out, size);
+    }
+    default: return Outcome::Failed;
+    }
+}
+
+// //////////////////////////////// //
+// COMPRESSED READER PUBLIC METHODS //
+// //////////////////////////////// //
+
+Result<CompressedReader, RuntimeError> CompressedReader::open(
+    const StringView data
+) {
+    const auto header_size = Compression::header_size;
+    const auto footer_size = Compression::footer_size;
+    if (!Compression::is_compressed(data) ||
+        data.size() < header_size + footer_size)
+        return Failure("Compressed data has invalid header.");
+
+    const auto footer = data.data() + data.size() - footer_size;
+    if (std::memcmp(footer + 20, "CZIX", 4) != 0)
+        return Failure("Compressed data has invalid footer.");
+
+    CompressedReader reader {};
+    reader._data        = data.data();
+    reader._block_size  = load_u32(data.data() + 4);
+    reader._index       = load_u64(footer);
+    reader._size        = load_u64(footer + 8);
+    reader._block_count = load_u32(footer + 16);
+
+    // Index must exactly fill space before footer, and match data size
+    const auto space = data.size() - header_size - footer_size;
+    if (reader._block_size == 0 ||
+        reader._block_size > CompressionSettings::max_block_size ||
+        reader._block_count > space / index_entry_size ||
+        reader._index < header_size || reader._index > header_size + space ||
+        reader._index + reader._block_count * index_entry_size !=
+            data.size() - footer_size ||
+        reader._size / reader._block_size +
+                (reader._size % reader._block_size != 0) !=
+            reader._block_count)
+        return Failure("Compressed data has invalid block index.");
+
+    // Blocks are consecutive and non empty
+    uint64 previous = header_size;
+    for (uint64 i = 0; i < reader._block_count; i++) {
+        const auto begin = reader.block_begin(i);
+        if ((i == 0 && begin != header_size) || (i > 0 && begin <= previous))
+            return Failure("Compressed data has invalid block index.");
+        previous = begin;
+    }
+    if (reader._block_count > 0 && previous >= reader._index)
+        return Failure("Compressed data has invalid block index.");
+
+    // Total size must be one that blocks can decompress into, so forged
+    // sizes fail here instead of allocating for them on read
+    for (uint64 i = 0; i < reader._block_count; i++) {
+        const auto begin = reader.block_begin(i);
+        const auto size  = std::min<uint64>(
+            reader._block_size, reader._size - i * reader._block_size
+        );
+        if (size > block_decoded_bound(
+                       data.data() + begin, reader.block_end(i) - begin
+                   ))
+            return Failure("Compressed data has invalid block index.");
+    }
+    return reader;
+}
+
+Result<uint64, RuntimeError> CompressedReader::read_block(
+    const uint64 index, byte* const out
+) const {
+    if (index >= _block_count)
+        return Failure("Compressed block index out of bounds.");
+
+    const auto begin = block_begin(index);
+    const auto size  = std::min(_block_size, _size - index * _block_size);
+    if (Compression::decompress_block(
+            _data + begin, block_end(index) - begin, out, size
+        )
+            .failed())
+        return Failure("Compressed block is malformed.");
+    return size;
+}
+
+Result<String, RuntimeError> CompressedReader::read(
+    const uint64 offset, const uint64 size
+) const {
+    if (offset > _size || size > _size - offset)
+        return Failure("Compressed data read out of bounds.");
+
+    String out(size, '\0');
+    String block {};
+    for (uint64 position = offset; position < offset + size;) {
+        const auto index        = position / _block_size;
+        const auto block_offset = position % _block_size;
+        const auto count =
+            std::min(_block_size - block_offset, offset + size - position);
+
+        // Whole blocks are decompressed in place
+        auto target = out.data() + (position - offset);
+        if (block_offset != 0 || count < _block_size) {
+            block.resize(_block_size);
+            target = block.data();
+        }
+        const auto read = read_block(index, target);
+        if (read.has_error()) return Failure(read.error());
+        if (target == block.data())
+            std::memcpy(
+                out.data() + (position - offset),
+                block.data() + block_offset,
+                count
+            );
+        position += count;
+    }
+    return out;
+}
+
+Result<String, RuntimeError> CompressedReader::read_all(
+    parallel::ThreadPool& pool
+) const {
+    String            out(_size, '\0');
+    std::atomic<bool> failed { false };
+    pool.run_joined(_block_count, [&](const uint64 i) {
+        if (failed.load(std::memory_order_relaxed)) return;
+        if (read_block(i, out.data() + i * _block_size).has_error())
+            failed.store(true, std::memory_order_relaxed);
+    });
+    if (failed) return Failure("Compressed block is malformed.");
+    return out;
+}
+
+// ///////////////////////////////// //
+// COMPRESSED READER PRIVATE METHODS //
+// ///////////////////////////////// //
+
+uint64 CompressedReader::block_begin(const uint64 index) const {
+    return load_u64(_data + _index + index * index_entry_size);
+}
+uint64 CompressedReader::block_end(const uint64 index) const {
+    return index + 1 < _block_count ? block_begin(index + 1) : _index;
+}
+
+// /////////////////////////////// //
+// COMPRESSION SINK PUBLIC METHODS //
+// /////////////////////////////// //
+
+CompressionSink::CompressionSink(
+    SerializationSink& target, const CompressionSettings& settings
+)
+    : _target(target), _settings(valid_settings(settings)) {
+    _block.resize(_settings.block_size);
+    _begin = _cursor = _block.data();
+    _end             = _begin + _block.size();
+
+    String header {};
+    write_header(header, _settings);
+    _target.write(header.data(), header.size());
+    _written = header.size();
+}
+CompressionSink::~CompressionSink() { finish(); }
+
+void CompressionSink::finish() {
+    if (_finished) return;
+    write_block();
+    _finished = true;
+    _begin = _cursor = _end = nullptr;
+
+    String tail { std::move(_index) };
+    const auto block_count = tail.size() / index_entry_size;
+    write_footer(tail, _written, _offset, block_count);
+    _target.write(tail.data(), tail.size());
+    _written += tail.size();
+}
+
+// ////////////////////////////////// //
+// COMPRESSION SINK PROTECTED METHODS //
+// ////////////////////////////////// //
+
+bool CompressionSink::make_room(const uint64 size) {
+    if (_finished) return false;
+    // Blocks have fixed size, so only a full window is compressed
+    if (_cursor == _end) write_block();
+    return size <= available();
+}
+void CompressionSink::write_through(const void* const data, const uint64 size) {
+    if (_finished) return;
+    auto source    = (const byte*) data;
+    auto remaining = size;
+    while (remaining > 0) {
+        const auto count = std::min(remaining, available());
+        std::memcpy(_cursor, source, count);
+        _cursor += count;
+        source += count;
+        remaining -= count;
+        if (_cursor == _end) write_block();
+    }
+}
+
+// //////////////////////////////// //
+// COMPRESSION SINK PRIVATE METHODS //
+// //////////////////////////////// //
+
+void CompressionSink::write_block() {
+    const auto used = (uint64) (_cursor - _begin);
+    if (used == 0) return;
+
+    byte entry[index_entry_size];
+    store_u64(entry, _written);
+    _index.append(entry, sizeof(entry));
+
+    _compressed.clear();
+    Compression::compress_block(_begin, used, _settings.entropy, _compressed);
+    _target.write(_compressed.data(), _compressed.size());
+    _written += _compressed.size();
+    _offset += used;
+    _cursor = _begin;
+}
+
+} // namespace CORE_NAMESPACE
@@ -0,0 +1,31 @@
+#include "serialization/framed_binary_serializer.hpp"
+
+namespace CORE_NAMESPACE {
+
+// ////////////////////////////////////////// //
+// FRAMED BINARY SERIALIZER PROTECTED METHODS //
+// ////////////////////////////////////////// //
+
+void FramedBinarySerializer::object_add_end(SerializationSink& out) const {
+    // Field with ID 0 ends the object
+    out.put(0);
+}
+
+void FramedBinarySerializer::field_add_header(
+    SerializationSink& out, const uint64 id, const uint64 size
+) const {
+    serialize_size(out, id);
+    serialize_size(out, size);
+}
+Outcome FramedBinarySerializer::field_remove_header(
+    const String& in_str, uint64& id, uint64& size, uint64& position
+) const {
+    if (deserialize_size(in_str, id, position).failed()) return Outcome::Failed;
+    if (id == 0) {
+        size = 0;
+        return Outcome::Successful;
+    }
+    return deserialize_size(in_str, size, position);
+}
+
+} // namespace CORE_NAMESPACE
@@ -0,0 +1,69 @@
+#include "serialization/incremental_decoder.hpp"
+
+namespace CORE_NAMESPACE {
+
+// ////////////////////////////////// //
+// INCREMENTAL DECODER PUBLIC METHODS //
+// ////////////////////////////////// //
+
+IncrementalDecoder::IncrementalDecoder(
+    const Serializer* const serializer, const bool has_header
+)
+    : _serializer(serializer), _header_read(!has_header) {}
+
+void IncrementalDecoder::feed(const void* const data, const uint64 size) {
+    compact();
+    _buffer.append((const byte*) data, size);
+}
+
+uint64 IncrementalDecoder::read_from(
+    std::istream& stream, const uint64 chunk_size
+) {
+    // Read directly into the buffer
+    compact();
+    const auto start = _buffer.size();
+    _buffer.resize(start + chunk_size);
+    stream.read(_buffer.data() + start, chunk_size);
+    const auto read = (uint64) stream.gcount();
+    _buffer.resize(start + read);
+    return read;
+}
+
+// /////////////////////////////////// //
+// INCREMENTAL DECODER PRIVATE METHODS //
+// /////////////////////////////////// //
+
+Result<bool, RuntimeError> IncrementalDecoder::try_read_header() {
+    if (!should_attempt()) return false;
+
+    uint64     position = _read;
+    const auto header   = _serializer->read_header(_buffer, position);
+    if (header.has_error()) return attempt_failed(header.error());
+    consume(position - _read);
+    _header_read = true;
+    return true;
+}
+
+Result<bool, RuntimeError> IncrementalDecoder::attempt_failed(
+    const RuntimeError& error
+) {
+    // Input may just be incomplete; retry once it doubles
+    if (_finished) return Failure(error);
+    _attempt_at = 2 * buffered() + 1;
+    return false;
+}
+
+void IncrementalDecoder::compact() {
+    // Drop consumed input once it makes up most of the buffer
+    if (_read == 0 || _read < _buffer.size() - _read) return;
+    _buffer.erase(0, _read);
+    _offset += _read;
+    _read = 0;
+}
+
+void IncrementalDecoder::consume(const uint64 size) {
+    _read += size;
+    _attempt_at = 0;
+}
+
+} // namespace CORE_NAMESPACE
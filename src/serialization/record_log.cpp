@@ -0,0 +1,506 @@
+#include "serialization/record_log.hpp"
+
+#include "platform/platform.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE4_2__) && defined(__x86_64__)
+#    include <nmmintrin.h>
+#endif
+
+namespace CORE_NAMESPACE {
+
+// Log constants
+static const constexpr char  log_magic[4] = { 'R', 'L', 'O', 'G' };
+static const constexpr uint8 log_version  = 1;
+
+// Scratch buffers larger than this are released after use
+static const constexpr uint64 scratch_limit = 1024 * 1024;
+
+// //////////////// //
+// ENCODING HELPERS //
+// //////////////// //
+
+static void store_u32(byte* const target, const uint32 value) {
+    for (uint32 i = 0; i < sizeof(uint32); i++)
+        target[i] = (byte) (value >> (8 * i));
+}
+static void store_u64(byte* const target, const uint64 value) {
+    for (uint32 i = 0; i < sizeof(uint64); i++)
+        target[i] = (byte) (value >> (8 * i));
+}
+static uint32 load_u32(const byte* const source) {
+    uint32 value = 0;
+    for (uint32 i = 0; i < sizeof(uint32); i++)
+        value |= (uint32) (uint8) source[i] << (8 * i);
+    return value;
+}
+static uint64 load_u64(const byte* const source) {
+    uint64 value = 0;
+    for (uint32 i = 0; i < sizeof(uint64); i++)
+        value |= (uint64) (uint8) source[i] << (8 * i);
+    return value;
+}
+
+// Appends frame header and payload to @p out
+static void write_frame(
+    String& out, const byte* const payload, const uint64 size
+) {
+    byte header[RecordLog::frame_header_size];
+    store_u32(header, (uint32) size);
+    const auto crc = RecordLog::checksum(header, sizeof(uint32));
+    store_u32(header + sizeof(uint32), RecordLog::checksum(payload, size, crc));
+    out.append(header, sizeof(header));
+    out.append(payload, size);
+}
+
+// Finds intact frame at @p position of @p data, setting @p payload to it
+static bool read_frame(
+    const StringView data, const uint64 position, StringView& payload
+) {
+    if (data.size() - position < RecordLog::frame_header_size) return false;
+    const auto header = data.data() + position;
+    const auto size   = (uint64) load_u32(header);
+    if (data.size() - position - RecordLog::frame_header_size < size)
+        return false;
+
+    const auto content = header + RecordLog::frame_header_size;
+    const auto crc     = RecordLog::checksum(header, sizeof(uint32));
+    if (RecordLog::checksum(content, size, crc) !=
+        load_u32(header + sizeof(uint32)))
+        return false;
+
+    payload = { content, size };
+    return true;
+}
+
+// True if an intact frame starts anywhere after damaged data at @p position.
+// Torn tail is a prefix of written frames, so it never contains one.
+static bool has_frame_after(const StringView data, const uint64 position) {
+    StringView payload {};
+    for (uint64 at = position + 1; at < data.size(); at++)
+        if (read_frame(data, at, payload)) return true;
+    return false;
+}
+
+// ////////////// //
+// CRC32C HELPERS //
+// ////////////// //
+
+#if !defined(__SSE4_2__) || !defined(__x86_64__)
+// Slicing by 8 tables of reflected Castagnoli polynomial. Table k gives
+// the effect of a byte followed by k zero bytes.
+struct CRCTables {
+    uint32 table[8][256];
+
+    CRCTables() {
+        for (uint32 i = 0; i < 256; i++) {
+            uint32 crc = i;
+            for (uint32 bit = 0; bit < 8; bit++)
+                crc = (crc >> 1) ^ ((crc & 1) ? 0x82F63B78 : 0);
+            table[0][i] = crc;
+        }
+        for (uint32 k = 1; k < 8; k++)
+            for (uint32 i = 0; i < 256; i++) {
+                const auto previous = table[k - 1][i];
+                table[k][i] = (previous >> 8) ^ table[0][previous & 0xFF];
+            }
+    }
+};
+
+static const CRCTables& crc_tables() {
+    static const CRCTables tables {};
+    return tables;
+}
+#endif
+
+// ////////////////// //
+// RECORD LOG METHODS //
+// ////////////////// //
+
+uint32 RecordLog::checksum(
+    const byte* const data, const uint64 size, const uint32 crc
+) {
+    auto   current   = (const uint8*) data;
+    uint64 remaining = size;
+    uint32 result    = ~crc;
+
+#if defined(__SSE4_2__) && defined(__x86_64__)
+    // Dedicated instruction, 8 bytes at a time
+    uint64 wide = result;
+    for (; remaining >= 8; remaining -= 8, current += 8) {
+        uint64 word;
+        std::memcpy(&word, current, sizeof(word));
+        wide = _mm_crc32_u64(wide, word);
+    }
+    result = (uint32) wide;
+    for (; remaining > 0; remaining--)
+        result = _mm_crc32_u8(result, *current++);
+#else
+    // Table driven, 8 bytes at a time
+    const auto& t = crc_tables().table;
+    for (; remaining >= 8; remaining -= 8, current += 8) {
+        const auto low  = load_u32((const byte*) current) ^ result;
+        const auto high = load_u32((const byte*) current + 4);
+
+        result = t[7][low & 0xFF] ^ t[6][(low >> 8) & 0xFF] ^
+                 t[5][(low >> 16) & 0xFF] ^ t[4][low >> 24] ^
+                 t[3][high & 0xFF] ^ t[2][(high >> 8) & 0xFF] ^
+                 t[1][(high >> 16) & 0xFF] ^ t[0][high >> 24];
+    }
+    for (; remaining > 0; remaining--)
+        result = t[0][(result ^ *current++) & 0xFF] ^ (result >> 8);
+#endif
+
+    return ~result;
+}
+
+// //////////////////////////////// //
+// RECORD LOG WRITER PUBLIC METHODS //
+// //////////////////////////////// //
+
+Result<std::unique_ptr<RecordLogWriter>, RuntimeError> RecordLogWriter::open(
+    const Path&              file_path,
+    const Serializer* const  serializer,
+    const RecordLogSettings& settings
+) {
+    std::unique_ptr<RecordLogWriter> writer {
+        new RecordLogWriter(file_path, serializer, settings)
+    };
+
+    // Empty file may be left by a crash right after creation
+    std::error_code error {};
+    const auto      file_size = std::filesystem::file_size(file_path, error);
+    const auto      result    = (error || file_size == 0) ? writer->create()
+                                                          : writer->recover();
+    if (result.has_error()) return Failure(result.error());
+    return writer;
+}
+
+RecordLogWriter::~RecordLogWriter() {
+    // Errors can't be reported anymore
+    if (!_file) return;
+    const auto result = _settings.sync == LogSync::Never ? commit() : sync();
+}
+
+Result<void, RuntimeError> RecordLogWriter::commit() {
+    return write_batch(false);
+}
+Result<void, RuntimeError> RecordLogWriter::sync() { return write_batch(true); }
+
+// ///////////////////////////////// //
+// RECORD LOG WRITER PRIVATE METHODS //
+// ///////////////////////////////// //
+
+RecordLogWriter::RecordLogWriter(
+    const Path&              file_path,
+    const Serializer* const  serializer,
+    const RecordLogSettings& settings
+)
+    : _path(file_path), _serializer(serializer), _settings(settings) {}
+
+Result<void, RuntimeError> RecordLogWriter::create() {
+    auto file = FileSystem::create_or_open<BinaryOut>(
+        _path, FileSystem::binary | FileSystem::trunc
+    );
+    if (file.has_error()) return Failure(file.error());
+    _file = std::move(file.value());
+
+    // Index of a previous log would describe wrong records
+    const auto index_path = RecordLog::index_path(_path);
+    std::error_code error {};
+    std::filesystem::remove(index_path, error);
+    if (_settings.index_interval != 0) {
+        auto index = FileSystem::create_or_open<BinaryOut>(
+            index_path, FileSystem::binary | FileSystem::trunc
+        );
+        if (index.has_error()) return Failure(index.error());
+        _index_file = std::move(index.value());
+    }
+
+    // Header is synced right away, so log is never left without it
+    BufferSink header {};
+    _serializer->write_header(header);
+    _batch.append(log_magic, sizeof(log_magic));
+    _batch.push_back((byte) log_version);
+    _batch.append(3, '\0');
+    write_frame(_batch, header.data(), header.size());
+    _size = _batch.size();
+    return sync();
+}
+
+Result<void, RuntimeError> RecordLogWriter::recover() {
+    // Find end of intact records
+    uint64 valid_size = 0;
+    {
+        auto reader = RecordLogReader::open(_path, _serializer);
+        if (reader.has_error()) return Failure(reader.error());
+        while (reader.value().skip())
+            ;
+        valid_size = reader.value().position();
+        _records   = reader.value().record();
+    }
+
+    // Damage followed by an intact frame isn't a torn tail, but corruption
+    // in the middle of the log. Cutting it off would lose intact records.
+    {
+        const auto mapped = MappedFile::open(_path);
+        if (mapped.has_error()) return Failure(mapped.error());
+        if (has_frame_after(mapped.value().view(), valid_size))
+            return Failure("Record log is corrupted:" + _path.string());
+    }
+
+    // Cut off torn tail. File is unmapped by now, as required on some
+    // platforms.
+    std::error_code error {};
+    if (std::filesystem::file_size(_path, error) != valid_size) {
+        std::filesystem::resize_file(_path, valid_size, error);
+        if (error)
+            return Failure("Failed to truncate record log:" + _path.string());
+    }
+    _size = _committed = valid_size;
+
+    auto file = FileSystem::open<BinaryOut>(
+        _path, FileSystem::binary | FileSystem::app
+    );
+    if (file.has_error()) return Failure(file.error());
+    _file = std::move(file.value());
+
+    // Keep index entries of remaining records. Index is rewritten even if
+    // it isn't maintained anymore, so it never describes other records.
+    const auto index_path = RecordLog::index_path(_path);
+    if (!FileSystem::exists(index_path) && _settings.index_interval == 0)
+        return {};
+
+    String entries {};
+    {
+        const auto mapped = MappedFile::open(index_path);
+        const auto index  = mapped.has_value() ? mapped.value().view() : "";
+        for (uint64 i = 0; i + RecordLog::index_entry_size <= index.size();
+             i += RecordLog::index_entry_size) {
+            const auto record = load_u64(index.data() + i);
+            const auto offset = load_u64(index.data() + i + sizeof(uint64));
+            if (record >= _records || offset >= valid_size) break;
+            entries.append(index.data() + i, RecordLog::index_entry_size);
+        }
+    }
+
+    auto index = FileSystem::create_or_open<BinaryOut>(
+        index_path, FileSystem::binary | FileSystem::trunc
+    );
+    if (index.has_error()) return Failure(index.error());
+    static_cast<std::ostream&>(*index.value()).write(
+        entries.data(), entries.size()
+    );
+    index.value()->flush();
+    if (_settings.index_interval != 0) _index_file = std::move(index.value());
+    return {};
+}
+
+Result<void, RuntimeError> RecordLogWriter::add_frame(
+    const byte* const payload, const uint64 size
+) {
+    if (size > RecordLog::max_record_size)
+        return Failure("Record is too large for record log");
+
+    bool full = false;
+    {
+        std::lock_guard<parallel::Mutex> lock { _batch_lock };
+        if (_failed) return failed_error();
+        if (_index_file && _records % _settings.index_interval == 0) {
+            byte entry[RecordLog::index_entry_size];
+            store_u64(entry, _records);
+            store_u64(entry + sizeof(uint64), _size);
+            _index_batch.append(entry, sizeof(entry));
+        }
+        write_frame(_batch, payload, size);
+        _size += RecordLog::frame_header_size + size;
+        _records++;
+        full = _batch.size() >= _settings.commit_size;
+    }
+    if (full) return commit();
+    return {};
+}
+
+Result<void, RuntimeError> RecordLogWriter::write_batch(const bool force_sync) {
+    std::lock_guard<parallel::Mutex> lock { _commit_lock };
+
+    // Take filled batch, so appending can continue into an empty one
+    {
+        std::lock_guard<parallel::Mutex> batch_lock { _batch_lock };
+        if (_failed) return failed_error();
+        _batch.swap(_committing);
+        _index_batch.swap(_committing_index);
+    }
+
+    if (!_committing.empty()) {
+        std::ostream& out = *_file;
+        out.write(_committing.data(), _committing.size());
+        out.flush();
+        if (out.fail()) {
+            fail();
+            return Failure("Failed to write record log:" + _path.string());
+        }
+        _committed += _committing.size();
+        _committing.clear();
+        _unsynced = true;
+    }
+    // Index is written after the records it points to
+    if (!_committing_index.empty()) {
+        std::ostream& out = *_index_file;
+        out.write(_committing_index.data(), _committing_index.size());
+        out.flush();
+        _committing_index.clear();
+    }
+
+    // Sync if policy requires it
+    if (!_unsynced) return {};
+    const auto now     = platform::get_absolute_time();
+    const bool do_sync = force_sync ||
+                         _settings.sync == LogSync::OnCommit ||
+                         (_settings.sync == LogSync::Interval &&
+                          now - _last_sync >= _settings.sync_interval);
+    if (!do_sync) return {};
+    // Whether written data survived a failed sync is unknown, so log isn't
+    // written to anymore
+    if (!platform::sync_file(_path.string().c_str())) {
+        fail();
+        return Failure("Failed to sync record log:" + _path.string());
+    }
+    _last_sync = now;
+    _unsynced  = false;
+    return {};
+}
+
+void RecordLogWriter::fail() {
+    // Records appended after the failed batch were placed right after it, so
+    // none of them can be written anymore
+    {
+        std::lock_guard<parallel::Mutex> lock { _batch_lock };
+        _failed = true;
+        _batch.clear();
+        _index_batch.clear();
+    }
+    _committing.clear();
+    _committing_index.clear();
+    _file.reset();
+    _index_file.reset();
+
+    // Cut off whatever part of the batch was written. If this fails too,
+    // reopening the log cuts it off as a torn tail.
+    std::error_code error {};
+    std::filesystem::resize_file(_path, _committed, error);
+}
+
+Failure<RuntimeError> RecordLogWriter::failed_error() const {
+    return Failure(
+        RuntimeError("Record log writer failed earlier:" + _path.string())
+    );
+}
+
+BufferSink& RecordLogWriter::scratch() {
+    thread_local BufferSink buffer {};
+    return buffer;
+}
+void RecordLogWriter::release_scratch() {
+    auto& buffer = scratch();
+    if (buffer.capacity() > scratch_limit) buffer.take();
+}
+
+// //////////////////////////////// //
+// RECORD LOG READER PUBLIC METHODS //
+// //////////////////////////////// //
+
+Result<RecordLogReader, RuntimeError> RecordLogReader::open(
+    const Path& file_path, const Serializer* const serializer
+) {
+    auto file = MappedFile::open(file_path);
+    if (file.has_error()) return Failure(file.error());
+
+    RecordLogReader reader {};
+    reader._file       = std::move(file.value());
+    reader._serializer = serializer;
+
+    // Verify log header and serializer's header
+    const auto data = reader._file.view();
+    if (data.size() < RecordLog::header_size ||
+        std::memcmp(data.data(), log_magic, sizeof(log_magic)) != 0)
+        return Failure("Not a record log:" + file_path.string());
+    if ((uint8) data[sizeof(log_magic)] != log_version)
+        return Failure("Unsupported record log version:" + file_path.string());
+
+    StringView header {};
+    if (!read_frame(data, RecordLog::header_size, header))
+        return Failure("Record log header is corrupted:" + file_path.string());
+    const String header_data { header };
+    uint64       position = 0;
+    const auto   result   = serializer->read_header(header_data, position);
+    if (result.has_error()) return Failure(result.error());
+
+    reader._start = reader._position =
+        RecordLog::header_size + RecordLog::frame_header_size + header.size();
+    reader.load_index(RecordLog::index_path(file_path));
+    return reader;
+}
+
+Result<void, RuntimeError> RecordLogReader::seek(const uint64 record) {
+    // Start from last indexed record before the target
+    const auto entry = std::upper_bound(
+        _index.begin(),
+        _index.end(),
+        record,
+        [](const uint64 value, const IndexEntry& entry) {
+            return value < entry.record;
+        }
+    );
+    if (entry != _index.begin()) {
+        _record   = (entry - 1)->record;
+        _position = (entry - 1)->offset;
+    } else {
+        _record   = 0;
+        _position = _start;
+    }
+    _torn = false;
+
+    while (_record < record)
+        if (!next_frame())
+            return Failure("Record log doesn't contain requested record");
+    return {};
+}
+
+// ///////////////////////////////// //
+// RECORD LOG READER PRIVATE METHODS //
+// ///////////////////////////////// //
+
+bool RecordLogReader::next_frame() {
+    if (_torn || _position == _file.size()) return false;
+    if (!read_frame(_file.view(), _position, _frame)) {
+        _torn = true;
+        return false;
+    }
+    _position += RecordLog::frame_header_size + _frame.size();
+    _record++;
+    return true;
+}
+
+void RecordLogReader::load_index(const Path& index_path) {
+    if (!FileSystem::exists(index_path)) return;
+    auto mapped = MappedFile::open(index_path);
+    if (mapped.has_error()) return;
+
+    // Only entries in order and within the log are used
+    const auto index = mapped.value().view();
+    for (uint64 i = 0; i + RecordLog::index_entry_size <= index.size();
+         i += RecordLog::index_entry_size) {
+        const IndexEntry entry { load_u64(index.data() + i),
+                                 load_u64(index.data() + i + sizeof(uint64)) };
+        if (entry.offset < _start || entry.offset >= _file.size()) break;
+        if (!_index.empty() && (entry.record <= _index.back().record ||
+                                entry.offset <= _index.back().offset))
+            break;
+        _index.push_back(entry);
+    }
+}
+
+} // namespace CORE_NAMESPACE
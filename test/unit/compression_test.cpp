@@ -0,0 +1,116 @@
+#include "test.hpp"
+
+#include "serialization/compression.hpp"
+
+using namespace a172;
+
+namespace {
+
+// Mix of repetitive and random data, so all block methods are used
+String make_data(const uint64 size) {
+    String data(size, '\0');
+    uint64 state = 12345;
+    for (uint64 i = 0; i < size; i++) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        if ((i / 1000) % 3 == 0) data[i] = (byte) (state >> 56);
+        else data[i] = "abcabcabd"[i % 9];
+    }
+    return data;
+}
+
+} // namespace
+
+TEST(compression_round_trip) {
+    for (const bool entropy : { false, true }) {
+        for (const uint64 size : { 0, 1, 100, 4096, 300000 }) {
+            CompressionSettings settings {};
+            settings.block_size = 64 * KB;
+            settings.entropy    = entropy;
+
+            const auto data       = make_data(size);
+            const auto compressed = Compression::compress(data, settings);
+            EXPECT(Compression::is_compressed(compressed));
+            const auto result = Compression::decompress(compressed);
+            EXPECT(result.has_value() && result.value() == data);
+        }
+    }
+
+    // Repetitive data shrinks
+    const String repeated(100000, 'x');
+    EXPECT(Compression::compress(repeated).size() < repeated.size() / 10);
+}
+
+TEST(compression_random_access) {
+    CompressionSettings settings {};
+    settings.block_size = 4 * KB;
+
+    const auto data       = make_data(50000);
+    const auto compressed = Compression::compress(data, settings);
+    const auto reader     = CompressedReader::open(compressed);
+    EXPECT(reader.has_value());
+    EXPECT(reader.value().size() == data.size());
+    EXPECT(reader.value().block_count() == (data.size() + 4095) / 4096);
+
+    for (const uint64 offset : { 0, 4095, 4096, 12345, 49000 }) {
+        const auto part = reader.value().read(offset, 1000);
+        EXPECT(part.has_value() && part.value() == data.substr(offset, 1000));
+    }
+    EXPECT(reader.value().read(49500, 1000).has_error());
+    const auto all = reader.value().read_all();
+    EXPECT(all.has_value() && all.value() == data);
+}
+
+TEST(compression_sink) {
+    CompressionSettings settings {};
+    settings.block_size = 1 * KB;
+
+    const auto data = make_data(10000);
+    BufferSink target {};
+    {
+        CompressionSink sink { target, settings };
+        uint64          written = 0;
+        for (uint64 step = 1; written < data.size(); step = step * 3 % 2000) {
+            const auto size = std::min<uint64>(step, data.size() - written);
+            if (size == 1) sink.put(data[written]);
+            else sink.write(data.data() + written, size);
+            written += size;
+        }
+    }
+    const auto result = Compression::decompress(target.view());
+    EXPECT(result.has_value() && result.value() == data);
+}
+
+TEST(compression_rejects_corrupted_input) {
+    CompressionSettings settings {};
+    settings.block_size = 1 * KB;
+
+    const auto data       = make_data(20000);
+    const auto compressed = Compression::compress(data, settings);
+    for (uint64 size = 0; size < compressed.size(); size += 7) {
+        const auto truncated = compressed.substr(0, size);
+        EXPECT(Compression::decompress(truncated).has_error());
+    }
+}
+
+TEST(compression_rejects_forged_sizes) {
+    const auto data       = make_data(100);
+    const auto compressed = Compression::compress(data);
+
+    // Claim a single block of maximum size, without data for it
+    auto       forged = compressed;
+    const auto size   = (uint64) CompressionSettings::max_block_size;
+    const auto footer = forged.size() - Compression::footer_size;
+    for (uint64 i = 0; i < 4; i++)
+        forged[4 + i] = (byte) (size >> (8 * i));
+    for (uint64 i = 0; i < 8; i++)
+        forged[footer + 8 + i] = (byte) (size >> (8 * i));
+    EXPECT(CompressedReader::open(forged).has_error());
+
+    // Flipped bits never decode into data of other size
+    for (uint64 i = 0; i < compressed.size(); i++) {
+        auto flipped = compressed;
+        flipped[i] ^= (byte) (1 << (i % 8));
+        const auto result = Compression::decompress(flipped);
+        EXPECT(result.has_error() || result.value().size() == data.size());
+    }
+}
@@ -0,0 +1,75 @@
+#include "test.hpp"
+
+#include "computed_property.hpp"
+
+using namespace a172;
+
+TEST(computed_property_cache_invalidation) {
+    ChangeTracker             tracker {};
+    ObservableProperty<int32> width { tracker, 2 }, height { tracker, 3 };
+    ObservableProperty<int32> unrelated { tracker, 0 };
+
+    uint32                  computes = 0;
+    ComputedProperty<int32> area {
+        [&]() {
+            computes++;
+            return width() * height();
+        },
+        width,
+        height
+    };
+    EXPECT(computes == 0);
+    EXPECT(area == 6 && area() == 6 && computes == 1);
+
+    // Only changes of sources cause recomputation
+    width = 4;
+    EXPECT(area == 12 && computes == 2);
+    unrelated = 1;
+    EXPECT(area == 12 && computes == 2);
+    height = 3;
+    EXPECT(area == 12 && computes == 2);
+
+    // Flushing the tracker doesn't affect cached value
+    tracker.flush();
+    EXPECT(area == 12 && computes == 2);
+
+    area.invalidate();
+    EXPECT(area == 12 && computes == 3);
+}
+
+TEST(computed_property_chained_sources) {
+    ChangeTracker             first {}, second {};
+    ObservableProperty<int32> a { first, 1 }, b { second, 2 };
+
+    uint32                  sum_computes = 0, sign_computes = 0;
+    ComputedProperty<int32> sum {
+        [&]() {
+            sum_computes++;
+            return a() + b();
+        },
+        a,
+        b
+    };
+    ComputedProperty<bool> positive {
+        [&]() {
+            sign_computes++;
+            return sum() > 0;
+        },
+        sum
+    };
+    EXPECT(positive() && sum_computes == 1 && sign_computes == 1);
+    EXPECT(sum.version() == 1 && positive.version() == 1);
+
+    // Sources on different trackers are checked individually
+    b = 5;
+    EXPECT(positive() && sum_computes == 2 && sign_computes == 2);
+
+    // Unchanged result keeps version, so dependents aren't recomputed
+    a = 2;
+    b = 4;
+    EXPECT(positive() && sum_computes == 3 && sign_computes == 2);
+    EXPECT(sum == 6 && sum.version() == 2);
+
+    a = -10;
+    EXPECT(!positive() && sum() == -6 && sign_computes == 3);
+}
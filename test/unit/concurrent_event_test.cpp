@@ -0,0 +1,90 @@
+#include "test.hpp"
+
+#include "concurrent_event.hpp"
+
+#include <thread>
+
+using namespace a172;
+
+TEST(concurrent_event_reducer_and_unsubscribe) {
+    ConcurrentEvent<int32(int32)> event {
+        [](const int32 a, const int32 b) { return a + b; }
+    };
+    EXPECT(event(1) == 0);
+
+    const auto first = event.subscribe([](const int32 x) { return x; });
+    event.subscribe([](const int32 x) { return 10 * x; });
+    EXPECT(event.size() == 2 && event(2) == 22);
+
+    EXPECT(event.unsubscribe(first).succeeded());
+    EXPECT(event.unsubscribe(first).failed());
+    EXPECT(event(2) == 20);
+    {
+        const auto scoped =
+            event.subscribe_scoped([](const int32 x) { return 100 * x; });
+        EXPECT(event(1) == 110);
+    }
+    EXPECT(event(1) == 10 && event.size() == 1);
+}
+
+TEST(concurrent_event_changes_during_invoke) {
+    // Changes made by callbacks take effect from the next invoke
+    ConcurrentEvent<void()> event {};
+    uint32                  calls = 0, added_calls = 0;
+    Subscription            self {};
+    self = event.subscribe([&]() {
+        calls++;
+        EXPECT(event.unsubscribe(self).succeeded());
+        event.subscribe([&]() { added_calls++; });
+    });
+
+    event();
+    EXPECT(calls == 1 && added_calls == 0 && event.size() == 1);
+    event();
+    EXPECT(calls == 1 && added_calls == 1);
+}
+
+TEST(concurrent_event_concurrent_use) {
+    // Every invoke sees one consistent subscriber list: the base callback,
+    // and up to all of the writer's callbacks
+    const uint32              writer_count = 2, max_added = 4;
+    ConcurrentEvent<uint32()> event {
+        [](const uint32 a, const uint32 b) { return a + b; }
+    };
+    std::atomic<bool>         done { false };
+    std::atomic<uint32>       bad_results { 0 };
+    event.subscribe([]() { return 1000u; });
+
+    Vector<std::thread> threads {};
+    for (uint32 t = 0; t < writer_count; t++)
+        threads.emplace_back([&]() {
+            Subscription added[max_added] {};
+            for (uint32 round = 0; round < 200; round++) {
+                for (auto& subscription : added)
+                    subscription = event.subscribe([]() { return 1u; });
+                for (const auto subscription : added)
+                    EXPECT(event.unsubscribe(subscription).succeeded());
+
+                // Retired lists share small callback pool, which preempted
+                // readers could exhaust
+                parallel::EpochReclamation::synchronize();
+            }
+        });
+    for (uint32 t = 0; t < 2; t++)
+        threads.emplace_back([&]() {
+            while (!done) {
+                const auto result = event();
+                if (result < 1000 || result > 1000 + writer_count * max_added)
+                    bad_results++;
+            }
+        });
+
+    for (uint32 t = 0; t < writer_count; t++)
+        threads[t].join();
+    done = true;
+    for (uint32 t = writer_count; t < threads.size(); t++)
+        threads[t].join();
+
+    EXPECT(bad_results == 0);
+    EXPECT(event.size() == 1 && event() == 1000);
+}
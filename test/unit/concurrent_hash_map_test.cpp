@@ -0,0 +1,56 @@
+#include "test.hpp"
+
+#include "container/concurrent_hash_map.hpp"
+#include "string.hpp"
+
+#include <thread>
+
+using namespace a172;
+
+TEST(concurrent_hash_map_parallel_inserts) {
+    ConcurrentHashMap<uint64, uint64> map { 16, BaseMemoryTags.Unknown };
+    const uint64                      thread_count = 4;
+    const uint64                      count        = 2000;
+
+    // Threads insert disjoint keys, while all of them bump one shared entry
+    EXPECT(map.insert((uint64) -1, (uint64) 0));
+    std::thread threads[thread_count];
+    for (uint64 t = 0; t < thread_count; t++) {
+        threads[t] = std::thread { [&, t]() {
+            for (uint64 i = t * count; i < (t + 1) * count; i++) {
+                map.insert(i, 2 * i);
+                map.update((uint64) -1, [](uint64& value) { value++; });
+            }
+        } };
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    EXPECT(map.size() == thread_count * count + 1);
+    EXPECT(map.find((uint64) -1) == thread_count * count);
+    uint64 sum = 0;
+    map.visit_all([&](const uint64 key, const uint64 value) {
+        if (key != (uint64) -1) sum += value - 2 * key;
+    });
+    EXPECT(sum == 0);
+}
+
+TEST(concurrent_hash_map_operations) {
+    ConcurrentHashMap<uint64, String> map { 4, BaseMemoryTags.Unknown };
+    EXPECT(map.insert(1, String("one")));
+    EXPECT(!map.insert(1, String("uno")));
+    EXPECT(map.find(1) == String("one") && !map.find(2).has_value());
+
+    EXPECT(!map.insert_or_assign(1, String("uno")));
+    EXPECT(map.find(1) == String("uno"));
+    EXPECT(map.get_or_insert(2, []() { return String("two"); }) == "two");
+    EXPECT(map.get_or_insert(2, []() { return String("dos"); }) == "two");
+
+    uint64 length = 0;
+    EXPECT(map.visit(2, [&](const String& value) { length = value.size(); }));
+    EXPECT(length == 3);
+
+    EXPECT(map.erase(1) && !map.erase(1) && !map.contains(1));
+    map.clear();
+    EXPECT(map.empty());
+}
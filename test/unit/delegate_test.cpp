@@ -0,0 +1,106 @@
+#include "test.hpp"
+
+#include "delegate.hpp"
+#include "event.hpp"
+
+using namespace a172;
+
+namespace {
+
+using IntDelegate = Delegate<int32, int32>;
+
+// Counts live instances, to check delegates manage callable lifetime
+template<uint64 Padding>
+struct Counted {
+    inline static int64 alive = 0;
+
+    int32 offset;
+    char  padding[Padding] {};
+
+    Counted(const int32 offset) : offset(offset) { alive++; }
+    Counted(const Counted& other) : offset(other.offset) { alive++; }
+    Counted(Counted&& other) noexcept : offset(other.offset) { alive++; }
+    ~Counted() { alive--; }
+
+    int32 operator()(const int32 x) const { return x + offset; }
+};
+
+template<typename Callable>
+void check_lifetime() {
+    {
+        IntDelegate delegate { Callable { 1 } };
+        EXPECT(delegate && delegate(1) == 2);
+
+        IntDelegate copy { delegate };
+        IntDelegate moved { std::move(copy) };
+        EXPECT(delegate(2) == 3 && moved(2) == 3);
+
+        moved = IntDelegate { Callable { 10 } };
+        EXPECT(moved(2) == 12);
+        delegate = moved;
+        EXPECT(delegate(3) == 13);
+
+        // Copies are independent, so only equal to themselves
+        EXPECT(delegate == delegate && delegate != moved);
+    }
+    EXPECT(Callable::alive == 0);
+}
+
+int32 add_one(const int32 x) { return x + 1; }
+int32 add_two(const int32 x) { return x + 2; }
+
+struct Adder {
+    int32 offset;
+    int32 add(const int32 x) { return x + offset; }
+    int32 sub(const int32 x) { return x - offset; }
+    void  add_in_place(int32& value) { value += offset; }
+};
+
+} // namespace
+
+TEST(delegate_inline_and_heap_lifetime) {
+    using Small = Counted<1>;
+    using Large = Counted<IntDelegate::inline_capacity>;
+    static_assert(sizeof(Large) > IntDelegate::inline_capacity);
+
+    check_lifetime<Small>();
+    check_lifetime<Large>();
+    EXPECT(!IntDelegate {});
+}
+
+TEST(delegate_equality) {
+    const IntDelegate one { add_one }, two { add_two };
+    EXPECT(one == IntDelegate { add_one } && one != two);
+
+    Adder             first { 1 }, second { 1 };
+    const IntDelegate add { &first, &Adder::add };
+    EXPECT(add == IntDelegate(&first, &Adder::add));
+    EXPECT(add != IntDelegate(&second, &Adder::add));
+    EXPECT(add != IntDelegate(&first, &Adder::sub));
+
+    // Trivially copyable callables compare by state
+    const auto plus = [](const int32 offset) {
+        return IntDelegate { [offset](const int32 x) { return x + offset; } };
+    };
+    EXPECT(plus(1) == plus(1) && plus(1) != plus(2));
+}
+
+TEST(delegate_unsubscribe_by_function) {
+    Event<void(int32&)> event {};
+    Adder               adder { 5 };
+    const auto          add_to = [](int32& value) { value += 100; };
+
+    event.subscribe(add_to);
+    event.subscribe([](int32& value) { value += 1000; });
+    event.subscribe(&adder, &Adder::add_in_place);
+    int32 value = 0;
+    event(value);
+    EXPECT(value == 1105);
+
+    EXPECT(event.unsubscribe(add_to).succeeded());
+    EXPECT(event.unsubscribe(&adder, &Adder::add_in_place).succeeded());
+    EXPECT(event.unsubscribe(add_to).failed());
+    value = 0;
+    event(value);
+    EXPECT(value == 1000);
+}
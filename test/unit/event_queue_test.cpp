@@ -0,0 +1,124 @@
+#include "test.hpp"
+
+#include "event_queue.hpp"
+#include "string.hpp"
+
+#include <thread>
+
+using namespace a172;
+
+namespace {
+
+struct Resized {
+    uint32 window;
+    uint32 width;
+};
+struct Named {
+    String name;
+};
+
+} // namespace
+
+TEST(event_queue_delivers_in_order) {
+    EventQueue     queue {};
+    Vector<uint32> widths {};
+    String         names {};
+    queue.subscribe<Resized>([&](const Resized& e) {
+        widths.push_back(e.width);
+    });
+    queue.subscribe<Named>([&](const Named& e) { names += e.name; });
+
+    queue.enqueue(Resized { 0, 1 });
+    queue.emplace<Named>("a");
+    queue.enqueue(Resized { 0, 2 });
+    queue.emplace<Named>("b");
+    EXPECT(queue.pending<Resized>() == 2 && queue.pending() == 4);
+    EXPECT(widths.empty() && names.empty());
+
+    // Only pending events of one type
+    queue.dispatch<Named>();
+    EXPECT(widths.empty() && names == "ab" && queue.pending() == 2);
+
+    queue.dispatch();
+    EXPECT(widths == Vector<uint32>({ 1, 2 }) && queue.pending() == 0);
+
+    queue.enqueue(Resized { 0, 3 });
+    queue.clear();
+    queue.dispatch();
+    EXPECT(widths.size() == 2);
+}
+
+TEST(event_queue_coalescing) {
+    EventQueue      queue {};
+    Vector<Resized> delivered {};
+    const auto      window = [](const Resized& e) { return e.window; };
+    queue.subscribe<Resized>([&](const Resized& e) {
+        delivered.push_back(e);
+    });
+
+    // Latest event per key is delivered, in place of the first one
+    queue.coalesce<Resized>(window);
+    queue.enqueue(Resized { 1, 10 });
+    queue.enqueue(Resized { 2, 20 });
+    queue.enqueue(Resized { 1, 11 });
+    queue.enqueue(Resized { 1, 12 });
+    EXPECT(queue.pending<Resized>() == 2);
+    queue.dispatch();
+    EXPECT(delivered.size() == 2);
+    EXPECT(delivered[0].window == 1 && delivered[0].width == 12);
+    EXPECT(delivered[1].window == 2 && delivered[1].width == 20);
+
+    // Keys only coalesce between two dispatches
+    delivered.clear();
+    queue.enqueue(Resized { 1, 13 });
+    queue.dispatch();
+    EXPECT(delivered.size() == 1 && delivered[0].width == 13);
+
+    // Already pending events coalesce when key is set
+    delivered.clear();
+    queue.coalesce<Resized>({});
+    queue.enqueue(Resized { 1, 14 });
+    queue.enqueue(Resized { 1, 15 });
+    EXPECT(queue.pending<Resized>() == 2);
+    queue.coalesce<Resized>(window);
+    EXPECT(queue.pending<Resized>() == 1);
+    queue.dispatch();
+    EXPECT(delivered.size() == 1 && delivered[0].width == 15);
+}
+
+TEST(event_queue_enqueue_during_dispatch) {
+    EventQueue queue {};
+    uint32     calls = 0;
+    queue.subscribe<Resized>([&](const Resized& e) {
+        calls++;
+        if (e.width < 3) queue.enqueue(Resized { 0, e.width + 1 });
+    });
+
+    queue.enqueue(Resized { 0, 0 });
+    for (uint32 i = 1; i <= 4; i++) {
+        queue.dispatch();
+        EXPECT(calls == i);
+    }
+    EXPECT(queue.pending() == 0);
+}
+
+TEST(event_queue_concurrent_producers) {
+    EventQueue queue {};
+    uint64     sum = 0;
+    queue.subscribe<Resized>([&](const Resized& e) { sum += e.width; });
+
+    Vector<std::thread> producers {};
+    for (uint32 t = 0; t < 4; t++)
+        producers.emplace_back([&queue, t]() {
+            for (uint32 i = 0; i < 1000; i++)
+                queue.enqueue(Resized { t, i });
+        });
+
+    // Consumer dispatches while producers are still running
+    while (queue.pending() == 0) std::this_thread::yield();
+    queue.dispatch();
+    for (auto& producer : producers)
+        producer.join();
+    queue.dispatch();
+    EXPECT(sum == 4 * (999 * 1000 / 2));
+}
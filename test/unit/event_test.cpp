@@ -0,0 +1,162 @@
+#include "test.hpp"
+
+#include "event.hpp"
+#include "string.hpp"
+
+#include <algorithm>
+
+using namespace a172;
+
+namespace {
+
+const EventDispatch dispatches[] { EventDispatch::Sequential,
+                                   EventDispatch::ParallelJoin,
+                                   EventDispatch::ParallelUnordered };
+
+} // namespace
+
+TEST(event_unsubscribe_by_handle) {
+    Event<void(int32)> event {};
+    int32              sum = 0;
+
+    const auto first  = event.subscribe([&](const int32 x) { sum += x; });
+    const auto second = event.subscribe([&](const int32 x) { sum += 10 * x; });
+    event(1);
+    EXPECT(sum == 11);
+
+    EXPECT(event.unsubscribe(first).succeeded());
+    EXPECT(!event.is_subscribed(first) && event.is_subscribed(second));
+    EXPECT(event.unsubscribe(first).failed());
+    event(1);
+    EXPECT(sum == 21);
+
+    {
+        const auto scoped =
+            event.subscribe_scoped([&](const int32 x) { sum += 100 * x; });
+        event(1);
+        EXPECT(sum == 131);
+    }
+    event(1);
+    EXPECT(sum == 141);
+}
+
+TEST(event_unsubscribe_during_invoke) {
+    for (const auto dispatch : dispatches) {
+        Event<void(int32)> event { dispatch };
+        int32              first_calls = 0, kept_calls = 0, last_calls = 0;
+        Subscription       first {}, last {};
+
+        // Owns heap memory, so use after destruction would be caught
+        const String name(100, 'n');
+        first = event.subscribe([&, name](const int32) {
+            first_calls += name.size() == 100;
+            EXPECT(event.unsubscribe(first).succeeded());
+            EXPECT(event.unsubscribe(last).succeeded());
+            EXPECT(event.unsubscribe(first).failed());
+        });
+        event.subscribe([&](const int32) { kept_calls++; });
+        last = event.subscribe([&](const int32) { last_calls++; });
+
+        event(1);
+        event.wait_idle();
+        EXPECT(first_calls == 1 && kept_calls == 1);
+        if (dispatch == EventDispatch::Sequential) EXPECT(last_calls == 0);
+        EXPECT(!event.is_subscribed(first) && !event.is_subscribed(last));
+
+        event(1);
+        event.wait_idle();
+        EXPECT(first_calls == 1 && kept_calls == 2 && last_calls <= 1);
+    }
+
+    // Reduced result skips removed callbacks
+    Event<int32()> event { EventDispatch::Sequential,
+                           [](const int32 a, const int32 b) { return a + b; } };
+    Subscription   self {};
+    self = event.subscribe([&]() {
+        EXPECT(event.unsubscribe(self).succeeded());
+        return 1;
+    });
+    event.subscribe([]() { return 2; });
+    EXPECT(event() == 3);
+    EXPECT(event() == 2);
+}
+
+TEST(event_subscribe_during_invoke) {
+    for (const auto dispatch : dispatches) {
+        Event<void(int32)> event { dispatch };
+        int32              added_calls = 0;
+        Subscription       removed {};
+
+        // Enough to grow the list, while subscribing callback runs from it
+        const auto subscription = event.subscribe([&](const int32) {
+            for (uint64 i = 0; i < 100; i++)
+                event.subscribe([&](const int32) { added_calls++; });
+            removed =
+                event.subscribe([&](const int32) { added_calls += 1000; });
+            EXPECT(event.is_subscribed(removed));
+            EXPECT(event.unsubscribe(removed).succeeded());
+        });
+        event(1);
+        event.wait_idle();
+        EXPECT(added_calls == 0 && !event.is_subscribed(removed));
+
+        EXPECT(event.unsubscribe(subscription).succeeded());
+        event(1);
+        event.wait_idle();
+        EXPECT(added_calls == 100);
+    }
+}
+
+TEST(event_unordered_arguments) {
+    // Callbacks run after invoke returns, on a copy of arguments
+    Event<void(const String&)> event { EventDispatch::ParallelUnordered };
+    std::atomic<int32>         matches { 0 };
+    for (uint64 i = 0; i < 8; i++)
+        event.subscribe([&](const String& text) { matches += text == "text"; });
+    {
+        const String text { "text" };
+        event(text);
+    }
+    event.wait_idle();
+    EXPECT(matches == 8);
+
+    // Non-const references are copied per chunk, as chunks run concurrently
+    Event<void(int32&)> counter { EventDispatch::ParallelUnordered };
+    std::atomic<int32>  calls { 0 };
+    for (uint64 i = 0; i < 8; i++)
+        counter.subscribe([&](int32& value) {
+            value++;
+            calls++;
+        });
+    int32 value = 0;
+    counter(value);
+    counter.wait_idle();
+    EXPECT(calls == 8 && value == 0);
+}
+
+TEST(event_parallel_reducer) {
+    const auto concatenate = [](const String& a, const String& b) {
+        return a + b;
+    };
+    for (const auto dispatch : dispatches) {
+        Event<String(uint64)> event { dispatch, concatenate };
+        for (uint64 i = 0; i < 26; i++)
+            event.subscribe([i](const uint64 offset) {
+                return String(1, (char) ('a' + (i + offset) % 26));
+            });
+
+        // Unordered dispatch reduces in completion order
+        auto result = event(0);
+        if (dispatch == EventDispatch::ParallelUnordered)
+            std::sort(result.begin(), result.end());
+        EXPECT(result == "abcdefghijklmnopqrstuvwxyz");
+    }
+
+    // Void callbacks all run before a joined invoke returns
+    Event<void()>       event { EventDispatch::ParallelJoin };
+    std::atomic<uint64> calls { 0 };
+    for (uint64 i = 0; i < 100; i++)
+        event.subscribe([&]() { calls++; });
+    event();
+    EXPECT(calls == 100);
+}
@@ -0,0 +1,121 @@
+#include "test.hpp"
+
+#include "serialization/compact_binary_serializer.hpp"
+#include "serialization/incremental_decoder.hpp"
+
+#include <sstream>
+
+using namespace a172;
+
+namespace {
+
+struct Message : public Serializable {
+    uint64         id = 0;
+    String         text {};
+    Vector<uint32> values {};
+
+    serializable_attributes(id, text, values);
+};
+
+String make_stream(const Serializer& serializer, const uint64 count) {
+    BufferSink sink {};
+    serializer.write_header(sink);
+    for (uint64 i = 0; i < count; i++) {
+        Message message {};
+        message.id   = i;
+        message.text = String(i % 50, 'm');
+        message.values.assign(i % 7, (uint32) i);
+        message.serialize_to(sink, &serializer);
+    }
+    return sink.take();
+}
+
+} // namespace
+
+TEST(incremental_decoder_chunked_input) {
+    const CompactBinarySerializer serializer {};
+    const auto                    stream = make_stream(serializer, 500);
+
+    for (const uint64 chunk : { 1, 7, 100, 100000 }) {
+        IncrementalDecoder decoder { &serializer };
+        Message            message {};
+        uint64             count = 0;
+        for (uint64 offset = 0; offset < stream.size(); offset += chunk) {
+            const auto size = std::min<uint64>(chunk, stream.size() - offset);
+            decoder.feed(stream.data() + offset, size);
+            while (true) {
+                const auto next = decoder.next(message);
+                EXPECT(next.has_value());
+                if (!next.has_value() || !next.value()) break;
+                EXPECT(message.id == count);
+                count++;
+            }
+        }
+        decoder.finish();
+        while (true) {
+            const auto next = decoder.next(message);
+            EXPECT(next.has_value());
+            if (!next.has_value() || !next.value()) break;
+            EXPECT(message.id == count);
+            count++;
+        }
+        EXPECT(count == 500 && decoder.done());
+        EXPECT(decoder.position() == stream.size());
+    }
+}
+
+TEST(incremental_decoder_reads_stream) {
+    const CompactBinarySerializer serializer {};
+    std::istringstream            input { make_stream(serializer, 100) };
+
+    IncrementalDecoder decoder { &serializer };
+    Message            message {};
+    uint64             count = 0;
+    while (decoder.read_from(input, 64) > 0)
+        while (decoder.next(message).value())
+            count++;
+    decoder.finish();
+    while (decoder.next(message).value())
+        count++;
+    EXPECT(count == 100 && decoder.done());
+}
+
+TEST(incremental_decoder_reports_truncated_stream) {
+    const CompactBinarySerializer serializer {};
+    const auto                    stream = make_stream(serializer, 10);
+
+    IncrementalDecoder decoder { &serializer };
+    decoder.feed(stream.data(), stream.size() - 1);
+    decoder.finish();
+    Message message {};
+    uint64  count = 0;
+    while (true) {
+        const auto next = decoder.next(message);
+        if (next.has_error() || !next.value()) {
+            EXPECT(next.has_error());
+            break;
+        }
+        count++;
+    }
+    EXPECT(count == 9 && !decoder.done());
+}
+
+TEST(incremental_decoder_rejects_forged_count) {
+    const CompactBinarySerializer serializer {};
+    BufferSink                    header {};
+    serializer.write_header(header);
+
+    // Message with empty text, and values claiming a huge count
+    const auto huge   = (uint64) 1 << 40;
+    const auto stream = String(header.view()) +
+                        serializer.serialize((uint64) 1) +
+                        serializer.serialize((uint64) 0) +
+                        serializer.serialize(huge) + String(16, '\0');
+
+    IncrementalDecoder decoder { &serializer };
+    decoder.feed(stream.data(), stream.size());
+    decoder.finish();
+    Message    message {};
+    const auto next = decoder.next(message);
+    EXPECT(next.has_error() && !decoder.done());
+}
@@ -0,0 +1,28 @@
+#include "test.hpp"
+
+#include <cstring>
+
+// Runs all test cases, or only those whose name contains the first argument
+int main(int argc, char** argv) {
+    const char* const filter = argc > 1 ? argv[1] : "";
+    uint64_t          count  = 0;
+    for (auto test_case = unit_test::Case::cases().first; test_case;
+         test_case      = test_case->next) {
+        if (std::strstr(test_case->name, filter) == nullptr) continue;
+
+        const auto failed = unit_test::failures();
+        test_case->run();
+        std::printf(
+            "[%s] %s\n",
+            unit_test::failures() == failed ? " OK " : "FAIL",
+            test_case->name
+        );
+        count++;
+    }
+    std::printf(
+        "%llu tests, %llu failed expectations\n",
+        (unsigned long long) count,
+        unit_test::failures()
+    );
+    return unit_test::failures() == 0 ? 0 : 1;
+}
@@ -0,0 +1,84 @@
+#include "test.hpp"
+
+#include "observable_property.hpp"
+#include "string.hpp"
+
+using namespace a172;
+
+namespace {
+
+struct Widget {
+    ChangeTracker                     tracker {};
+    ObservableProperty<int32>         width { tracker, 100 };
+    ObservableProperty<int32>         height { tracker, 50 };
+    ObservableProperty<String>        title { tracker, "widget" };
+    ObservableProperty<Vector<int32>> items { tracker };
+};
+
+} // namespace
+
+TEST(observable_property_dirty_mask) {
+    Widget widget {};
+    EXPECT(widget.width.mask() == 1 && widget.height.mask() == 2);
+    EXPECT(widget.title.mask() == 4 && widget.items.mask() == 8);
+    EXPECT(!widget.tracker.is_dirty() && widget.width == 100);
+
+    widget.width = 200;
+    widget.title = "renamed";
+    const auto changed = widget.width.mask() | widget.title.mask();
+    EXPECT(widget.tracker.dirty() == changed);
+    EXPECT(widget.width.is_dirty() && !widget.height.is_dirty());
+    EXPECT(widget.tracker.is_dirty(widget.title.mask()));
+
+    // Setting an equal value isn't a change
+    widget.height = 50;
+    EXPECT(!widget.height.is_dirty() && widget.height.version() == 0);
+
+    // Modify always marks, as change can't be detected
+    widget.items.modify([](Vector<int32>& items) { items.push_back(1); });
+    EXPECT(widget.items.is_dirty() && widget.items->size() == 1);
+
+    widget.tracker.clear();
+    EXPECT(!widget.tracker.is_dirty() && widget.width == 200);
+    EXPECT(widget.tracker.version() == 3 && widget.width.version() == 1);
+
+    ChangeTracker tracker {};
+    for (uint32 i = 0; i < ChangeTracker::max_properties; i++)
+        tracker.register_property();
+    bool thrown = false;
+    try {
+        tracker.register_property();
+    } catch (const InvalidArgument&) { thrown = true; }
+    EXPECT(thrown);
+}
+
+TEST(observable_property_batched_flush) {
+    Widget         widget {};
+    Vector<uint64> flushed {};
+    widget.tracker.on_change.subscribe([&](const uint64 mask) {
+        flushed.push_back(mask);
+    });
+
+    // Many changes between two flushes are delivered as one notification
+    for (int32 i = 1; i <= 10; i++) {
+        widget.width  = i;
+        widget.height = 2 * i;
+    }
+    EXPECT(flushed.empty());
+    const auto mask = widget.width.mask() | widget.height.mask();
+    EXPECT(widget.tracker.flush() == mask);
+    EXPECT(flushed.size() == 1 && flushed[0] == mask);
+    EXPECT(widget.width.version() == 10 && !widget.tracker.is_dirty());
+
+    // Nothing changed, so nothing is delivered
+    EXPECT(widget.tracker.flush() == 0 && flushed.size() == 1);
+
+    // Assignment from another property copies only the value
+    Widget other {};
+    other.title = widget.title;
+    EXPECT(!other.tracker.is_dirty());
+    widget.title = "copied";
+    other.title  = widget.title;
+    EXPECT(other.title() == "copied" && other.tracker.flush() == 4);
+    EXPECT(widget.tracker.flush() == 4 && flushed.size() == 2);
+}
@@ -0,0 +1,64 @@
+#include "test.hpp"
+
+#include "property.hpp"
+
+using namespace a172;
+
+namespace {
+
+struct Point;
+int32 doubled_x(const Point& point);
+void  set_doubled_x(Point& point, int32 value);
+
+struct Point {
+    int32  _x = 0, _y = 0;
+    String _name {};
+
+    void  set_y(const int32 value) { _y = value < 0 ? 0 : value; }
+    int32 get_y() const { return _y; }
+
+    STATIC_PROPERTY(Point, x, &Point::_x, &Point::_x);
+    STATIC_PROPERTY(Point, y, &Point::get_y, &Point::set_y);
+    STATIC_PROPERTY(Point, doubled, doubled_x, set_doubled_x);
+    STATIC_PROPERTY(Point, name, &Point::_name);
+};
+
+int32 doubled_x(const Point& point) { return 2 * point._x; }
+void  set_doubled_x(Point& point, const int32 value) { point._x = value / 2; }
+
+} // namespace
+
+TEST(static_property_accessors) {
+    Point point {};
+    point.x = 3;
+    EXPECT(point._x == 3 && point.x == 3 && point.x() == 3);
+
+    // Setter method clamps the value
+    point.y = -5;
+    EXPECT(point.y == 0);
+    point.y = 7;
+    EXPECT(point._y == 7 && point.y.get() == 7);
+
+    point.doubled = 10;
+    EXPECT(point._x == 5 && point.doubled == 10);
+
+    point._name = "point";
+    EXPECT(point.name->size() == 5 && point.name() == "point");
+}
+
+TEST(static_property_follows_owner) {
+    Point first {};
+    first.x = 1;
+
+    // Copied property reads its new owner, not the one it was copied from
+    Point second { first };
+    second.x = 2;
+    EXPECT(first.x == 1 && second.x == 2);
+
+    first = second;
+    second.x = 3;
+    EXPECT(first.x == 2 && second.x == 3);
+
+    // Properties hold no state
+    EXPECT(sizeof(Point) == 2 * sizeof(int32) + sizeof(String));
+}
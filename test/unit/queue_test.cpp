@@ -0,0 +1,82 @@
+#include "test.hpp"
+
+#include "multithreading/mpmc_queue.hpp"
+#include "multithreading/spsc_queue.hpp"
+
+#include <thread>
+
+using namespace a172;
+
+TEST(spsc_queue_keeps_order) {
+    parallel::SPSCQueue<uint64> queue { 64 };
+    const uint64                count = 100000;
+
+    // Every other element is pushed as part of a batch
+    std::thread producer { [&]() {
+        for (uint64 i = 0; i < count; i += 2) {
+            const uint64 batch[] { i, i + 1 };
+            if (i % 4 == 0) queue.push_batch(batch, 2);
+            else {
+                queue.push(batch[0]);
+                queue.push(batch[1]);
+            }
+        }
+    } };
+    bool ordered = true;
+    for (uint64 i = 0; i < count; i++) {
+        uint64 value;
+        queue.pop(value);
+        ordered = ordered && value == i;
+    }
+    producer.join();
+    EXPECT(ordered && queue.empty());
+
+    // Capacity is rounded up to a power of two
+    parallel::SPSCQueue<uint64> small { 3 };
+    EXPECT(small.capacity() == 4);
+    for (uint64 i = 0; i < 4; i++)
+        EXPECT(small.try_push(i));
+    EXPECT(!small.try_push((uint64) 4));
+    uint64 values[8];
+    EXPECT(small.try_pop_batch(values, 8) == 4);
+    EXPECT(values[0] == 0 && values[3] == 3);
+    EXPECT(!small.try_pop(values[0]));
+}
+
+TEST(mpmc_queue_sum) {
+    parallel::MPMCQueue<uint64> queue { 128 };
+    const uint64                count   = 20000;
+    const uint64                threads = 4;
+
+    std::atomic<uint64> sum { 0 };
+    std::thread         producers[threads], consumers[threads];
+    for (uint64 t = 0; t < threads; t++) {
+        producers[t] = std::thread { [&]() {
+            for (uint64 i = 1; i <= count; i++)
+                queue.push(i);
+        } };
+        consumers[t] = std::thread { [&]() {
+            uint64 local = 0;
+            for (uint64 i = 0; i < count; i++) {
+                uint64 value;
+                queue.pop(value);
+                local += value;
+            }
+            sum += local;
+        } };
+    }
+    for (uint64 t = 0; t < threads; t++) {
+        producers[t].join();
+        consumers[t].join();
+    }
+    EXPECT(sum == threads * count * (count + 1) / 2);
+    EXPECT(queue.empty());
+
+    // Batches stop at capacity
+    parallel::MPMCQueue<uint64> small { 4 };
+    const uint64                items[] { 1, 2, 3, 4, 5, 6 };
+    EXPECT(small.try_push_batch(items, 6) == 4);
+    uint64 values[8];
+    EXPECT(small.try_pop_batch(values, 8) == 4);
+    EXPECT(values[0] == 1 && values[3] == 4);
+}
@@ -0,0 +1,106 @@
+#include "test.hpp"
+
+#include "multithreading/reclamation.hpp"
+#include "multithreading/synchronization.hpp"
+
+#include <thread>
+
+using namespace a172;
+using namespace a172::parallel;
+
+namespace {
+
+std::atomic<uint64> freed { 0 };
+
+void free_counted(void* const pointer) {
+    delete (uint64*) pointer;
+    freed++;
+}
+
+} // namespace
+
+TEST(epoch_reclamation_waits_for_readers) {
+    freed = 0;
+
+    // Reader in a region started before retirement holds the object back
+    Latch       entered { 1 }, release { 1 };
+    std::thread reader { [&]() {
+        EpochGuard guard {};
+        entered.count_down();
+        release.wait();
+    } };
+    entered.wait();
+    EpochReclamation::retire(new uint64(1), free_counted);
+    for (uint64 i = 0; i < 10; i++)
+        EpochReclamation::collect();
+    EXPECT(freed == 0);
+
+    release.count_down();
+    reader.join();
+    EpochReclamation::synchronize();
+    EXPECT(freed == 1);
+
+    // Regions nest
+    {
+        EpochGuard outer {};
+        {
+            EpochGuard inner {};
+        }
+        EXPECT(EpochReclamation::in_critical_region());
+    }
+    EXPECT(!EpochReclamation::in_critical_region());
+}
+
+TEST(hazard_pointer_protects_object) {
+    freed = 0;
+    std::atomic<uint64*> shared { new uint64(7) };
+
+    HazardPointer hazard {};
+    const auto    value = hazard.protect(shared);
+    EXPECT(value && *value == 7);
+
+    // Unlinked and retired, but still protected
+    shared = nullptr;
+    HazardPointer::retire(value, free_counted);
+    HazardPointer::collect();
+    EXPECT(freed == 0 && *value == 7);
+
+    hazard.reset();
+    HazardPointer::collect();
+    EXPECT(freed == 1);
+}
+
+TEST(reclamation_concurrent_readers) {
+    // Writer keeps replacing the value, while readers dereference it
+    std::atomic<uint64*> epoch_value { new uint64(0) };
+    std::atomic<uint64*> hazard_value { new uint64(0) };
+    std::atomic<bool>    done { false }, valid { true };
+
+    std::thread readers[2];
+    for (auto& reader : readers) {
+        reader = std::thread { [&]() {
+            HazardPointer hazard {};
+            while (!done) {
+                {
+                    EpochGuard guard {};
+                    if (*epoch_value.load() > 100000) valid = false;
+                }
+                if (*hazard.protect(hazard_value) > 100000) valid = false;
+                hazard.reset();
+            }
+        } };
+    }
+    for (uint64 i = 1; i <= 5000; i++) {
+        EpochReclamation::retire(epoch_value.exchange(new uint64(i)));
+        HazardPointer::retire(hazard_value.exchange(new uint64(i)));
+    }
+    done = true;
+    for (auto& reader : readers)
+        reader.join();
+    EXPECT(valid);
+
+    EpochReclamation::retire(epoch_value.load());
+    HazardPointer::retire(hazard_value.load());
+    EpochReclamation::synchronize();
+    HazardPointer::collect();
+}
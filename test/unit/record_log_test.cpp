@@ -0,0 +1,260 @@
+#include "test.hpp"
+
+#include "serialization/binary_serializer.hpp"
+#include "serialization/compact_binary_serializer.hpp"
+#include "serialization/record_log.hpp"
+
+#include <fstream>
+#include <thread>
+
+#ifdef __linux__
+#    include <csignal>
+#    include <sys/resource.h>
+#endif
+
+using namespace a172;
+
+namespace {
+
+struct Event : public Serializable {
+    uint64 id = 0;
+    String name {};
+
+    serializable_attributes(id, name);
+};
+
+Path fresh_log(const char* const name) {
+    const Path path { unit_test::temp_directory() / name };
+    std::filesystem::remove(path);
+    std::filesystem::remove(RecordLog::index_path(path));
+    return path;
+}
+
+void append_events(
+    const Path&              path,
+    const Serializer&        serializer,
+    const uint64             begin,
+    const uint64             end,
+    const RecordLogSettings& settings = {}
+) {
+    auto writer = RecordLogWriter::open(path, &serializer, settings);
+    EXPECT(writer.has_value());
+    if (writer.has_error()) return;
+    for (uint64 i = begin; i < end; i++) {
+        Event event {};
+        event.id   = i;
+        event.name = "event " + std::to_string(i);
+        EXPECT(writer.value()->append(event).has_value());
+    }
+    EXPECT(writer.value()->record_count() == end);
+}
+
+// Reads all records, expecting consecutive ids
+uint64 read_events(const Path& path, const Serializer& serializer) {
+    auto reader = RecordLogReader::open(path, &serializer);
+    EXPECT(reader.has_value());
+    if (reader.has_error()) return 0;
+
+    Event  event {};
+    uint64 count = 0;
+    while (true) {
+        const auto next = reader.value().next(event);
+        EXPECT(next.has_value());
+        if (!next.has_value() || !next.value()) break;
+        EXPECT(event.id == count);
+        count++;
+    }
+    return count;
+}
+
+void copy_truncated(const Path& from, const Path& to, const uint64 size) {
+    std::filesystem::copy_file(
+        from, to, std::filesystem::copy_options::overwrite_existing
+    );
+    std::filesystem::resize_file(to, size);
+}
+
+} // namespace
+
+TEST(crc32c_checksum) {
+    // Standard check value
+    EXPECT(RecordLog::checksum("123456789", 9) == 0xE3069283);
+    EXPECT(
+        RecordLog::checksum("56789", 5, RecordLog::checksum("1234", 4)) ==
+        0xE3069283
+    );
+}
+
+TEST(record_log_round_trip) {
+    const BinarySerializer serializer {};
+    const auto             path = fresh_log("round_trip.log");
+
+    RecordLogSettings settings {};
+    settings.commit_size = 1 * KB;
+    settings.sync        = LogSync::Never;
+    append_events(path, serializer, 0, 3000, settings);
+    EXPECT(read_events(path, serializer) == 3000);
+
+    // Reopened log continues
+    append_events(path, serializer, 3000, 3100, settings);
+    EXPECT(read_events(path, serializer) == 3100);
+
+    // Log of other serializer isn't read
+    const CompactBinarySerializer compact {};
+    EXPECT(RecordLogReader::open(path, &compact).has_error());
+}
+
+TEST(record_log_torn_tail) {
+    const BinarySerializer serializer {};
+    const auto             path = fresh_log("torn.log");
+    const auto             torn = fresh_log("torn_copy.log");
+    append_events(path, serializer, 0, 100);
+
+    const auto size = std::filesystem::file_size(path);
+    for (const uint64 cut : { 1, 4, 8, 9, 15 }) {
+        copy_truncated(path, torn, size - cut);
+        EXPECT(read_events(torn, serializer) == 99);
+
+        auto reader = RecordLogReader::open(torn, &serializer);
+        while (reader.value().skip())
+            ;
+        EXPECT(reader.value().torn());
+
+        // Writer cuts torn tail off before appending
+        append_events(torn, serializer, 99, 120);
+        EXPECT(read_events(torn, serializer) == 120);
+    }
+}
+
+TEST(record_log_seek) {
+    const BinarySerializer serializer {};
+    const auto             path = fresh_log("seek.log");
+
+    RecordLogSettings settings {};
+    settings.index_interval = 64;
+    append_events(path, serializer, 0, 1000, settings);
+
+    auto reader = RecordLogReader::open(path, &serializer);
+    EXPECT(reader.has_value() && reader.value().has_index());
+    Event event {};
+    for (const uint64 record : { 999, 0, 64, 65, 500 }) {
+        EXPECT(reader.value().seek(record).has_value());
+        EXPECT(reader.value().next(event).value() && event.id == record);
+    }
+    // Seeking to the end is allowed, but past it isn't
+    EXPECT(reader.value().seek(1000).has_value());
+    EXPECT(!reader.value().next(event).value());
+    EXPECT(reader.value().seek(1001).has_error());
+
+    // Index is trimmed with the log
+    const auto torn = fresh_log("seek_copy.log");
+    copy_truncated(path, torn, std::filesystem::file_size(path) / 2);
+    std::filesystem::copy_file(
+        RecordLog::index_path(path), RecordLog::index_path(torn)
+    );
+    append_events(torn, serializer, read_events(torn, serializer), 1200);
+    auto trimmed = RecordLogReader::open(torn, &serializer);
+    EXPECT(trimmed.value().seek(1100).has_value());
+    EXPECT(trimmed.value().next(event).value() && event.id == 1100);
+}
+
+TEST(record_log_concurrent_appends) {
+    const BinarySerializer serializer {};
+    const auto             path = fresh_log("concurrent.log");
+
+    RecordLogSettings settings {};
+    settings.commit_size = 512;
+    settings.sync        = LogSync::Interval;
+    {
+        auto writer = RecordLogWriter::open(path, &serializer, settings);
+        std::vector<std::thread> threads {};
+        for (uint64 t = 0; t < 4; t++)
+            threads.emplace_back([&, t]() {
+                for (uint64 i = 0; i < 1000; i++) {
+                    Event event {};
+                    event.id = t * 1000 + i;
+                    EXPECT(writer.value()->append(event).has_value());
+                }
+            });
+        for (auto& thread : threads)
+            thread.join();
+    }
+
+    // Records of each thread keep their order
+    auto   reader = RecordLogReader::open(path, &serializer);
+    Event  event {};
+    uint64 next[4] { 0, 1000, 2000, 3000 };
+    uint64 count = 0;
+    while (reader.value().next(event).value()) {
+        EXPECT(event.id == next[event.id / 1000]++);
+        count++;
+    }
+    EXPECT(count == 4000 && !reader.value().torn());
+}
+
+TEST(record_log_rejects_corruption_in_middle) {
+    const BinarySerializer serializer {};
+    const auto             path = fresh_log("corrupted.log");
+    const auto             copy = fresh_log("corrupted_copy.log");
+    append_events(path, serializer, 0, 1000);
+
+    // Flipped bit in a frame size, and in a payload
+    auto reader = RecordLogReader::open(path, &serializer);
+    EXPECT(reader.value().seek(500).has_value());
+    const auto frame = reader.value().position();
+    const auto size  = std::filesystem::file_size(path);
+    for (const uint64 offset : { frame, frame + 10 }) {
+        std::filesystem::copy_file(path, copy);
+        {
+            std::fstream file {
+                copy, std::ios::in | std::ios::out | std::ios::binary
+            };
+            file.seekg(offset);
+            const auto value = (byte) file.get();
+            file.seekp(offset);
+            file.put((byte) (value ^ 0x10));
+        }
+
+        // Reader stops at the damage, but writer doesn't cut it off
+        EXPECT(read_events(copy, serializer) < 1000);
+        EXPECT(RecordLogWriter::open(copy, &serializer).has_error());
+        EXPECT(std::filesystem::file_size(copy) == size);
+        std::filesystem::remove(copy);
+    }
+}
+
+#ifdef __linux__
+TEST(record_log_write_failure) {
+    const BinarySerializer serializer {};
+    const auto             path = fresh_log("failure.log");
+    append_events(path, serializer, 0, 100);
+    const auto committed = std::filesystem::file_size(path);
+
+    // Writes past file size limit fail, instead of raising a signal
+    std::signal(SIGXFSZ, SIG_IGN);
+    rlimit previous {};
+    getrlimit(RLIMIT_FSIZE, &previous);
+    rlimit limit   = previous;
+    limit.rlim_cur = committed + 100;
+    setrlimit(RLIMIT_FSIZE, &limit);
+    {
+        auto writer = RecordLogWriter::open(path, &serializer);
+        EXPECT(writer.has_value());
+        Event event {};
+        event.id   = 100;
+        event.name = String(200, 'x');
+        EXPECT(writer.value()->append(event).has_value());
+        EXPECT(writer.value()->commit().has_error());
+
+        // Failed writer rejects further records
+        EXPECT(writer.value()->append(event).has_error());
+        EXPECT(writer.value()->commit().has_error());
+    }
+    setrlimit(RLIMIT_FSIZE, &previous);
+    std::signal(SIGXFSZ, SIG_DFL);
+
+    // Partially written batch was cut off
+    EXPECT(std::filesystem::file_size(path) == committed);
+    EXPECT(read_events(path, serializer) == 100);
+}
+#endif
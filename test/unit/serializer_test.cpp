@@ -0,0 +1,383 @@
+#include "test.hpp"
+
+#include "serialization/binary_serializer.hpp"
+#include "serialization/chunked_vector.hpp"
+#include "serialization/compact_binary_serializer.hpp"
+#include "serialization/framed_binary_serializer.hpp"
+#include "serialization/lazy.hpp"
+
+using namespace a172;
+
+namespace {
+
+struct Inner : public Serializable {
+    int32          id = 0;
+    String         name {};
+    Vector<uint16> codes {};
+
+    bool operator==(const Inner& other) const {
+        return id == other.id && name == other.name && codes == other.codes;
+    }
+
+    serializable_attributes(id, name, codes);
+};
+
+struct Outer : public Serializable {
+    bool            flag  = false;
+    int8            small = 0;
+    int64           big   = 0;
+    uint128         huge  = 0;
+    float32         ratio = 0;
+    float64         value = 0;
+    String          text {};
+    Vector<float64> samples {};
+    Vector<String>  words {};
+    Inner           inner {};
+    Vector<Inner>   children {};
+
+    bool operator==(const Outer& other) const {
+        return flag == other.flag && small == other.small &&
+               big == other.big && huge == other.huge &&
+               ratio == other.ratio && value == other.value &&
+               text == other.text && samples == other.samples &&
+               words == other.words && inner == other.inner &&
+               children == other.children;
+    }
+
+    serializable_attributes(
+        flag,
+        small,
+        big,
+        huge,
+        ratio,
+        value,
+        text,
+        samples,
+        words,
+        inner,
+        children
+    );
+};
+
+// Two versions of the same object
+struct Old : public Serializable {
+    int32  id = 0;
+    String name {};
+
+    serializable_attributes(id, name);
+};
+struct New : public Serializable {
+    int32  id    = 0;
+    String name {};
+    uint64 added = 7;
+
+    serializable_attributes(id, name, added);
+};
+
+struct Holder : public Serializable {
+    int32       id = 0;
+    Lazy<Inner> inner {};
+
+    serializable_attributes(id, inner);
+};
+
+// Default constructed `Vector` reserves from the general pool, so elements of
+// large vectors hold only plain members
+struct Item : public Serializable {
+    int32  id = 0;
+    String name {};
+
+    bool operator==(const Item& other) const {
+        return id == other.id && name == other.name;
+    }
+
+    serializable_attributes(id, name);
+};
+
+struct Snapshot : public Serializable {
+    ChunkedVector<Item> items { TAllocator<Item>(BaseMemoryTags.Unknown) };
+
+    serializable_attributes(items);
+};
+
+Outer make_outer() {
+    Outer outer {};
+    outer.flag        = true;
+    outer.small       = -7;
+    outer.big         = -1234567890123;
+    outer.huge        = ((uint128) 1 << 100) + 5;
+    outer.ratio       = 0.5f;
+    outer.value       = -3.25;
+    outer.text        = String("text with \0 inside", 18);
+    outer.samples     = { 1.5, -2.0, 1e300 };
+    outer.words       = { "a", "", "longer word" };
+    outer.inner.id    = -42;
+    outer.inner.name  = "inner";
+    outer.inner.codes = { 1, 300, 65535 };
+    for (int32 i = 0; i < 3; i++) {
+        Inner child {};
+        child.id   = i;
+        child.name = "child";
+        child.codes.push_back((uint16) i);
+        outer.children.push_back(child);
+    }
+    return outer;
+}
+
+// Round trip of whole object, and failure on every truncation of it
+void check_round_trip(const Serializer& serializer) {
+    const auto outer = make_outer();
+    const auto data  = outer.serialize(&serializer);
+
+    Outer      read {};
+    const auto result = read.deserialize(&serializer, data);
+    EXPECT(result.has_value() && result.value() == data.size());
+    EXPECT(read == outer);
+
+    for (uint64 size = 0; size < data.size(); size++) {
+        Outer truncated {};
+        EXPECT(truncated.deserialize(&serializer, data.substr(0, size))
+                   .has_error());
+    }
+}
+
+// Whole document with header, read through `deserialize_from_file`
+void check_file(const Serializer& serializer, const char* const name) {
+    const Path path { unit_test::temp_directory() / name };
+    const auto outer = make_outer();
+    EXPECT(outer.serialize_to_file(path, &serializer).has_value());
+
+    Outer read {};
+    EXPECT(read.deserialize_from_file(path, &serializer).has_value());
+    EXPECT(read == outer);
+}
+
+} // namespace
+
+TEST(binary_serializer_round_trip) {
+    check_round_trip(BinarySerializer {});
+    check_round_trip(BinarySerializer { Endianness::Big });
+    check_file(BinarySerializer {}, "binary.bin");
+}
+
+TEST(serialize_to_file_reports_write_failure) {
+#ifdef __linux__
+    // Every write to it fails for lack of space
+    const BinarySerializer serializer {};
+    const auto             outer = make_outer();
+    EXPECT(outer.serialize_to_file("/dev/full", &serializer).has_error());
+#endif
+}
+
+TEST(serialize_to_file_compressed) {
+    const BinarySerializer    serializer {};
+    const CompressionSettings compression {};
+    const Path path { unit_test::temp_directory() / "compressed.bin" };
+    const auto outer = make_outer();
+    EXPECT(outer.serialize_to_file(path, &serializer, compression).has_value());
+
+    Outer read {};
+    EXPECT(read.deserialize_from_file(path, &serializer).has_value());
+    EXPECT(read == outer);
+
+#ifdef __linux__
+    EXPECT(outer.serialize_to_file("/dev/full", &serializer, compression)
+               .has_error());
+#endif
+}
+
+TEST(binary_serializer_endianness) {
+    const BinarySerializer little { Endianness::Little };
+    const BinarySerializer big { Endianness::Big };
+    const uint32           value = 0x01020304;
+    EXPECT(little.serialize(value) == String("\x04\x03\x02\x01", 4));
+    EXPECT(big.serialize(value) == String("\x01\x02\x03\x04", 4));
+
+    // Header records byte order, so it's checked on read
+    BufferSink header {};
+    big.write_header(header);
+    uint64 position = 0;
+    EXPECT(little.read_header(String(header.view()), position).has_error());
+}
+
+TEST(buffer_sink_take_moves_buffer) {
+    BufferSink sink {};
+    const String data(1000, 'd');
+    sink.write(data.data(), data.size());
+
+    const auto buffer = sink.view().data();
+    const auto taken  = sink.take();
+    EXPECT(taken == data && taken.data() == buffer);
+    EXPECT(sink.size() == 0);
+}
+
+TEST(compact_binary_serializer_round_trip) {
+    check_round_trip(CompactBinarySerializer {});
+    check_file(CompactBinarySerializer {}, "compact.bin");
+
+    // Small integers take a single byte
+    const CompactBinarySerializer serializer {};
+    EXPECT(serializer.serialize((int64) -1).size() < sizeof(int64));
+}
+
+TEST(framed_binary_serializer_round_trip) {
+    check_round_trip(FramedBinarySerializer {});
+    check_file(FramedBinarySerializer {}, "framed.bin");
+}
+
+TEST(framed_binary_serializer_schema_evolution) {
+    const FramedBinarySerializer serializer {};
+
+    New current {};
+    current.id    = 5;
+    current.name  = "name";
+    current.added = 99;
+    Old old {};
+    EXPECT(old.deserialize(&serializer, current.serialize(&serializer))
+               .has_value());
+    EXPECT(old.id == 5 && old.name == "name");
+
+    New upgraded {};
+    EXPECT(upgraded.deserialize(&serializer, old.serialize(&serializer))
+               .has_value());
+    EXPECT(upgraded.id == 5 && upgraded.name == "name");
+    EXPECT(upgraded.added == 7);
+
+    // Single field, without decoding others
+    const auto data = current.serialize(&serializer);
+    String     name {};
+    EXPECT(serializer.deserialize_field(data, 0, 2, name).has_value());
+    EXPECT(name == "name");
+}
+
+TEST(lazy_round_trip) {
+    const FramedBinarySerializer serializer {};
+
+    Holder holder {};
+    holder.id = 3;
+    Inner inner {};
+    inner.name = "lazy";
+    holder.inner.set(inner);
+    const auto data = holder.serialize(&serializer);
+
+    Holder read {};
+    EXPECT(read.deserialize(&serializer, data).has_value());
+    EXPECT(!read.inner.is_decoded());
+    EXPECT(read.serialize(&serializer) == data);
+    const auto value = read.inner.get();
+    EXPECT(value.has_value() && *value.value() == inner);
+
+    // Conversion into other serializer
+    const CompactBinarySerializer compact {};
+    Holder                        converted {};
+    EXPECT(read.deserialize(&serializer, data).has_value());
+    EXPECT(converted.deserialize(&compact, read.serialize(&compact))
+               .has_value());
+    EXPECT(converted.inner.get().has_value());
+    EXPECT(*converted.inner.get().value() == inner);
+
+    // Malformed value is reported on access
+    Lazy<Inner> malformed {};
+    EXPECT(malformed.deserialize(&serializer, serializer.serialize(String("x")))
+               .has_value());
+    EXPECT(malformed.get().has_error());
+}
+
+TEST(vector_rejects_forged_count) {
+    const BinarySerializer        binary {};
+    const CompactBinarySerializer compact {};
+    const FramedBinarySerializer  framed {};
+
+    const Serializer* const serializers[] { &binary, &compact, &framed };
+    for (const auto serializer : serializers) {
+        // Count prefix is encoded as a size, same as a lone integer
+        for (const uint64 count : { (uint64) 100, (uint64) 1 << 40 }) {
+            const auto data = serializer->serialize(count) + String(64, '\0');
+            const auto tag  = BaseMemoryTags.Unknown;
+
+            Vector<uint32> values { TAllocator<uint32>(tag) };
+            Vector<String> words { TAllocator<String>(tag) };
+            Vector<Item>   items { TAllocator<Item>(tag) };
+            EXPECT(serializer->deserialize(data, 0, values).has_error());
+            EXPECT(serializer->deserialize(data, 0, words).has_error());
+            EXPECT(serializer->deserialize(data, 0, items).has_error());
+            EXPECT(values.size() < count && words.size() < count);
+            EXPECT(items.size() < count);
+        }
+    }
+}
+
+TEST(string_rejects_forged_size) {
+    const BinarySerializer        binary {};
+    const CompactBinarySerializer compact {};
+    const FramedBinarySerializer  framed {};
+
+    const Serializer* const serializers[] { &binary, &compact, &framed };
+    for (const auto serializer : serializers) {
+        // Size prefix longer than remaining input
+        for (const uint64 size : { (uint64) 100, (uint64) 1 << 40 }) {
+            const auto data = serializer->serialize(size) + String(64, 's');
+            String     text {};
+            EXPECT(serializer->deserialize(data, 0, text).has_error());
+        }
+    }
+}
+
+TEST(chunked_vector_round_trip) {
+    const BinarySerializer        binary {};
+    const CompactBinarySerializer compact {};
+    const FramedBinarySerializer  framed {};
+
+    const Serializer* const serializers[] { &binary, &compact, &framed };
+    for (const auto serializer : serializers) {
+        for (const uint64 count : { 0, 1, 4095, 4096, 4097, 10000 }) {
+            Snapshot snapshot {};
+            for (uint64 i = 0; i < count; i++) {
+                Item item {};
+                item.id   = (int32) i;
+                item.name = "item";
+                snapshot.items.push_back(item);
+            }
+            const auto data = snapshot.serialize(serializer);
+
+            Snapshot   read {};
+            const auto result = read.deserialize(serializer, data);
+            EXPECT(result.has_value() && result.value() == data.size());
+            EXPECT(read.items == snapshot.items);
+
+            // Truncations are rejected
+            for (uint64 size = 0; size < data.size();
+                 size += data.size() / 64 + 1) {
+                Snapshot truncated {};
+                EXPECT(truncated.deserialize(serializer, data.substr(0, size))
+                           .has_error());
+            }
+        }
+    }
+}
+
+TEST(chunked_vector_rejects_forged_header) {
+    const BinarySerializer        binary {};
+    const CompactBinarySerializer compact {};
+    const FramedBinarySerializer  framed {};
+
+    const Serializer* const serializers[] { &binary, &compact, &framed };
+    for (const auto serializer : serializers) {
+        // Huge count in a single huge chunk, followed by a few bytes
+        const auto huge = (uint64) 1 << 40;
+        auto       data = serializer->serialize(huge) +
+                    serializer->serialize(huge) +
+                    serializer->serialize((uint64) 14) + String(14, '\0');
+        Vector<Item> items { TAllocator<Item>(BaseMemoryTags.Unknown) };
+        EXPECT(serializer->deserialize_chunked(data, 0, items).has_error());
+        EXPECT(items.empty());
+
+        // More elements than bytes in chunks
+        data = serializer->serialize((uint64) 3) +
+               serializer->serialize((uint64) 1);
+        for (uint64 i = 0; i < 3; i++)
+            data += serializer->serialize((uint64) 0);
+        data += String(8, '\0');
+        EXPECT(serializer->deserialize_chunked(data, 0, items).has_error());
+    }
+}
@@ -0,0 +1,116 @@
+#include "test.hpp"
+
+#include "serialization/compact_binary_serializer.hpp"
+#include "serialization/serialized_view.hpp"
+#include "serialization/static_serializer.hpp"
+
+using namespace a172;
+
+namespace {
+
+struct Point : public Serializable {
+    int32   x      = 0;
+    int32   y      = 0;
+    float64 weight = 0;
+
+    serializable_attributes(x, y, weight);
+};
+
+struct Shape : public Serializable {
+    uint64        id = 0;
+    String        name {};
+    Vector<int64> values {};
+    Vector<Point> points {};
+    Point         origin {};
+    int128        total = 0;
+
+    serializable_attributes(id, name, values, points, origin, total);
+};
+
+Shape make_shape() {
+    Shape shape {};
+    shape.id     = 77;
+    shape.total  = -((int128) 1 << 100);
+    shape.name   = "shape";
+    shape.values = { -1, 0, 1, 1LL << 40 };
+    for (int32 i = 0; i < 4; i++) {
+        Point point {};
+        point.x      = i;
+        point.y      = -i;
+        point.weight = i * 0.5;
+        shape.points.push_back(point);
+    }
+    shape.origin.x = 9;
+    return shape;
+}
+
+template<typename Static>
+void check_matches(const Serializer& serializer) {
+    const auto shape = make_shape();
+    const auto data  = Static::serialize(shape);
+
+    // Same bytes as the virtual serializer, read by both
+    EXPECT(data == shape.serialize(&serializer));
+    Shape      read {};
+    const auto result = Static::deserialize(data, 0, read);
+    EXPECT(result.has_value() && result.value() == data.size());
+    EXPECT(read.serialize(&serializer) == data);
+
+    for (uint64 size = 0; size < data.size(); size++) {
+        Shape truncated {};
+        EXPECT(Static::deserialize(data.substr(0, size), 0, truncated)
+                   .has_error());
+    }
+}
+
+// Vectors claiming more elements than input holds are rejected
+template<typename Static, typename Encoder>
+void check_rejects_forged_count() {
+    for (const uint64 count : { (uint64) 100, (uint64) 1 << 40 }) {
+        BufferSink sink {};
+        Encoder::write_size(sink, count);
+        const auto data = String(sink.view()) + String(64, '\0');
+        const auto tag  = BaseMemoryTags.Unknown;
+
+        Vector<int64>  values { TAllocator<int64>(tag) };
+        Vector<String> words { TAllocator<String>(tag) };
+        Vector<Point>  points { TAllocator<Point>(tag) };
+        EXPECT(Static::deserialize(data, 0, values).has_error());
+        EXPECT(Static::deserialize(data, 0, words).has_error());
+        EXPECT(Static::deserialize(data, 0, points).has_error());
+    }
+}
+
+} // namespace
+
+TEST(static_serializer_rejects_forged_count) {
+    check_rejects_forged_count<StaticBinarySerializer, BinaryEncoder>();
+    check_rejects_forged_count<
+        StaticCompactBinarySerializer,
+        CompactBinaryEncoder>();
+}
+
+TEST(static_serializer_matches_binary) {
+    check_matches<StaticBinarySerializer>(BinarySerializer {});
+}
+
+TEST(static_serializer_matches_compact) {
+    check_matches<StaticCompactBinarySerializer>(CompactBinarySerializer {});
+}
+
+TEST(serialized_view_reads_in_place) {
+    const auto shape = make_shape();
+    const auto data  = serialize_view(shape);
+
+    const auto view = SerializedView<Shape>::load(data);
+    EXPECT(view.has_value());
+    EXPECT(view.value().get<0>() == 77);
+    EXPECT(view.value().get<1>() == "shape");
+    EXPECT(view.value().get<2>().size() == 4);
+    EXPECT(view.value().get<2>()[3] == 1LL << 40);
+    EXPECT(view.value().get<3>()[2].get<1>() == -2);
+    EXPECT(view.value().get<4>().get<0>() == 9);
+
+    for (uint64 size = 0; size < data.size(); size++)
+        EXPECT(SerializedView<Shape>::load(data.data(), size).has_error());
+}
@@ -0,0 +1,123 @@
+#include "test.hpp"
+
+#include "multithreading/synchronization.hpp"
+
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+
+using namespace a172;
+
+namespace {
+
+// Written as a whole, so readers must never see halves of two writes
+struct Pair {
+    uint64 value        = 0;
+    uint64 double_value = 0;
+
+    bool is_consistent() const { return double_value == 2 * value; }
+};
+
+const uint64 thread_count = 4;
+const uint64 iterations   = 20000;
+
+template<typename Function>
+void run_threads(const Function& function) {
+    std::thread threads[thread_count];
+    for (uint64 t = 0; t < thread_count; t++)
+        threads[t] = std::thread { [&, t]() { function(t); } };
+    for (auto& thread : threads)
+        thread.join();
+}
+
+} // namespace
+
+TEST(spin_lock_counter) {
+    parallel::SpinLock lock {};
+    uint64             counter = 0;
+    run_threads([&](const uint64) {
+        for (uint64 i = 0; i < iterations; i++) {
+            std::lock_guard<parallel::SpinLock> guard { lock };
+            counter++;
+        }
+    });
+    EXPECT(counter == thread_count * iterations);
+}
+
+TEST(rw_lock_reader_consistency) {
+    parallel::RWLock  lock {};
+    Pair              pair {};
+    std::atomic<bool> consistent { true };
+    run_threads([&](const uint64 t) {
+        for (uint64 i = 0; i < iterations; i++) {
+            if (t == 0) {
+                std::lock_guard<parallel::RWLock> guard { lock };
+                pair.value++;
+                pair.double_value += 2;
+            } else {
+                std::shared_lock<parallel::RWLock> guard { lock };
+                if (!pair.is_consistent()) consistent = false;
+            }
+        }
+    });
+    EXPECT(consistent && pair.value == iterations);
+}
+
+TEST(seq_lock_reader_consistency) {
+    parallel::SeqLock<Pair> lock {};
+    std::atomic<bool>       consistent { true };
+    run_threads([&](const uint64 t) {
+        for (uint64 i = 1; i <= iterations; i++) {
+            if (t == 0) {
+                Pair pair {};
+                pair.value        = i;
+                pair.double_value = 2 * i;
+                lock.store(pair);
+            } else if (!lock.load().is_consistent()) consistent = false;
+        }
+    });
+    EXPECT(consistent && lock.load().value == iterations);
+}
+
+TEST(semaphore_limits_holders) {
+    parallel::Semaphore semaphore { 2 };
+    std::atomic<uint32> holders { 0 };
+    std::atomic<bool>   exceeded { false };
+    run_threads([&](const uint64) {
+        for (uint64 i = 0; i < iterations / 10; i++) {
+            semaphore.acquire();
+            if (++holders > 2) exceeded = true;
+            holders--;
+            semaphore.release();
+        }
+    });
+    EXPECT(!exceeded);
+    EXPECT(semaphore.try_acquire() && semaphore.try_acquire());
+    EXPECT(!semaphore.try_acquire() && !semaphore.try_acquire_for(1));
+}
+
+TEST(latch_and_barrier) {
+    parallel::Latch latch { thread_count };
+    EXPECT(!latch.try_wait());
+    std::atomic<uint64> arrived { 0 };
+    run_threads([&](const uint64) {
+        arrived++;
+        latch.arrive_and_wait();
+        // Nobody passes before all arrived
+        if (arrived != thread_count) arrived = 0;
+    });
+    EXPECT(latch.try_wait() && arrived == thread_count);
+
+    // Each phase completes before any thread starts the next one
+    parallel::Barrier   barrier { (uint32) thread_count };
+    std::atomic<uint64> phase_counts[3] {};
+    std::atomic<bool>   ordered { true };
+    run_threads([&](const uint64) {
+        for (uint64 phase = 0; phase < 3; phase++) {
+            phase_counts[phase]++;
+            barrier.arrive_and_wait();
+            if (phase_counts[phase] != thread_count) ordered = false;
+        }
+    });
+    EXPECT(ordered);
+}
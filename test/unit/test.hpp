@@ -0,0 +1,76 @@
+/**
+ * @file test.hpp
+ * @author Android172 (android172unity@gmail.com)
+ * @brief Minimal unit test registry and assertion macros
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+
+#include "common/types.hpp"
+
+#include <cstdio>
+#include <filesystem>
+
+namespace unit_test {
+
+/// @brief Registered test case. Cases form an intrusive list, since they
+/// register during static initialization, before memory system is ready.
+struct Case {
+    const char* name;
+    void (*run)();
+    Case*       next = nullptr;
+
+    Case(const char* const name, void (*run)()) : name(name), run(run) {
+        auto& list = cases();
+        if (list.last) list.last->next = this;
+        else list.first = this;
+        list.last = this;
+    }
+
+    /// @brief All registered test cases, in registration order
+    struct List {
+        Case* first = nullptr;
+        Case* last  = nullptr;
+    };
+    static List& cases() {
+        static List list {};
+        return list;
+    }
+};
+
+/// @brief Number of failed expectations
+inline a172::uint64& failures() {
+    static a172::uint64 count = 0;
+    return count;
+}
+
+/// @brief Directory for files created by tests. Created on first use.
+inline std::filesystem::path temp_directory() {
+    const auto path =
+        std::filesystem::temp_directory_path() / "a172_core_tests";
+    std::filesystem::create_directories(path);
+    return path;
+}
+
+} // namespace unit_test
+
+/// @brief Define and register a test case
+#define TEST(name)                                                             \
+    static void test_##name();                                                 \
+    static unit_test::Case register_##name { #name, test_##name };             \
+    static void test_##name()
+
+/// @brief Record a failure if @p condition doesn't hold
+#define EXPECT(condition)                                                      \
+    do {                                                                       \
+        if (!(condition)) {                                                    \
+            std::printf(                                                       \
+                "%s:%d: expected %s\n", __FILE__, __LINE__, #condition         \
+            );                                                                 \
+            unit_test::failures()++;                                           \
+        }                                                                      \
+    } while (0)
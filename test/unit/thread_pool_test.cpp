@@ -0,0 +1,25 @@
+#include "test.hpp"
+
+#include "multithreading/thread_pool.hpp"
+
+#include <stdexcept>
+
+using namespace a172;
+
+TEST(thread_pool_run_joined) {
+    parallel::ThreadPool pool { 3 };
+    std::atomic<uint64>  sum { 0 };
+    pool.run_joined(1000, [&](const uint64 index) { sum += index; });
+    EXPECT(sum == 999 * 1000 / 2);
+
+    // Throwing calls don't stop the rest, and first exception reaches caller
+    std::atomic<uint64> calls { 0 };
+    bool                thrown = false;
+    try {
+        pool.run_joined(100, [&](const uint64 index) {
+            calls++;
+            if (index % 10 == 0) throw std::runtime_error("job");
+        });
+    } catch (const std::runtime_error&) { thrown = true; }
+    EXPECT(thrown && calls == 100);
+}